@@ -5,7 +5,7 @@
 #include <vector>
 #include <map>
 #include <chrono>
-#include <deque>
+#include "MetricStore.h"
 
 // Forward declarations
 class CpuMonitor;
@@ -15,16 +15,20 @@ class PerfMonitor;
 class NumaMonitor;
 class ProcessMonitor;
 
+// Sparkline view of one MetricStore series: the store keeps hours of history,
+// the view shows the last max_points seconds
 struct TimeSeriesData {
-    std::deque<double> values;
-    std::deque<std::chrono::steady_clock::time_point> timestamps;
+    SeriesId series;
     size_t max_points;
     double min_value;
     double max_value;
     
-    TimeSeriesData(size_t max_pts = 60) : max_points(max_pts), min_value(0.0), max_value(100.0) {}
+    TimeSeriesData(const std::string& name, size_t max_pts = 60, int precision_bits = MetricStore::kDefaultPrecisionBits)
+        : series(MetricStore::instance().series(name, precision_bits)), max_points(max_pts), min_value(0.0), max_value(100.0) {}
     
     void addPoint(double value);
+    // One value per second over the window, gaps skipped
+    std::vector<double> recent() const;
     void drawSparkline(WINDOW* win, int y, int x, int width, int height);
 };
 
@@ -43,6 +47,7 @@ public:
     void showPerformanceCounters();
     void showProcessDrillDown();
     void showNUMAView();
+    void showSoftirqHeatmap();
     
     // Data integration
     void setMonitors(CpuMonitor* cpu, MemoryMonitor* mem, StorageMonitor* storage,
@@ -61,6 +66,7 @@ private:
     void drawPerformanceCounters();
     void drawProcessDrillDown();
     void drawNUMAView();
+    void drawSoftirqHeatmap();
     void drawFooter();
     
     // Helper functions
@@ -68,6 +74,7 @@ private:
     void drawSparkline(WINDOW* win, int y, int x, int width, const TimeSeriesData& data, const std::string& label);
     void drawTable(WINDOW* win, int y, int x, const std::vector<std::vector<std::string>>& data);
     void drawAlert(WINDOW* win, int y, int x, const std::string& message, int color_pair);
+    void drawHeatCell(WINDOW* win, int y, int x, double value, double max);
     
     // Input handling
     void handleInput();
@@ -99,7 +106,8 @@ private:
         STORAGE_DETAIL,
         PERFORMANCE_COUNTERS,
         PROCESS_DRILLDOWN,
-        NUMA_VIEW
+        NUMA_VIEW,
+        SOFTIRQ_HEATMAP
     } current_view_;
     
     bool running_;
@@ -4,6 +4,12 @@
 #include <fstream>
 #include <map>
 #include <vector>
+#include <chrono>
+#include <cstdint>
+
+#include "InterruptMonitor.h"
+#include "SoftirqMonitor.h"
+#include "FrequencyMonitor.h"
 
 struct CpuTimes {
     unsigned long user;
@@ -30,6 +36,29 @@ struct CpuTimes {
     double guest_nice_percent;
 };
 
+// Per-CPU scheduler counters from /proc/schedstat (version 15+ field layout)
+struct CpuSchedStat {
+    int cpu;
+    uint64_t run_time_ns;          // Time spent running tasks
+    uint64_t wait_time_ns;         // Time tasks spent runnable on this run queue
+    uint64_t timeslices;           // Timeslices run on this CPU
+
+    // Calculated metrics for the last interval
+    double busy_percent;
+    double wait_percent;           // Run-queue wait as % of wall time (can exceed 100)
+    double wait_per_slice_us;      // Average wait before each timeslice
+    uint64_t interval_timeslices;
+};
+
+// /proc/loadavg
+struct LoadAverage {
+    double load1;
+    double load5;
+    double load15;
+    int running;                   // Currently runnable tasks
+    int total;                     // Tasks in the system
+};
+
 class CpuMonitor {
 public:
     CpuMonitor();
@@ -45,19 +74,48 @@ public:
            double getIOWait() const { return current_.iowait_percent; }
            double getHardIRQ() const { return current_.irq_percent; }
            double getSoftIRQ() const { return current_.softirq_percent; }
+           double getSteal() const { return current_.steal_percent; }
+    const std::map<int, double>& getPerCpuUsage() const { return per_cpu_usage_; }   // Busy% keyed by CPU id
+    const std::map<int, CpuTimes>& getPerCpuTimes() const { return per_cpu_times_; } // Raw cpuN ticks, percentages unset
+    static unsigned long totalTicks(const CpuTimes& times);
     void printInterruptStats();
     std::map<std::string, std::vector<unsigned long>> getInterruptCounts() const;
     std::string getInterruptDescription(const std::string& irq_name) const;
+    const InterruptMonitor& getInterruptMonitor() const { return interrupt_monitor_; }
+    void printSoftirqStats();
+    const SoftirqMonitor& getSoftirqMonitor() const { return softirq_monitor_; }
+    void printFrequencyStats();
+    const FrequencyMonitor& getFrequencyMonitor() const { return frequency_monitor_; }
+    void setFrequencyEnabled(bool enabled) { frequency_enabled_ = enabled; }   // Off by default: one sysfs walk per CPU per tick
+    bool isFrequencyEnabled() const { return frequency_enabled_; }
+    
+    // Run-queue pressure
+    void printSchedStats();
+    const std::vector<CpuSchedStat>& getSchedStats() const { return sched_stats_; }
+    const LoadAverage& getLoadAverage() const { return load_average_; }
+    bool hasSchedStat() const { return !sched_stats_.empty(); }
+    double getAvgRunQueueWaitUs() const;   // Weighted by timeslices across CPUs
+    double getMaxRunQueueWaitUs() const;   // Worst CPU
+    bool isRunQueueOverloaded() const;
     
 private:
     bool parseProcStat();
     void calculatePercentages();
-    bool parseProcInterrupts();
-    std::map<std::string, std::vector<unsigned long>> interrupt_counts_;
-    std::map<std::string, std::vector<unsigned long>> previous_interrupt_counts_;
+    bool parseSchedStat();
+    bool parseLoadAvg();
+    InterruptMonitor interrupt_monitor_;
+    SoftirqMonitor softirq_monitor_;
+    FrequencyMonitor frequency_monitor_;
+    bool frequency_enabled_;
     
     std::ifstream proc_stat_file_;
     CpuTimes current_;
     CpuTimes previous_;
     bool first_reading_;
+    std::map<int, CpuTimes> per_cpu_times_;   // Latest cpuN line per CPU
+    std::map<int, double> per_cpu_usage_;
+    
+    std::vector<CpuSchedStat> sched_stats_;
+    LoadAverage load_average_;
+    std::chrono::steady_clock::time_point last_schedstat_;
 };
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <chrono>
+
+// Free-list state of one (node, zone) from /proc/buddyinfo and /proc/pagetypeinfo
+struct ZoneFragmentation {
+    int node;
+    std::string zone;                              // DMA, DMA32, Normal, Movable
+    std::vector<unsigned long> free_blocks;        // Free blocks per order (buddyinfo)
+    unsigned long free_pages;                      // Sum of free_blocks[i] << i
+    std::vector<double> unusable_index;            // Per order: share of free pages too small for that order
+    unsigned long high_order_free_pages;           // Free pages in blocks of kHighOrder and above
+
+    // /proc/pagetypeinfo (root only): free blocks per migrate type and order, pageblock ownership
+    std::map<std::string, std::vector<unsigned long>> migrate_free_blocks;
+    std::map<std::string, unsigned long> pageblocks;
+
+    // Trend of the high-order unusable index over the history window
+    std::deque<std::pair<double, double>> history;   // (seconds since start, unusable index)
+    double trend_per_min;
+    unsigned long high_order_peak;                 // Highest high_order_free_pages in the window
+    std::deque<unsigned long> high_order_window;
+    bool collapsed;
+};
+
+// External fragmentation per node and zone. Reports the unusable free space
+// index (Gorman & Whitcroft): for order j, the fraction of free memory held in
+// blocks smaller than 2^j pages. Free memory can be plentiful while high-order
+// allocations (NIC ring refills, THP, kmalloc of large objects) still fail.
+class FragmentationMonitor {
+public:
+    FragmentationMonitor();
+    ~FragmentationMonitor() = default;
+
+    bool update();
+    void printStats();
+
+    // Getters for integration
+    const std::vector<ZoneFragmentation>& getZones() const { return zones_; }
+    const ZoneFragmentation* findZone(int node, const std::string& zone) const;
+    int getHighOrder() const;
+    int getPageblockOrder() const { return pageblock_order_; }
+    double getWorstUnusableIndex(int order) const;   // Over all zones except DMA
+    bool isHighOrderCollapsed() const;
+
+private:
+    bool readBuddyinfo();
+    void readPagetypeinfo();
+    void calculateIndices();
+    void updateTrends(double seconds);
+
+    ZoneFragmentation& zoneFor(int node, const std::string& zone);
+
+    std::vector<ZoneFragmentation> zones_;
+    int max_order_;                                // Highest order reported by buddyinfo
+    int pageblock_order_;
+    bool pagetypeinfo_readable_;
+    int updates_since_pagetypeinfo_;
+    std::chrono::steady_clock::time_point start_;
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+// One cpuidle state of one CPU (POLL, C1, C1E, C6, ...)
+struct IdleStateResidency {
+    std::string name;
+    unsigned long latency_us;      // Exit latency advertised by the driver
+    uint64_t time_us;              // Cumulative residency
+    uint64_t usage;                // Cumulative entries
+    bool disabled;
+
+    // Calculated metrics for the last interval
+    double residency_percent;      // Share of wall time spent in this state
+    double entry_rate;             // Entries/sec
+};
+
+// Clock, idle and throttle state of one CPU
+struct CoreFrequency {
+    int cpu;
+    std::string governor;          // scaling_governor, empty without cpufreq
+    std::string driver;            // scaling_driver
+    double cur_mhz;                // scaling_cur_freq, or "cpu MHz" from /proc/cpuinfo
+    double min_mhz;                // scaling_min_freq
+    double max_mhz;                // cpuinfo_max_freq (hardware limit)
+    double base_mhz;               // base_frequency or MSR_PLATFORM_INFO ratio, 0 when unknown
+
+    // APERF/MPERF through /dev/cpu/<n>/msr, when readable
+    bool has_msr;
+    uint64_t aperf;
+    uint64_t mperf;
+    double effective_mhz;          // Average clock while not idle over the interval
+
+    std::vector<IdleStateResidency> idle_states;
+    double c0_percent;             // 100 minus the summed idle residency
+
+    // thermal_throttle/ counters (x86)
+    uint64_t core_throttle_count;
+    uint64_t package_throttle_count;
+    uint64_t power_limit_count;
+    uint64_t throttle_events;      // New throttle/power-limit events this interval
+
+    bool is_low_clock;             // Running well below its maximum
+};
+
+// Per-core frequency, C-state residency and throttling from cpufreq, cpuidle,
+// thermal_throttle and (when readable) the APERF/MPERF MSRs.
+class FrequencyMonitor {
+public:
+    FrequencyMonitor();
+    ~FrequencyMonitor();
+
+    bool update();
+    void printStats(int count = 16);
+
+    // Getters for integration
+    const std::vector<CoreFrequency>& getCores() const { return cores_; }
+    double getAverageMhz() const;          // Effective clock when available, else current
+    double getAverageMaxMhz() const;
+    int getLowClockCount() const;
+    uint64_t getThrottleEvents() const;
+    bool hasPowersaveGovernor() const;
+    bool isAvailable() const { return !cores_.empty() && (has_cpufreq_ || has_msr_ || has_cpuinfo_mhz_); }
+
+private:
+    void discoverCores();
+    void readCpufreq(CoreFrequency& core);
+    void readCpuinfoMhz();
+    bool readMsr(CoreFrequency& core, uint64_t& aperf, uint64_t& mperf);
+    void readIdleStates(CoreFrequency& core, double interval_seconds);
+    void readThrottle(CoreFrequency& core);
+
+    std::vector<CoreFrequency> cores_;
+    std::vector<int> msr_fds_;             // Indexed like cores_, -1 when not readable
+    bool has_cpufreq_;
+    bool has_msr_;
+    bool has_cpuinfo_mhz_;
+    uint64_t topology_generation_;         // Online CPU set cores_ was built from
+
+    std::chrono::steady_clock::time_point last_update_;
+    bool first_reading_;
+};
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <chrono>
+#include <cstdint>
+#include <sys/types.h>
+
+#include "PerfRing.h"
+
+class NumaMonitor;
+class PerfMonitor;
+class ProcessMonitor;
+
+// /sys/kernel/mm/transparent_hugepage policy (the bracketed choice of each file)
+struct ThpSettings {
+    std::string enabled;           // always / madvise / never
+    std::string defrag;            // always / defer / defer+madvise / madvise / never
+    std::string shmem_enabled;
+    bool khugepaged_defrag;
+    unsigned long khugepaged_pages_to_scan;
+    unsigned long khugepaged_scan_sleep_ms;
+};
+
+// Huge-page coverage of one process from /proc/<pid>/smaps_rollup
+struct ProcessHugePages {
+    pid_t pid;
+    std::string comm;
+    unsigned long anonymous_kb;
+    unsigned long anon_huge_kb;
+    unsigned long shmem_pmd_kb;
+    unsigned long file_pmd_kb;
+    double coverage_percent;       // AnonHugePages / Anonymous
+};
+
+// THP and compaction efficiency: is THP helping, and what does it cost?
+// Counters come from NumaMonitor's vmstat array, direct-compaction stall time
+// from the compaction:mm_compaction_begin/end tracepoints when tracefs is
+// available, and TLB pressure from PerfMonitor's dTLB counters.
+class HugePageMonitor {
+public:
+    HugePageMonitor();
+    ~HugePageMonitor();
+
+    // numa is required (vmstat source); perf and process are optional
+    void attach(const NumaMonitor* numa, const PerfMonitor* perf, const ProcessMonitor* process, int top_n = 5);
+    bool update();
+    void printStats();
+
+    // Getters for integration
+    const ThpSettings& getSettings() const { return settings_; }
+    double getFaultAllocRate() const { return fault_alloc_rate_; }
+    double getFallbackPercent() const { return fallback_percent_; }
+    double getCompactStallRate() const { return compact_stall_rate_; }
+    double getCompactStallMsPerSec() const { return stall_ms_per_sec_; }   // -1 without tracepoints
+    double getAnonCoveragePercent() const { return anon_coverage_percent_; }
+    unsigned long long getLostEvents() const { return rings_.getLostEvents(); }
+    const std::vector<ProcessHugePages>& getProcessCoverage() const { return processes_; }
+    bool isCompactionCostly() const;
+    bool isFallingBack() const;
+
+private:
+    void readSettings();
+    void readMeminfo();
+    void readProcessCoverage();
+    bool openCompactionTracepoints();
+    void drainCompactionEvents(double interval_seconds);
+    bool isKcompactd(pid_t tid);
+
+    const NumaMonitor* numa_monitor_;
+    const PerfMonitor* perf_monitor_;
+    const ProcessMonitor* process_monitor_;
+    int top_n_;
+
+    ThpSettings settings_;
+    unsigned long anon_kb_;
+    unsigned long anon_huge_kb_;
+    unsigned long shmem_huge_kb_;
+    unsigned long file_huge_kb_;
+    double anon_coverage_percent_;
+
+    // Rates from vmstat (per second)
+    double fault_alloc_rate_;
+    double fault_fallback_rate_;
+    double fallback_percent_;
+    double collapse_alloc_rate_;
+    double collapse_failed_rate_;
+    double compact_stall_rate_;
+    double compact_fail_rate_;
+    double compact_success_rate_;
+
+    // Compaction tracepoints: one ring per CPU, end events redirected into begin's
+    PerfRingSet rings_;
+    uint64_t begin_id_;
+    uint64_t end_id_;
+    uint64_t topology_generation_;     // Online CPU set the rings were opened for
+    std::unordered_map<pid_t, uint64_t> open_compactions_;   // tid -> begin time (ns)
+    std::unordered_map<pid_t, bool> kcompactd_tids_;
+    double stall_ms_per_sec_;          // Direct compaction in allocating tasks
+    double background_ms_per_sec_;     // kcompactd
+
+    std::vector<ProcessHugePages> processes_;
+    std::chrono::steady_clock::time_point last_update_;
+    bool first_reading_;
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <string_view>
+#include <unordered_map>
+#include <map>
+#include <chrono>
+#include <cstdint>
+
+// One row of /proc/interrupts ("24", "LOC", "NMI", ...)
+struct IrqRow {
+    std::string name;
+    std::string description;       // Trailing text: chip, hwirq, action names
+    bool per_cpu;                  // False for single-value rows such as ERR/MIS
+
+    // Calculated metrics for the last interval
+    double rate;                   // Interrupts/sec summed over all CPUs
+    double baseline_rate;          // EWMA of previous intervals
+    int top_cpu;                   // CPU receiving most of this IRQ
+    double top_cpu_share;          // Fraction of rate on top_cpu
+    bool is_storm;
+    bool is_unbalanced;
+
+    // Identity of numbered IRQs, from the row text, /proc/irq/<n> and sysfs
+    int irq;                               // -1 for arch rows such as LOC
+    std::string chip;                      // e.g. "IR-PCI-MSIX-0000:3b:00.0"
+    std::string hwirq;                     // e.g. "524288-edge"
+    std::vector<std::string> actions;      // Handler names, e.g. "nvme0q3"
+    std::string pci_address;
+    std::string device;                    // nvme0, eth0, vda, or the PCI address
+    int queue;                             // Queue index from the action name, -1 if none
+    int device_node;                       // NUMA node of the device, -1 if unknown
+    std::vector<int> affinity;             // smp_affinity_list
+    std::vector<int> effective_affinity;   // effective_affinity_list (falls back to affinity)
+    int effective_node;                    // Node of the effective CPUs, -1 if mixed/unknown
+    bool is_cross_numa;                    // Serviced on a node other than the device's
+};
+
+// IRQ x CPU counters from /proc/interrupts. Counts and rates are stored in
+// single row-major arrays (row * cpu_count + column) and rebuilt only when
+// the set of IRQs or online CPUs changes.
+class InterruptMonitor {
+public:
+    explicit InterruptMonitor(const std::string& path = "/proc/interrupts");
+    ~InterruptMonitor();
+
+    bool update();
+    void printStats(int count = 10);
+    void printIrqAffinity(int count = 15) const;
+
+    // Getters for integration
+    size_t getRowCount() const { return rows_.size(); }
+    size_t getCpuCount() const { return columns_.size(); }
+    const std::vector<IrqRow>& getRows() const { return rows_; }
+    const std::vector<int>& getColumnCpus() const { return columns_; }
+    double getRate(size_t row, size_t column) const { return rates_[row * columns_.size() + column]; }
+    uint64_t getCount(size_t row, size_t column) const { return counts_[row * columns_.size() + column]; }
+    const IrqRow* findRow(const std::string& name) const;
+    double getCpuRate(size_t column) const;
+    double getTotalRate() const { return total_rate_; }
+    int getStormCount() const;
+    int getUnbalancedCount() const;
+    int getCrossNumaCount() const;   // Active IRQs serviced off the device's node
+    std::map<int, double> getCpuRates() const;   // Interrupts/sec keyed by CPU id
+
+private:
+    bool readFile();
+    bool parseHeader(const char*& p, const char* end);
+    bool parseRows(const char* p, const char* end);
+    void rebuildLayout();
+    void calculateRates(double interval_seconds);
+    void resolveIdentities();
+    void refreshAffinity();
+
+    int fd_;
+    std::vector<char> buffer_;
+    size_t length_;
+
+    std::vector<int> columns_;             // CPU id of each count column
+    std::vector<int> pending_columns_;     // Columns of the file just read
+    std::vector<IrqRow> rows_;
+    std::unordered_map<std::string, size_t> row_index_;
+    std::vector<uint64_t> counts_;
+    std::vector<uint64_t> previous_counts_;
+    std::vector<double> rates_;
+
+    // Parse output, pointing into buffer_ until the next read
+    std::vector<std::string_view> scratch_names_;
+    std::vector<std::string_view> scratch_descriptions_;
+    std::vector<char> scratch_per_cpu_;
+    std::vector<uint64_t> scratch_counts_;
+
+    int updates_since_affinity_;
+
+    double total_rate_;
+    std::chrono::steady_clock::time_point last_update_;
+    bool first_reading_;
+};
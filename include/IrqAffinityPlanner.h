@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include "InterruptMonitor.h"
+#include "SoftirqMonitor.h"
+
+struct CpuTimes;
+
+// Planned placement of one queue IRQ
+struct IrqAssignment {
+    int irq;
+    std::string device;
+    std::string action;
+    int queue;
+    int device_node;
+    double rate;                   // Interrupts/sec measured before planning
+    std::vector<int> current;      // smp_affinity_list now
+    std::vector<int> planned;
+    bool changed;
+    bool applied;
+    std::string error;             // Why apply() failed, e.g. kernel-managed IRQ
+};
+
+// Spreads the queue IRQs of multi-queue devices (NVMe, NICs) over CPUs on the
+// device's NUMA node, least-loaded CPUs first, using the measured IRQ x CPU
+// rates, device softirq rates and per-CPU interrupt time.
+class IrqAffinityPlanner {
+public:
+    IrqAffinityPlanner() = default;
+    ~IrqAffinityPlanner() = default;
+
+    bool plan(const InterruptMonitor& interrupts, const SoftirqMonitor& softirqs,
+              const std::map<int, double>& cpu_irq_percent);
+    void printPlan() const;
+    int apply();                   // Writes /proc/irq/<n>/smp_affinity_list; returns IRQs moved
+
+    // hardirq + softirq share of each CPU between two CpuMonitor::getPerCpuTimes() snapshots
+    static std::map<int, double> cpuIrqPercent(const std::map<int, CpuTimes>& before,
+                                               const std::map<int, CpuTimes>& after);
+
+    // Getters for integration
+    const std::vector<IrqAssignment>& getAssignments() const { return assignments_; }
+    int getChangeCount() const;
+
+private:
+    std::vector<IrqAssignment> assignments_;
+};
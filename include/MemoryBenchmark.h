@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstddef>
+
+struct MembenchConfig {
+    size_t latency_mb;             // Pointer-chase buffer, well past the LLC
+    size_t bandwidth_mb;           // Per STREAM array (three arrays)
+    int threads;                   // Bandwidth threads per CPU node, 0 = every CPU of the node
+    int repetitions;               // Best-of for bandwidth kernels
+    bool run_latency;
+    bool run_bandwidth;
+};
+
+// One (CPU node, memory node) pair
+struct MembenchCell {
+    double latency_ns;             // Idle load-to-use latency, -1 if not run
+    double copy_gbs;               // c[i] = a[i]
+    double triad_gbs;              // a[i] = b[i] + s * c[i]
+    bool bound;                    // mbind succeeded; false means the kernel chose placement
+    bool huge_pages;               // Latency buffer was backed by hugetlbfs or THP
+};
+
+// Node-to-node memory latency and bandwidth matrix. Threads are pinned to the
+// CPUs of each node and buffers are bound to each memory node with raw
+// mbind/set_mempolicy syscalls, so no libnuma is needed.
+class MemoryBenchmark {
+public:
+    explicit MemoryBenchmark(const MembenchConfig& config);
+
+    bool run();
+    void printMatrix() const;
+    void printAssessment() const;
+
+    // Getters for integration
+    const std::vector<int>& getCpuNodes() const { return cpu_nodes_; }
+    const std::vector<int>& getMemoryNodes() const { return memory_nodes_; }
+    const MembenchCell* getCell(int cpu_node, int memory_node) const;
+
+private:
+    double measureLatency(int memory_node, MembenchCell& cell);
+    void measureBandwidth(int cpu_node, int memory_node, MembenchCell& cell);
+    void printTable(const std::string& title, double MembenchCell::*field, int precision) const;
+    void printBandwidthAssessment() const;
+
+    static void* allocateOnNode(size_t bytes, int node, bool& bound, bool& huge, size_t& mapped);
+    static bool pinToCpus(const std::vector<int>& cpus);
+
+    MembenchConfig config_;
+    std::vector<int> cpu_nodes_;       // Nodes with online CPUs
+    std::vector<int> memory_nodes_;    // Nodes with memory (has_memory), CPU-less ones included
+    std::map<std::pair<int, int>, MembenchCell> cells_;
+};
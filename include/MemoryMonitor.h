@@ -10,6 +10,8 @@ struct MemoryStats {
     unsigned long buffers;
     unsigned long cached;
     unsigned long swap_cached;
+    unsigned long swap_total;
+    unsigned long swap_free;
     unsigned long active;
     unsigned long inactive;
     unsigned long dirty;
@@ -40,6 +42,10 @@ public:
     double getAvailableMemory() const { return current_.mem_available; }
     double getBufferUsage() const { return current_.buffer_percent; }
     double getCacheUsage() const { return current_.cache_percent; }
+    unsigned long getCachedKb() const { return current_.cached; }
+    unsigned long getSwapUsedKb() const { return current_.swap_total - current_.swap_free; }
+    unsigned long getDirtyKb() const { return current_.dirty; }
+    unsigned long getWritebackKb() const { return current_.writeback; }
     
 private:
     bool parseProcMeminfo();
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <cstdint>
+#include <cstddef>
+
+enum RollupTier {
+    ROLLUP_10S = 0,
+    ROLLUP_1M,
+    ROLLUP_10M,
+    ROLLUP_TIER_COUNT
+};
+
+// Sparse counterpart of QuantileSketch for stored windows: same logarithmic
+// bins (a = 2% relative error), but only the occupied ones, so a quiet window
+// costs a few bytes. Two sketches merge by adding bin counts. Past kMaxBins
+// the lowest bins are folded together, which keeps the upper quantiles exact.
+class WindowSketch {
+public:
+    void add(double value);
+    void merge(const WindowSketch& other);
+    double quantile(double q) const;   // NaN when empty
+    uint64_t count() const { return count_; }
+    size_t bytes() const { return bins_.capacity() * sizeof(Bin); }
+    void shrink() { bins_.shrink_to_fit(); }
+
+private:
+    static const size_t kMaxBins = 128;
+
+    struct Bin {
+        int32_t key;
+        uint32_t count;
+    };
+
+    void insert(int32_t key, uint32_t count);
+    void collapse();
+
+    std::vector<Bin> bins_;        // Sorted by key
+    uint64_t zero_count_ = 0;      // Values too small (or negative) to index
+    uint64_t count_ = 0;
+};
+
+// Aggregates of one window; quantiles are clamped to the exact min/max
+struct RollupWindow {
+    int64_t start_ms;
+    double min;
+    double max;
+    double sum;
+    uint64_t count;
+    WindowSketch sketch;
+
+    double mean() const;
+    double quantile(double q) const;
+    void merge(const RollupWindow& other);
+};
+
+// 10 s, 1 min and 10 min windows of one series, updated as samples arrive.
+// Closed windows are kept as rings: 10 s for an hour, 1 min for six hours and
+// 10 min for a day, so a 24 h chart reads 144 windows instead of raw samples.
+class MetricRollup {
+public:
+    void add(int64_t timestamp_ms, double value);
+
+    // Windows starting in [from_ms, to_ms], oldest first; the last may still be open
+    size_t windows(RollupTier tier, int64_t from_ms, int64_t to_ms, std::vector<RollupWindow>& out) const;
+    // The windows in [from_ms, to_ms] merged into one
+    bool summarize(RollupTier tier, int64_t from_ms, int64_t to_ms, RollupWindow& out) const;
+    size_t bytes() const;
+
+    static int64_t tierWidthMs(RollupTier tier);
+    static size_t tierRetention(RollupTier tier);
+    static const char* tierName(RollupTier tier);
+
+private:
+    std::deque<RollupWindow> tiers_[ROLLUP_TIER_COUNT];
+};
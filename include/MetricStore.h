@@ -0,0 +1,131 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
+#include "MetricRollup.h"
+
+using SeriesId = uint32_t;
+
+struct MetricSample {
+    int64_t timestamp_ms;
+    double value;
+};
+
+// Size and span of one series
+struct SeriesInfo {
+    std::string name;
+    size_t samples;
+    size_t blocks;
+    size_t compressed_bytes;       // Encoded bits plus block headers
+    double bytes_per_sample;
+    int64_t first_ms;
+    int64_t last_ms;
+};
+
+// In-memory time-series store with Gorilla compression (Pelkonen et al.,
+// VLDB 2015): timestamps as delta-of-delta in resolution ticks, values as the
+// XOR against the previous value with leading/trailing-zero windows. Each
+// series is a chain of fixed-size blocks from a shared arena; expired blocks
+// go back to the arena's free list. Block headers carry the time span and
+// min/max, so range queries skip and scale without decoding.
+//
+// Gauges are quantized to a power-of-two step before encoding (1/16 by
+// default) so noisy values keep short XOR windows; pass kLossless to store
+// exact doubles.
+//
+// Every append also feeds the series' 10 s / 1 min / 10 min rollups, which
+// cover a day while raw samples are kept for the retention window.
+class MetricStore {
+public:
+    static const int kLossless = -1;
+    static const int kDefaultPrecisionBits = 4;
+
+    // Shared store for all monitors
+    static MetricStore& instance();
+
+    explicit MetricStore(int64_t resolution_ms = 1000, int64_t retention_ms = 6LL * 3600 * 1000);
+    ~MetricStore();
+
+    // Get or create a series; precision is the number of binary fraction bits kept
+    SeriesId series(const std::string& name, int precision_bits = kDefaultPrecisionBits);
+    bool append(SeriesId id, double value);
+    bool append(SeriesId id, int64_t timestamp_ms, double value);   // false if older than the last sample
+
+    // Decode samples in [from_ms, to_ms]; returns the number appended to out
+    size_t query(SeriesId id, int64_t from_ms, int64_t to_ms, std::vector<MetricSample>& out) const;
+    // Mean per bucket over [from_ms, to_ms], NaN for empty buckets (sparklines)
+    void downsample(SeriesId id, int64_t from_ms, int64_t to_ms, size_t buckets, std::vector<double>& out) const;
+    bool latest(SeriesId id, MetricSample& sample) const;
+    bool range(SeriesId id, int64_t from_ms, int64_t to_ms, double& min, double& max) const;
+    // Pre-aggregated windows (min/max/sum/count and a quantile sketch) of one tier
+    size_t rollups(SeriesId id, RollupTier tier, int64_t from_ms, int64_t to_ms, std::vector<RollupWindow>& out) const;
+    bool summarize(SeriesId id, RollupTier tier, int64_t from_ms, int64_t to_ms, RollupWindow& out) const;
+
+    // Getters for integration
+    std::vector<SeriesInfo> getSeriesInfo() const;
+    size_t getSeriesCount() const;
+    size_t getArenaBytes() const;
+    size_t getRollupBytes() const;
+    int64_t getResolutionMs() const { return resolution_ms_; }
+    static int64_t nowMs();
+
+private:
+    static const size_t kBlockBytes = 1024;
+
+    struct Block {
+        int64_t first_tick;
+        int64_t last_tick;
+        double min;
+        double max;
+        uint32_t count;
+        uint32_t bit_length;
+        Block* next;
+        uint64_t bits[(kBlockBytes - 48) / 8];
+    };
+    static const uint32_t kPayloadBits = sizeof(Block::bits) * 8;
+
+    // Encoder state of the series' open (tail) block
+    struct Series {
+        std::string name;
+        int precision_bits;
+        Block* head;
+        Block* tail;
+        size_t blocks;
+        int64_t previous_tick;
+        int64_t previous_delta;
+        uint64_t previous_bits;
+        int previous_leading;
+        int previous_trailing;     // -1 until a window has been written
+        MetricRollup rollup;
+    };
+
+    class Arena {
+    public:
+        Block* allocate();
+        void release(Block* block);
+        size_t bytes() const { return chunks_.size() * kChunkBlocks * sizeof(Block); }
+
+    private:
+        static const size_t kChunkBlocks = 256;
+        std::vector<std::unique_ptr<Block[]>> chunks_;
+        size_t used_in_chunk_ = kChunkBlocks;
+        Block* free_ = nullptr;
+    };
+
+    void startBlock(Series& series, int64_t tick, uint64_t value_bits, double value);
+    void encode(Series& series, int64_t tick, uint64_t value_bits);
+    void expire(Series& series, int64_t now_tick);
+    template <typename Visitor>
+    void decodeBlock(const Block& block, Visitor&& visit) const;
+
+    int64_t resolution_ms_;
+    int64_t retention_ticks_;
+    std::vector<Series> series_;
+    std::unordered_map<std::string, SeriesId> index_;
+    Arena arena_;
+    mutable std::mutex mutex_;
+};
@@ -4,6 +4,21 @@
 #include <vector>
 #include <map>
 #include <fstream>
+#include <chrono>
+#include <unordered_map>
+#include <sys/types.h>
+
+class ProcessMonitor;
+
+// Cumulative page allocation counters from /sys/devices/system/node/nodeN/numastat
+struct NumaStatCounters {
+    unsigned long long numa_hit;         // Allocated here as intended
+    unsigned long long numa_miss;        // Allocated here although another node was preferred
+    unsigned long long numa_foreign;     // Intended for here but allocated elsewhere
+    unsigned long long interleave_hit;   // Interleave policy allocations that landed here
+    unsigned long long local_node;       // Allocated here for a task running on this node
+    unsigned long long other_node;       // Allocated here for a task running on another node
+};
 
 struct NumaNode {
     int node_id;
@@ -13,6 +28,16 @@ struct NumaNode {
     double usage_percent;
     std::vector<int> cpu_cores;
     bool is_local;
+    
+    // numastat deltas as pages/sec over the last interval
+    NumaStatCounters numastat;
+    double hit_rate;
+    double miss_rate;
+    double foreign_rate;
+    double interleave_rate;
+    double local_rate;
+    double other_rate;
+    double remote_ratio;             // other_node / (local_node + other_node), percent
 };
 
 struct VmstatCounters {
@@ -34,19 +59,41 @@ struct VmstatCounters {
     unsigned long nr_slab_reclaimable; // Reclaimable slab pages
     unsigned long nr_slab_unreclaimable; // Unreclaimable slab pages
     
+    // Automatic NUMA balancing
+    unsigned long numa_pages_migrated;   // Pages moved to the node of the accessing task
+    unsigned long numa_hint_faults;      // NUMA hinting faults taken
+    unsigned long numa_hint_faults_local; // ... of which already on the accessing node
+    
     // Calculated rates
     double page_fault_rate;
     double major_fault_rate;
     double swap_rate;
-    double memory_pressure;
+    double pages_migrated_rate;      // pages/sec
+    double hint_fault_rate;          // faults/sec
+    double hint_local_percent;       // Share of hinting faults that were local
+    double memory_pressure;          // PSI memory "some" stall %, or heuristic score without PSI
+    double memory_stall_full;        // PSI memory "full" stall % (0 without PSI)
+    bool has_psi;
     bool is_swapping;
     bool is_memory_pressured;
 };
 
+// Where one process's pages live (numa_maps) versus where its threads run
+struct ProcessNumaPlacement {
+    pid_t pid;
+    std::string comm;
+    std::map<int, unsigned long> node_kb;      // Resident KB per node
+    std::map<int, int> thread_nodes;           // Thread count per node, from each thread's last CPU
+    unsigned long total_kb;
+    double misplaced_percent;                  // KB on nodes none of its threads run on
+    bool complete;                             // False when the time budget cut the scan short or access was denied
+    bool readable;                             // False when numa_maps was denied (needs ptrace access)
+};
+
 class NumaMonitor {
 public:
     NumaMonitor();
-    ~NumaMonitor() = default;
+    ~NumaMonitor();
     
     bool update();
     void printStats();
@@ -59,17 +106,70 @@ public:
     bool isMemoryPressured() const { return current_vmstat_.is_memory_pressured; }
     bool isSwapping() const { return current_vmstat_.is_swapping; }
     double getMemoryPressure() const { return current_vmstat_.memory_pressure; }
+    const std::map<int, NumaNode>& getNumaNodes() const { return numa_nodes_; }
+    
+    // Every /proc/vmstat counter, in file order; resolve an index once, then read by index
+    size_t getVmstatCounterCount() const { return vmstat_keys_.size(); }
+    const std::vector<std::string>& getVmstatKeys() const { return vmstat_keys_; }
+    int findVmstatCounter(const std::string& key) const;   // -1 if this kernel lacks it
+    unsigned long long getVmstatValue(size_t index) const { return vmstat_values_[index]; }
+    double getVmstatRate(size_t index) const { return vmstat_rates_[index]; }   // Per second
+    unsigned long long getVmstatValue(const std::string& key) const;
+    double getVmstatRate(const std::string& key) const;
+    void printVmstatActivity(int count = 10);
+    double getRemoteAccessRatio() const;   // All nodes, percent of allocations for remote tasks
+    double getPagesMigratedRate() const { return current_vmstat_.pages_migrated_rate; }
+    bool isRemoteAccessHigh() const;
+    void printNumaLocality();
+    
+    // Sample numa_maps for the top_n memory users of process_monitor on every update
+    void attachProcessMonitor(const ProcessMonitor* process_monitor, int top_n = kPlacementTopN);
+    const std::vector<ProcessNumaPlacement>& getProcessPlacement() const { return placements_; }
+    void printProcessPlacement();
+    
+    // Alert thresholds, shared with the TUI
+    static constexpr double kRemoteRatioWarnPercent = 10.0;      // Share of a node's allocations for remote tasks
+    static constexpr double kRemoteRatioCriticalPercent = 30.0;
+    static constexpr double kMisplacedWarnPercent = 25.0;        // Process memory on nodes without its threads
+    static const int kPlacementTopN = 5;
     
 private:
-    bool parseVmstat();
+    bool parseVmstat(double interval_seconds);
+    bool readVmstatFile();
+    bool scanVmstat();
+    void learnVmstatLayout();
     bool discoverNumaTopology();
     bool parseNumaNode(int node_id);
+    bool parseNumaStat(NumaNode& node, double interval_seconds);
+    void calculateBalancingRates(double interval_seconds);
+    void updateProcessPlacement();
+    bool sampleNumaMaps(ProcessNumaPlacement& placement, std::chrono::steady_clock::time_point deadline);
     void calculateMemoryPressure();
     void detectBottlenecks();
     
-    std::ifstream vmstat_file_;
+    // /proc/vmstat as a dense array. Keys are learned from the first read; later
+    // reads only check each line's key length against the learned layout.
+    int vmstat_fd_;
+    std::vector<char> vmstat_buffer_;
+    size_t vmstat_length_;
+    std::vector<std::string> vmstat_keys_;
+    std::unordered_map<std::string, size_t> vmstat_index_;
+    std::vector<unsigned long long> vmstat_values_;
+    std::vector<unsigned long long> vmstat_previous_;
+    std::vector<double> vmstat_rates_;
+    std::vector<int> vmstat_field_slots_;   // VmstatCounters field -> slot, -1 if absent
     std::map<int, NumaNode> numa_nodes_;
     VmstatCounters current_vmstat_;
     VmstatCounters previous_vmstat_;
     bool first_reading_;
+    
+    // PSI memory totals from the previous update
+    unsigned long long psi_some_total_;
+    unsigned long long psi_full_total_;
+    std::chrono::steady_clock::time_point last_update_;
+    std::chrono::steady_clock::time_point last_numastat_;
+    
+    const ProcessMonitor* process_monitor_;
+    int placement_top_n_;
+    std::vector<ProcessNumaPlacement> placements_;
 };
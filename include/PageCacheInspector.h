@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <functional>
+#include <cstdint>
+
+// Page-cache state of one file
+struct FileResidency {
+    std::string path;
+    size_t root;                   // Index of the command-line path it was found under
+    uint64_t size_bytes;
+    uint64_t cached_pages;
+    int64_t dirty_pages;           // -1 when only mincore is available
+    int64_t writeback_pages;       // -1 when only mincore is available
+    int64_t evicted_pages;         // Evicted pages still remembered by shadow entries, -1 when only mincore is available
+    bool error;
+};
+
+// fincore mode: which files sit in page cache. Uses cachestat(2) (Linux 6.5+),
+// which returns resident/dirty/writeback counts for a range in one call, and
+// falls back to mmap + mincore in fixed windows. Neither reads file data, so
+// multi-terabyte datasets cost only metadata and page-table work.
+class PageCacheInspector {
+public:
+    explicit PageCacheInspector(int threads = 0);
+
+    // Walk the paths (files or directories, recursively) and inspect every regular file
+    bool scan(const std::vector<std::string>& paths);
+    void printReport(unsigned long system_cached_kb, int top = 20) const;
+
+    // Getters for integration
+    const std::vector<FileResidency>& getFiles() const { return files_; }
+    uint64_t getCachedBytes() const;
+    uint64_t getTotalBytes() const;
+    bool usedCachestat() const { return cachestat_supported_.load(); }
+
+private:
+    void runWorkers(const std::function<void()>& worker) const;
+    void addFile(const std::string& path, size_t root, uint64_t size);
+    static FileResidency makeResidency(const std::string& path, size_t root, uint64_t size);
+    static void listDirectory(const std::string& directory, size_t root, std::vector<std::string>& subdirectories,
+                              std::vector<FileResidency>& found, size_t& errors);
+    void inspect(FileResidency& file);
+    bool inspectCachestat(int fd, FileResidency& file);
+    bool inspectMincore(int fd, FileResidency& file);
+
+    int threads_;
+    long page_size_;
+    std::vector<std::string> roots_;
+    std::vector<FileResidency> files_;
+    std::atomic<bool> cachestat_supported_;
+    size_t skipped_;               // Unreadable directories and special files
+};
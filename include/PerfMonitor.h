@@ -3,6 +3,8 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <array>
+#include <chrono>
 #include <unistd.h>
 #include <fcntl.h>
 
@@ -13,6 +15,8 @@
 #include <sys/ioctl.h>
 #endif
 
+#include "PmuCatalog.h"
+
 struct PerfCounters {
     // Hardware performance counters
     unsigned long long cpu_cycles;
@@ -32,6 +36,64 @@ struct PerfCounters {
     double page_fault_rate;       // Page faults per second
 };
 
+// Per-level cache/TLB activity from PERF_TYPE_HW_CACHE, deltas over the last interval
+struct CacheLevelCounters {
+    std::string name;              // "L1D", "L1I", "LLC", "dTLB", "iTLB"
+    unsigned long long read_accesses;
+    unsigned long long read_misses;
+    unsigned long long write_accesses;
+    unsigned long long write_misses;
+    double read_miss_rate;         // read_misses / read_accesses (%)
+    double mpki;                   // (read + write misses) per 1000 instructions
+    bool available;                // At least the miss counters could be opened
+};
+
+// Raw read_format fields of one fd; multiplexing is scaled between two of these
+struct PerfRawReading {
+    uint64_t value;
+    uint64_t time_enabled;
+    uint64_t time_running;
+};
+
+// One logical counter opened on one or more CPUs; reads are summed across
+// fds and scaled for multiplexing (time_enabled / time_running)
+struct PerfCounterHandle {
+    std::string name;
+    std::vector<int> fds;
+    double scale;                  // sysfs .scale, e.g. 64B/2^20 for IMC CAS counts
+    std::string unit;              // sysfs .unit, e.g. "MiB"
+    unsigned long long value;
+    unsigned long long previous;
+    double rate;                   // scale * delta / second
+    bool is_memory_bandwidth;
+    std::vector<int> fd_cpus;                    // CPU of each fd, -1 for per-thread fds
+    std::vector<unsigned long long> fd_values;   // Per-fd scaled totals, index-aligned with fds
+    std::vector<unsigned long long> fd_previous;
+    std::vector<PerfRawReading> fd_raw;          // Last raw read of each fd
+};
+
+// Counter group attached to one process: cycles, instructions, LLC misses and
+// branch misses, one group per thread with inherit for threads created later
+struct ProcessPerfCounters {
+    pid_t pid;
+    std::vector<int> leader_fds;   // One group leader per thread
+    std::vector<int> fds;          // Every fd of every group, for closing
+    std::vector<std::array<PerfRawReading, 4>> raw;   // Last read of each group, index-aligned with leader_fds
+    std::array<unsigned long long, 4> totals;         // Sums of per-interval scaled deltas
+    std::array<unsigned long long, 4> previous;
+    
+    // Deltas over the last interval
+    unsigned long long cycles;
+    unsigned long long instructions;
+    unsigned long long llc_misses;
+    unsigned long long branch_misses;
+    double ipc;
+    double llc_mpki;
+    double branch_mpki;
+    bool has_baseline;             // Read at least once since attach
+    bool valid;                    // Deltas above are meaningful
+};
+
 // Linux-specific perf_event constants
 #ifdef __linux__
 // Use the system-provided constants from Linux headers
@@ -40,17 +102,31 @@ struct PerfCounters {
 // macOS/other platforms - define dummy constants
 #define PERF_TYPE_HARDWARE 0
 #define PERF_TYPE_SOFTWARE 1
+#define PERF_TYPE_TRACEPOINT 2
+#define PERF_TYPE_HW_CACHE 3
+#define PERF_TYPE_RAW 4
 #define PERF_COUNT_HW_CPU_CYCLES 0
 #define PERF_COUNT_HW_INSTRUCTIONS 1
 #define PERF_COUNT_HW_CACHE_REFERENCES 2
 #define PERF_COUNT_HW_CACHE_MISSES 3
 #define PERF_COUNT_HW_BRANCH_INSTRUCTIONS 4
 #define PERF_COUNT_HW_BRANCH_MISSES 5
+#define PERF_COUNT_HW_CACHE_L1D 0
+#define PERF_COUNT_HW_CACHE_L1I 1
+#define PERF_COUNT_HW_CACHE_LL 2
+#define PERF_COUNT_HW_CACHE_DTLB 3
+#define PERF_COUNT_HW_CACHE_ITLB 4
+#define PERF_COUNT_HW_CACHE_OP_READ 0
+#define PERF_COUNT_HW_CACHE_OP_WRITE 1
+#define PERF_COUNT_HW_CACHE_RESULT_ACCESS 0
+#define PERF_COUNT_HW_CACHE_RESULT_MISS 1
 #define PERF_COUNT_SW_CONTEXT_SWITCHES 0
 #define PERF_COUNT_SW_PAGE_FAULTS 1
 #define PERF_FORMAT_TOTAL_TIME_ENABLED 1
 #define PERF_FORMAT_TOTAL_TIME_RUNNING 2
+#define PERF_FORMAT_GROUP 8
 #define PERF_EVENT_IOC_ENABLE 0x2400
+#define PERF_IOC_FLAG_GROUP 1
 #define __NR_perf_event_open 298
 #endif
 
@@ -64,24 +140,75 @@ public:
     void printStats();
     void printAdvancedAnalysis();
     
+    // User-defined counters (call before initialize)
+    bool addEvent(const std::string& spec);
+    bool addMemoryBandwidthEvents();
+    void printEventCatalog();
+    
+    // Scope counters to one process and its threads instead of system-wide
+    void setTargetPid(pid_t pid) { target_pid_ = pid; }
+    void printCacheHierarchy();
+    
+    // Per-process counter groups: attach to exactly these PIDs (detaching
+    // any others) and read them; usable without initialize()
+    void updateProcessCounters(const std::vector<pid_t>& pids);
+    bool attachProcess(pid_t pid);
+    void detachProcess(pid_t pid);
+    const std::map<pid_t, ProcessPerfCounters>& getProcessCounters() const { return process_counters_; }
+    
     // Getters for integration
     double getIPC() const { return current_.ipc; }
     double getCacheHitRate() const { return current_.cache_hit_rate; }
     double getBranchMissRate() const { return current_.branch_miss_rate; }
-    bool isCacheThrashing() const { return current_.cache_hit_rate < 80.0; }
+    bool isCacheThrashing() const;
+    bool isTlbBound() const;
+    const std::vector<CacheLevelCounters>& getCacheHierarchy() const { return cache_levels_; }
+    double getMPKI(const std::string& level) const;
     bool isBranchMispredicting() const { return current_.branch_miss_rate > 5.0; }
+    const std::vector<PerfCounterHandle>& getCustomCounters() const { return custom_counters_; }
+    double getMemoryBandwidth() const;
+    // Per-interval deltas keyed by CPU id (system-wide mode only), for topology rollups
+    std::map<int, double> getCpuCycles() const;
+    std::map<int, double> getCpuInstructions() const;
     
 private:
-    bool setupPerfEvent(int& fd, uint64_t type, uint64_t config, int cpu = -1);
+    bool ensureCatalog();
+    void closeCounters();
+    bool setupPerfEvent(int& fd, const PerfEventTarget& target, pid_t pid, int cpu,
+                        bool group_read = false, int group_fd = -1);
+    std::vector<std::pair<pid_t, int>> counterScopes(const PerfEventTarget& target, const std::vector<pid_t>& threads) const;
+    bool openCounter(PerfCounterHandle& handle, const PerfEventDesc& desc);
+    bool openCachePair(PerfCounterHandle& access, PerfCounterHandle& miss,
+                       const PerfEventTarget& access_target, const PerfEventTarget& miss_target);
+    bool readCounter(PerfCounterHandle& handle);
+    bool readCachePair(PerfCounterHandle& access, PerfCounterHandle& miss);
+    static void commitReadings(PerfCounterHandle& handle, std::vector<PerfRawReading>& raw);
+    static std::map<int, double> cpuDeltas(const PerfCounterHandle& handle);
+    static unsigned long long scaledDelta(const PerfRawReading& before, const PerfRawReading& after);
+    bool openProcessGroup(pid_t tid, ProcessPerfCounters& counters);
+    bool readProcessCounters(ProcessPerfCounters& counters);
     void calculateMetrics();
+    void calculateCacheHierarchy();
     void detectBottlenecks();
     
-    // Perf event file descriptors
-    std::vector<int> perf_fds_;
-    std::map<std::string, int> perf_events_;
+    // Built-in counters are index-aligned with the event table in PerfMonitor.cpp
+    std::vector<PerfCounterHandle> builtin_counters_;
+    // Four counters per cache level: read/write x access/miss, each access/miss pair one perf group
+    std::vector<PerfCounterHandle> cache_counters_;
+    std::vector<CacheLevelCounters> cache_levels_;
+    std::vector<PerfCounterHandle> custom_counters_;
+    std::vector<PerfEventDesc> custom_events_;
+    std::map<pid_t, ProcessPerfCounters> process_counters_;
+    PmuCatalog catalog_;
+    bool catalog_ready_;
+    std::vector<int> online_cpus_;
+    uint64_t topology_generation_;         // Online CPU set online_cpus_ was taken from
+    pid_t target_pid_;
     
     PerfCounters current_;
     PerfCounters previous_;
+    std::chrono::steady_clock::time_point last_sample_;
+    double interval_seconds_;
     bool first_reading_;
     bool initialized_;
 };
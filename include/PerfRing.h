@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+// Per-CPU sample rings for a set of tracepoints. On each CPU the first
+// tracepoint owns the mmap'ed ring and the others are redirected into it
+// with PERF_EVENT_IOC_SET_OUTPUT, so one drain sees every event of that CPU.
+// Samples carry PERF_SAMPLE_TID | PERF_SAMPLE_TIME | PERF_SAMPLE_RAW stamped
+// with CLOCK_MONOTONIC; PERF_RECORD_LOST records are counted, not returned.
+class PerfRingSet {
+public:
+    // data_pages must be a power of two; watermark wakes poll() at a quarter full
+    PerfRingSet(size_t data_pages, bool watermark);
+    ~PerfRingSet();
+
+    PerfRingSet(const PerfRingSet&) = delete;
+    PerfRingSet& operator=(const PerfRingSet&) = delete;
+
+    // All or nothing: on failure every fd and mapping is released and errno kept.
+    // Events start disabled; call enable() once the consumer is ready.
+    bool open(const std::vector<int>& cpus, const std::vector<uint64_t>& tracepoint_ids);
+    bool enable();
+    void close();
+
+    // Hands each sample record (header included, contiguous even if it
+    // wrapped around the ring) to on_sample, then releases the space
+    void drain(size_t ring, const std::function<void(const uint8_t*, size_t)>& on_sample);
+    void drainAll(const std::function<void(const uint8_t*, size_t)>& on_sample);
+
+    bool empty() const { return rings_.empty(); }
+    size_t size() const { return rings_.size(); }
+    int fd(size_t ring) const { return rings_[ring].fd; }
+    const std::vector<int>& getCpus() const { return cpus_; }
+    unsigned long long getLostEvents() const { return lost_events_.load(); }
+
+private:
+    struct Ring {
+        int fd;
+        void* base;
+    };
+
+    int openTracepoint(uint64_t id, int cpu);
+
+    size_t page_size_;
+    size_t data_size_;
+    bool watermark_;
+    std::vector<Ring> rings_;
+    std::vector<int> fds_;
+    std::vector<int> cpus_;
+    std::vector<uint8_t> scratch_;
+    std::atomic<unsigned long long> lost_events_;
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+
+// Bit layout of one format term, from
+// /sys/bus/event_source/devices/<pmu>/format/<term> (e.g. "config:0-7,21")
+struct PmuFormatField {
+    int config_word;                          // 0 = config, 1 = config1, 2 = config2
+    std::vector<std::pair<int, int>> ranges;  // Inclusive bit ranges, low bits first
+};
+
+// Named event from /sys/bus/event_source/devices/<pmu>/events/<name>
+struct PmuEventAlias {
+    std::string name;
+    std::string terms;             // e.g. "event=0x04,umask=0x03"
+    double scale;                  // From <name>.scale, 1.0 if absent
+    std::string unit;              // From <name>.unit, empty if absent
+};
+
+enum class PmuKind {
+    Core,
+    Software,
+    Tracepoint,
+    Uncore,
+    Other
+};
+
+struct PmuInfo {
+    std::string name;
+    uint32_t type;                 // perf_event_attr.type
+    PmuKind kind;
+    std::vector<int> cpus;         // From cpumask/cpus; empty means any CPU
+    std::map<std::string, PmuFormatField> format;
+    std::map<std::string, PmuEventAlias> events;
+};
+
+// Field of a tracepoint's raw record, from events/<subsystem>/<event>/format
+struct TracepointField {
+    int offset;
+    int size;
+    bool is_signed;
+};
+
+// One perf_event_open() target for a resolved event. Uncore specs such as
+// "uncore_imc/cas_count_read/" resolve to one target per IMC box.
+struct PerfEventTarget {
+    std::string pmu;
+    uint32_t type;
+    uint64_t config;
+    uint64_t config1;
+    uint64_t config2;
+    std::vector<int> cpus;         // Empty means every online CPU
+};
+
+// A user-visible counter: the sum of all its targets, multiplied by scale
+struct PerfEventDesc {
+    std::string name;
+    double scale;
+    std::string unit;
+    std::vector<PerfEventTarget> targets;
+};
+
+class PmuCatalog {
+public:
+    PmuCatalog();
+    ~PmuCatalog() = default;
+
+    bool discover();
+    void printCatalog() const;
+
+    // Parse "pmu/term=value,.../", "pmu/alias/" or "subsystem:tracepoint"
+    bool parseEventSpec(const std::string& spec, PerfEventDesc& desc, std::string& error) const;
+    bool resolveTracepoint(const std::string& subsystem, const std::string& event, uint64_t& id) const;
+    bool resolveTracepointField(const std::string& subsystem, const std::string& event,
+                                const std::string& field, TracepointField& result) const;
+
+    // Getters for integration
+    const std::map<std::string, PmuInfo>& getPmus() const { return pmus_; }
+    const PmuInfo* findPmu(const std::string& name) const;
+    std::vector<const PmuInfo*> findPmuInstances(const std::string& name) const;
+
+private:
+    bool parsePmu(const std::string& name, const std::string& path);
+    bool parseFormatField(const std::string& text, PmuFormatField& field) const;
+    bool applyTerms(const PmuInfo& pmu, const std::string& terms,
+                    PerfEventTarget& target, std::string& error) const;
+
+    std::map<std::string, PmuInfo> pmus_;
+    std::string tracing_root_;
+};
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <array>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+// Resources exposed under /proc/pressure (irq needs CONFIG_IRQ_TIME_ACCOUNTING)
+enum PressureResource {
+    PSI_CPU = 0,
+    PSI_MEMORY,
+    PSI_IO,
+    PSI_IRQ,
+    PSI_RESOURCE_COUNT
+};
+
+// One "some" or "full" line of a pressure file
+struct PressureLine {
+    double avg10;
+    double avg60;
+    double avg300;
+    unsigned long long total_us;   // Cumulative stall time
+};
+
+struct PressureStats {
+    std::string name;
+    bool available;
+    bool has_full;                 // cpu "full" is only reported by newer kernels
+    PressureLine some;
+    PressureLine full;
+
+    // Calculated metrics (exact, from total_us deltas over the last interval)
+    double some_percent;
+    double full_percent;
+    unsigned long trigger_events;  // Trigger firings during the last interval
+};
+
+// Threshold registered with the kernel: stall_us of stall within window_us
+struct PressureTrigger {
+    PressureResource resource;
+    bool full;
+    unsigned long stall_us;
+    unsigned long window_us;
+};
+
+// Recorded by the trigger thread as soon as the kernel signals the threshold
+struct PressureEvent {
+    std::chrono::system_clock::time_point time;
+    PressureResource resource;
+    bool full;
+    double avg10;                  // avg10 of the triggering line at that moment
+};
+
+class PressureMonitor {
+public:
+    PressureMonitor();
+    ~PressureMonitor();
+
+    // Triggers must be added before initialize(); defaults are used if none
+    void addTrigger(PressureResource resource, bool full, unsigned long stall_us, unsigned long window_us);
+    bool initialize();
+    bool update();
+    void printStats();
+    void printStallEvents(int count = 10);
+
+    // Parse a pressure file; shared with monitors that only need a snapshot
+    static bool readPressureFile(const std::string& path, PressureLine& some, PressureLine& full, bool& has_full);
+    static const char* resourceName(PressureResource resource);
+
+    // Getters for integration
+    const PressureStats& getStats(PressureResource resource) const { return stats_[resource]; }
+    double getSomePercent(PressureResource resource) const { return stats_[resource].some_percent; }
+    double getFullPercent(PressureResource resource) const { return stats_[resource].full_percent; }
+    std::vector<PressureEvent> getRecentEvents() const;
+    bool isStalled(PressureResource resource) const { return stats_[resource].trigger_events > 0; }
+
+private:
+    struct TriggerHandle {
+        int fd;
+        PressureTrigger trigger;
+    };
+
+    bool registerTrigger(const PressureTrigger& trigger);
+    void triggerLoop();
+    void recordEvent(const PressureTrigger& trigger);
+
+    std::array<PressureStats, PSI_RESOURCE_COUNT> stats_;
+    std::vector<PressureTrigger> requested_;
+    std::vector<TriggerHandle> triggers_;
+    int epoll_fd_;
+    int stop_fd_;
+
+    // Filled by the trigger thread
+    mutable std::mutex mutex_;
+    std::deque<PressureEvent> events_;
+    std::array<unsigned long, PSI_RESOURCE_COUNT> pending_events_;
+
+    std::thread trigger_thread_;
+    std::atomic<bool> running_;
+    std::chrono::steady_clock::time_point last_update_;
+    bool first_reading_;
+    bool initialized_;
+};
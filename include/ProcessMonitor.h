@@ -6,6 +6,10 @@
 #include <fstream>
 #include <chrono>
 
+#include "QuantileSketch.h"
+
+class PerfMonitor;
+
 struct ProcessStats {
     pid_t pid;
     std::string comm;              // Command name
@@ -41,6 +45,12 @@ struct ProcessStats {
     double context_switch_rate;
     double page_fault_rate;
     
+    // Hardware counters (only for processes in the top-N attached set)
+    double ipc;
+    double llc_mpki;
+    double branch_mpki;
+    bool has_hw_counters;
+    
     // Status indicators
     bool is_cpu_intensive;
     bool is_memory_intensive;
@@ -49,6 +59,9 @@ struct ProcessStats {
     bool is_page_faulting_heavy;
 };
 
+// CPU% of one process per update interval
+using CpuSketch = QuantileSketch<512, uint32_t>;
+
 class ProcessMonitor {
 public:
     ProcessMonitor();
@@ -60,6 +73,9 @@ public:
     void printTopProcesses(int count = 10);
     void printProcessDetails(pid_t pid);
     
+    // Attach counter groups to the top_n CPU consumers on every update
+    void attachPerfCounters(PerfMonitor* perf_monitor, int top_n = 5);
+    
     // Process discovery
     std::vector<pid_t> discoverProcesses();
     bool isProcessAlive(pid_t pid);
@@ -70,6 +86,7 @@ public:
     std::vector<pid_t> getTopCPUProcesses(int count = 5) const;
     std::vector<pid_t> getTopMemoryProcesses(int count = 5) const;
     std::vector<pid_t> getTopIOProcesses(int count = 5) const;
+    const CpuSketch* getCpuDistribution(pid_t pid) const;   // Since first seen, nullptr if not sampled yet
     
 private:
     bool parseProcessStat(pid_t pid);
@@ -77,10 +94,14 @@ private:
     bool parseProcessIO(pid_t pid);
     void calculateProcessMetrics(pid_t pid);
     void detectProcessBottlenecks(pid_t pid);
+    void updateHardwareCounters();
     
     std::map<pid_t, ProcessStats> process_stats_;
     std::map<pid_t, ProcessStats> previous_stats_;
+    std::map<pid_t, CpuSketch> cpu_distribution_;
     std::vector<pid_t> tracked_processes_;
     bool first_reading_;
+    PerfMonitor* perf_monitor_;
+    int perf_top_n_;
     std::chrono::steady_clock::time_point last_update_;
 };
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <array>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <sys/types.h>
+
+#include "PmuCatalog.h"
+#include "PerfRing.h"
+#include "QuantileSketch.h"
+
+// Log2 latency histogram: bucket i holds [2^i, 2^(i+1)) microseconds
+struct LatencyHistogram {
+    std::array<unsigned long long, 32> buckets;
+    unsigned long long count;
+    unsigned long long total_ns;
+    unsigned long long max_ns;
+
+    LatencyHistogram() : buckets{}, count(0), total_ns(0), max_ns(0) {}
+
+    void add(unsigned long long ns);
+    void merge(const LatencyHistogram& other);
+    double meanUs() const;
+    double percentileUs(double percentile) const;  // Upper bound of the bucket
+};
+
+// Run-queue wait in microseconds: 2% relative error from 0.1 us to ~70 s.
+// Default-constructible so it can live in per-process map entries.
+struct RunQueueSketch : QuantileSketch<512, uint32_t> {
+    RunQueueSketch() : QuantileSketch(0.02, 0.1) {}
+};
+
+// Why a task was off-CPU; RUN_QUEUE is time spent runnable but not running
+enum OffCpuReason {
+    OFFCPU_IO = 0,         // TASK_UNINTERRUPTIBLE (D state)
+    OFFCPU_LOCK,           // Sleeping inside futex()
+    OFFCPU_SLEEP,          // Any other TASK_INTERRUPTIBLE sleep
+    OFFCPU_RUN_QUEUE,      // Woken or preempted, waiting for a CPU
+    OFFCPU_REASON_COUNT
+};
+
+struct ProcessSchedStats {
+    pid_t tgid;
+    std::string comm;
+    RunQueueSketch runq_latency;                                    // Wakeup/preempt -> on CPU
+    std::array<unsigned long long, OFFCPU_REASON_COUNT> offcpu_ns;  // Split by reason
+    unsigned long long switches;
+
+    ProcessSchedStats() : tgid(0), offcpu_ns{}, switches(0) {}
+};
+
+class SchedMonitor {
+public:
+    SchedMonitor();
+    ~SchedMonitor();
+
+    bool initialize();
+    bool update();
+    void printStats();
+    void printLatencyAnalysis(int count = 10);
+
+    // Getters for integration (last completed interval)
+    const std::map<pid_t, ProcessSchedStats>& getProcessStats() const { return process_stats_; }
+    const LatencyHistogram& getSystemLatency() const { return system_latency_; }
+    const RunQueueSketch& getRunQueueDistribution() const { return system_runq_; }
+    double getRunQueueP99Us() const { return system_runq_.p99(); }
+    unsigned long long getLostEvents() const { return rings_.getLostEvents(); }
+
+private:
+    // One decoded tracepoint record
+    struct SchedEvent {
+        uint64_t time;
+        uint16_t type;
+        pid_t tid;             // Current task (prev task for sched_switch)
+        pid_t tgid;
+        pid_t prev_pid;
+        long prev_state;
+        pid_t next_pid;
+        pid_t wakee;
+        char comm[16];
+    };
+
+    // Per-thread state owned by the collector thread
+    struct TaskState {
+        uint64_t off_since;    // Switched out at
+        uint64_t ready_since;  // Became runnable at (0 = not runnable)
+        int reason;            // OffCpuReason for the blocked part
+        bool in_futex;
+    };
+
+    bool resolveLayout();
+    bool openRings();
+    void stopCollector();
+    void collectorLoop();
+    bool decodeSample(const uint8_t* record, size_t size, SchedEvent& event) const;
+    void handleEvent(const SchedEvent& event);
+    ProcessSchedStats& windowStats(pid_t tid);
+    pid_t resolveTgid(pid_t tid);
+
+    PmuCatalog catalog_;
+
+    // Tracepoint ids and raw field offsets (from tracefs format files)
+    uint64_t switch_id_;
+    uint64_t wakeup_id_;
+    uint64_t wakeup_new_id_;
+    uint64_t futex_enter_id_;
+    uint64_t futex_exit_id_;
+    TracepointField prev_pid_field_;
+    TracepointField prev_state_field_;
+    TracepointField prev_comm_field_;
+    TracepointField next_pid_field_;
+    TracepointField wakee_pid_field_;
+
+    PerfRingSet rings_;        // sched_switch owns each CPU's ring
+    int stop_fd_;
+    uint64_t topology_generation_;   // Online CPU set the rings were opened for
+
+    std::unordered_map<pid_t, TaskState> tasks_;
+    std::unordered_map<pid_t, pid_t> tgid_cache_;
+    std::unordered_map<pid_t, std::string> comm_cache_;
+
+    // window_* is filled by the collector, swapped out by update()
+    std::mutex mutex_;
+    std::map<pid_t, ProcessSchedStats> window_;
+    LatencyHistogram window_latency_;
+    RunQueueSketch window_runq_;
+    std::map<pid_t, ProcessSchedStats> process_stats_;
+    LatencyHistogram system_latency_;          // Log2 buckets for the runqlat-style chart
+    RunQueueSketch system_runq_;               // Percentiles
+
+    std::thread collector_;
+    std::atomic<bool> running_;
+    bool initialized_;
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <chrono>
+
+// One kernel slab cache
+struct SlabCache {
+    std::string name;
+    unsigned long active_objs;
+    unsigned long num_objs;
+    unsigned long object_size;
+    unsigned long objs_per_slab;
+    unsigned long pages_per_slab;
+    unsigned long num_slabs;
+    unsigned long long size_bytes;     // num_slabs * pages_per_slab * page size
+
+    // Calculated metrics
+    double growth_bytes_per_sec;       // Over the last interval
+    std::deque<std::pair<double, double>> history;   // (seconds since start, size_bytes), on change only
+    double slope_bytes_per_min;        // Least-squares fit over history
+    double fit_r2;                     // How linear the growth is
+    double last_change;                // Seconds since start
+    bool leak_suspect;
+    bool seen;                         // Present in the latest read
+};
+
+// Slab caches ranked by size and growth, from /proc/slabinfo (root) or
+// /sys/kernel/slab (SLUB, world-readable). Only caches whose object counts
+// changed since the last read are re-parsed and re-fitted, so a steady system
+// costs one read plus a name compare per line.
+class SlabMonitor {
+public:
+    SlabMonitor();
+    ~SlabMonitor();
+
+    bool update();
+    void printStats(int count = 10);
+
+    // Getters for integration
+    const std::vector<SlabCache>& getCaches() const { return caches_; }
+    const SlabCache* findCache(const std::string& name) const;
+    unsigned long long getTotalBytes() const { return total_bytes_; }
+    size_t getChangedCount() const { return changed_count_; }
+    std::vector<const SlabCache*> getLeakSuspects() const;
+    bool isSysfsSource() const { return use_sysfs_; }
+
+private:
+    bool readSlabinfo(double now, double interval_seconds);
+    bool readSysfs(double now, double interval_seconds);
+    void discoverSysfs();
+    void recordChange(SlabCache& cache, unsigned long long previous_bytes, double now, double interval_seconds);
+    void dropUnseen();
+
+    size_t cacheIndex(const std::string& name);
+
+    std::vector<SlabCache> caches_;
+    std::unordered_map<std::string, size_t> index_;
+
+    // /proc/slabinfo, kept open and re-read with pread
+    int slabinfo_fd_;
+    std::vector<char> buffer_;
+    size_t length_;
+
+    // /sys/kernel/slab fallback: total_objects fd per cache (same order as caches_)
+    bool use_sysfs_;
+    std::vector<int> sysfs_fds_;
+    std::vector<unsigned long> sysfs_order_;
+    int updates_since_discovery_;
+
+    long page_size_;
+    unsigned long long total_bytes_;
+    size_t changed_count_;
+    std::chrono::steady_clock::time_point start_;
+    std::chrono::steady_clock::time_point last_update_;
+    bool first_reading_;
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+// Softirq vectors in /proc/softirqs order
+enum SoftirqType {
+    SOFTIRQ_HI,
+    SOFTIRQ_TIMER,
+    SOFTIRQ_NET_TX,
+    SOFTIRQ_NET_RX,
+    SOFTIRQ_BLOCK,
+    SOFTIRQ_IRQ_POLL,
+    SOFTIRQ_TASKLET,
+    SOFTIRQ_SCHED,
+    SOFTIRQ_HRTIMER,
+    SOFTIRQ_RCU,
+    SOFTIRQ_TYPE_COUNT
+};
+
+// One CPU's row of /proc/net/softnet_stat
+struct SoftnetStats {
+    uint64_t processed;            // Packets taken off the backlog
+    uint64_t dropped;              // Backlog (netdev_max_backlog) full
+    uint64_t time_squeeze;         // net_rx_action ran out of budget/time
+    uint64_t received_rps;         // IPIs received to steer packets here
+
+    // Calculated metrics for the last interval (per second)
+    double processed_rate;
+    double dropped_rate;
+    double time_squeeze_rate;
+    double received_rps_rate;
+};
+
+// Per-CPU softirq rates from /proc/softirqs and packet backlog health from
+// /proc/net/softnet_stat. Rates are stored row-major (type * cpu_count + column).
+class SoftirqMonitor {
+public:
+    SoftirqMonitor();
+    ~SoftirqMonitor() = default;
+
+    bool update();
+    void printStats();
+    void printHeatmap() const;
+
+    // Getters for integration
+    size_t getCpuCount() const { return columns_.size(); }
+    const std::vector<int>& getColumnCpus() const { return columns_; }
+    double getRate(SoftirqType type, size_t column) const { return rates_[type * columns_.size() + column]; }
+    double getTypeRate(SoftirqType type) const;
+    std::map<int, double> getCpuRates(SoftirqType type) const;   // Keyed by CPU id
+    double getMaxRate(SoftirqType type) const;
+    const SoftnetStats& getSoftnet(size_t column) const { return softnet_[column]; }
+    double getDropRate() const;
+    double getTimeSqueezeRate() const;
+    int getHotCpu(SoftirqType type, double* share = nullptr) const;   // -1 if idle
+    bool isNetRxConcentrated() const;   // NET_RX piling onto one CPU (no RSS/RPS)
+
+    static const char* typeName(SoftirqType type);
+
+private:
+    bool parseSoftirqs();
+    bool parseSoftnet();
+    void calculateRates(double interval_seconds);
+
+    std::vector<int> columns_;             // CPU id of each column
+    std::vector<uint64_t> counts_;
+    std::vector<uint64_t> previous_counts_;
+    std::vector<double> rates_;
+    std::vector<SoftnetStats> softnet_;    // Indexed like columns_
+    std::vector<SoftnetStats> previous_softnet_;
+
+    std::chrono::steady_clock::time_point last_update_;
+    bool first_reading_;
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <array>
+#include <deque>
+#include <chrono>
+
+class CpuMonitor;
+class PerfMonitor;
+class ProcessMonitor;
+
+// Per-CPU steal and guest time from CpuMonitor's cpuN ticks
+struct CpuSteal {
+    int cpu;
+    unsigned long long steal;
+    unsigned long long guest;
+    unsigned long long total;
+
+    // Calculated metrics for the last interval
+    double steal_percent;
+    double guest_percent;
+    double peak_steal_percent;     // Highest interval seen since start
+};
+
+// A run of consecutive intervals with system steal above the threshold
+struct NoisyNeighborPeriod {
+    std::chrono::system_clock::time_point start;
+    double duration_seconds;
+    double peak_steal_percent;
+    double mean_steal_percent;
+    double ipc_during;             // Mean IPC while stolen, 0 without counters
+    double ipc_baseline;           // Mean IPC of quiet intervals before it
+    bool active;
+};
+
+// Steal-time accounting for virtualized hosts: per-CPU rates, a histogram of
+// interval steal, correlation with IPC, and sustained noisy-neighbor periods.
+class StealMonitor {
+public:
+    StealMonitor();
+    ~StealMonitor() = default;
+
+    bool update();
+    void printStats();
+
+    // Tick source: must be attached, and updated before this monitor each interval
+    void attachCpuMonitor(const CpuMonitor* cpu_monitor);
+
+    // IPC source: top-N process counters when available, else system-wide IPC
+    void attachPerfCounters(const PerfMonitor* perf_monitor, const ProcessMonitor* process_monitor = nullptr);
+
+    // Getters for integration
+    const std::vector<CpuSteal>& getCpus() const { return cpus_; }
+    double getStealPercent() const { return steal_percent_; }
+    double getMaxCpuStealPercent() const;
+    bool isVirtualized() const { return !hypervisor_.empty(); }
+    const std::string& getHypervisor() const { return hypervisor_; }
+    bool isNoisyNeighborActive() const { return !periods_.empty() && periods_.back().active; }
+    const std::vector<NoisyNeighborPeriod>& getPeriods() const { return periods_; }
+    double getStealIpcCorrelation() const;     // Pearson r over the sample window, 0 if unknown
+
+    static const size_t kHistogramBuckets = 7;
+
+private:
+    bool sampleCpuTimes();
+    void detectHypervisor();
+    double sampleIpc() const;
+    void trackPeriods(double ipc, double interval_seconds);
+
+    std::vector<CpuSteal> cpus_;
+    double steal_percent_;
+    std::string hypervisor_;
+
+    // Intervals per steal% bucket: <1, 1-2, 2-5, 5-10, 10-20, 20-50, >=50
+    std::array<unsigned long, kHistogramBuckets> histogram_;
+
+    // Recent (steal%, IPC) pairs for correlation
+    std::deque<std::pair<double, double>> samples_;
+
+    std::vector<NoisyNeighborPeriod> periods_;
+    NoisyNeighborPeriod run_;              // Current run of high-steal intervals
+    int run_intervals_;
+    int run_ipc_count_;
+    double quiet_ipc_;                     // EWMA of IPC in low-steal intervals
+
+    const CpuMonitor* cpu_monitor_;
+    const PerfMonitor* perf_monitor_;
+    const ProcessMonitor* process_monitor_;
+
+    std::chrono::steady_clock::time_point last_update_;
+    bool first_reading_;
+};
@@ -6,6 +6,8 @@
 #include <vector>
 #include <unordered_map>
 
+#include "QuantileSketch.h"
+
 // Disk statistics from /proc/diskstats
 struct DiskStats {
     std::string device_name;        // nvme0n1, nvme1n1, etc.
@@ -33,6 +35,12 @@ struct DiskStats {
     bool is_hot_device;             // High I/O activity detected
 };
 
+// Distribution of per-interval mean await in ms (time per completed I/O),
+// weighted by the I/Os completed in each interval. /proc/diskstats only has
+// sums, so a slow I/O among fast ones is averaged away: p99 here is the p99
+// of interval means, not of individual I/Os, and understates the I/O tail.
+using LatencySketch = QuantileSketch<512>;
+
 // Device queue statistics
 struct QueueStats {
     std::string device_name;
@@ -58,6 +66,8 @@ class StorageMonitor {
         double getTotalThroughput() const;
         int getHotDeviceCount() const;
         int getBottleneckCount() const;
+        const std::map<std::string, DiskStats>& getDiskStats() const { return disk_stats_; }
+        const LatencySketch* getLatencyDistribution(const std::string& device) const;   // Interval mean await since start, nullptr before any I/O
         void printDetailedDeviceStats();
         void printSchedulerInfo();
         
@@ -83,6 +93,7 @@ class StorageMonitor {
         std::ifstream diskstats_file_;
         std::map<std::string, DiskStats> disk_stats_;
         std::map<std::string, DiskStats> previous_stats_;
+        std::map<std::string, LatencySketch> latency_distribution_;
         std::vector<std::string> devices_;
         std::unordered_map<std::string, QueueStats> queue_stats_;
         bool first_reading_;
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+// Single-value reads of sysfs and procfs attributes. Every helper opens the
+// file fresh, so values track hotplug and driver reloads; a missing or
+// unreadable file reads as empty, false or the fallback.
+
+// First line without the newline; empty if the file cannot be read
+std::string readFirstLine(const std::string& path);
+
+// Leading unsigned number; false if unreadable or not a number
+bool readUll(const std::string& path, uint64_t& value);
+uint64_t readUllOr(const std::string& path, uint64_t fallback = 0);
+
+// Leading signed number, e.g. die_id or a cache level
+int readIntOr(const std::string& path, int fallback);
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+
+// Placement of one online CPU
+struct CpuPlacement {
+    int cpu;
+    int core;                      // First CPU of thread_siblings_list (unique per core)
+    int llc;                       // Last-level cache domain id
+    int socket;                    // physical_package_id
+    int die;                       // die_id, 0 when not exposed
+    int node;                      // NUMA node, -1 without NUMA
+    std::vector<int> siblings;     // SMT siblings including this CPU
+};
+
+// One cache shared by a set of CPUs (cache/index*)
+struct CacheDomain {
+    int level;
+    std::string type;              // "Data", "Instruction", "Unified"
+    unsigned long size_kb;
+    std::vector<int> cpus;
+};
+
+struct NodeTopology {
+    int node;
+    std::vector<int> cpus;         // Online CPUs only
+    std::vector<int> distances;    // SLIT row, indexed by node position
+};
+
+enum TopologyLevel {
+    TOPO_CPU,
+    TOPO_CORE,
+    TOPO_LLC,
+    TOPO_SOCKET,
+    TOPO_NODE
+};
+
+// CPU/cache/NUMA layout from /sys/devices/system/{cpu,node}, built once and
+// rebuilt only when the online CPU set changes. Shared by every monitor that
+// reports per-CPU data so they can roll it up by core, LLC, socket and node.
+class Topology {
+public:
+    static Topology& instance();
+
+    // Cheap hotplug check (one small sysfs read); rebuilds and bumps the generation on change
+    bool refreshIfChanged();
+    uint64_t getGeneration() const { return generation_; }
+
+    // Lookups
+    const std::vector<int>& getOnlineCpus() const { return online_cpus_; }
+    const CpuPlacement* getCpu(int cpu) const;
+    int getNodeOfCpu(int cpu) const;
+    int domainOf(int cpu, TopologyLevel level) const;    // -1 if unknown
+    const std::map<int, NodeTopology>& getNodes() const { return nodes_; }
+    std::vector<int> getNodeCpus(int node) const;
+    std::vector<int> getDomainCpus(TopologyLevel level, int domain) const;
+    const std::vector<CacheDomain>& getCaches() const { return caches_; }
+
+    int getSocketCount() const;
+    int getCoreCount() const;
+    int getLlcCount() const;
+    int getThreadsPerCore() const;
+
+    // Roll per-CPU values up to a level: summed (rates) or averaged (percentages)
+    std::map<int, double> aggregate(const std::map<int, double>& per_cpu, TopologyLevel level, bool average) const;
+    static const char* levelName(TopologyLevel level);
+
+    void printTopology() const;
+
+    // Kernel CPU list format, e.g. "0-3,8-11"
+    static std::vector<int> parseCpuList(const std::string& text);
+    static std::string formatCpuList(const std::vector<int>& cpus);
+
+private:
+    Topology();
+    Topology(const Topology&) = delete;
+    Topology& operator=(const Topology&) = delete;
+
+    void build();
+    void readCpu(int cpu);
+    void readNodes();
+
+    std::string online_text_;              // Last /sys/devices/system/cpu/online
+    std::vector<int> online_cpus_;
+    std::vector<CpuPlacement> placements_;
+    std::vector<int> placement_index_;     // Indexed by CPU id, -1 when offline
+    std::vector<CacheDomain> caches_;      // Unique caches across all CPUs
+    std::map<int, NodeTopology> nodes_;
+    uint64_t generation_;
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <cstdint>
+
+class NumaMonitor;
+
+// workingset_* counters of one memory.stat (file pages unless noted)
+struct WorkingsetCounters {
+    uint64_t refault;              // Evicted page faulted back in
+    uint64_t activate;             // ...within the workingset size, so it went straight to active
+    uint64_t restore;              // ...and it was active before eviction
+    uint64_t steal;                // Pages reclaimed (pgsteal, v2 only; file and anon)
+    uint64_t file_bytes;           // Page cache charged to the cgroup
+};
+
+// Refault rates of one memory cgroup
+struct CgroupWorkingset {
+    std::string path;              // Relative to the memory hierarchy root, "/" for the root
+    WorkingsetCounters counters;
+    WorkingsetCounters previous;
+    bool has_previous;
+
+    // Calculated metrics (pages/sec over the last interval)
+    double refault_rate;
+    double activate_rate;
+    double restore_rate;
+    double steal_rate;
+    double refault_percent;        // Refaults per eviction, -1 without pgsteal (v1)
+    double activate_percent;       // Share of refaults that were still hot
+    bool thrashing;
+    bool cycling;                  // Heavy refaults, none hot: reuse set larger than the limit
+};
+
+// Page-cache efficiency from workingset refault detection: how much of the
+// cache is evicted and read straight back. System-wide rates come from
+// NumaMonitor's vmstat capture, per-cgroup rates from memory.stat (cgroup v2,
+// or hierarchical total_* keys on v1).
+class WorkingsetMonitor {
+public:
+    WorkingsetMonitor();
+    ~WorkingsetMonitor() = default;
+
+    void attachNumaMonitor(const NumaMonitor* numa);
+    bool update();
+    void printStats(int count = 8);
+
+    // Getters for integration
+    double getFileRefaultRate() const { return refault_file_rate_; }
+    double getFileActivateRate() const { return activate_file_rate_; }
+    double getRefaultPercent() const { return refault_percent_; }   // Refaults per eviction
+    double getCacheTurnoverPercent() const { return turnover_percent_; }
+    const std::map<std::string, CgroupWorkingset>& getCgroups() const { return cgroups_; }
+    bool isThrashing() const { return thrashing_; }
+    bool isCycling() const { return cycling_; }
+    std::vector<const CgroupWorkingset*> getThrashingCgroups() const;
+
+private:
+    void readMeminfo();
+    void discoverCgroups();
+    void readCgroups(double interval_seconds);
+    bool readMemoryStat(const std::string& path, WorkingsetCounters& counters) const;
+
+    const NumaMonitor* numa_monitor_;
+
+    // System-wide (vmstat), pages/sec
+    double refault_file_rate_;
+    double refault_anon_rate_;
+    double activate_file_rate_;
+    double restore_file_rate_;
+    double steal_file_rate_;
+    double refault_percent_;
+    double activate_percent_;
+    double turnover_percent_;      // Page cache refaulted per minute, % of Active+Inactive(file)
+    unsigned long file_cache_kb_;
+    bool thrashing_;               // Hot pages evicted and re-read
+    bool cycling_;                 // Most evictions re-read, but from beyond the cache's reach
+
+    std::string cgroup_root_;      // Memory hierarchy mount
+    bool cgroup_v2_;
+    std::map<std::string, CgroupWorkingset> cgroups_;
+    int updates_since_discovery_;
+
+    long page_size_;
+    std::chrono::steady_clock::time_point last_update_;
+    bool first_reading_;
+};
@@ -9,19 +9,15 @@
 #include <iomanip>
 #include <sstream>
 #include <algorithm>
+#include <cmath>
 
 AdvancedTUI::AdvancedTUI() : 
+    cpu_usage_history_("cpu.usage"), memory_usage_history_("memory.usage"), storage_iops_history_("storage.iops"),
+    perf_ipc_history_("perf.ipc", 60, 8), perf_cache_hit_history_("perf.cache_hit"),
     cpu_monitor_(nullptr), memory_monitor_(nullptr), storage_monitor_(nullptr),
     perf_monitor_(nullptr), numa_monitor_(nullptr), process_monitor_(nullptr),
     main_window_(nullptr), header_window_(nullptr), content_window_(nullptr), footer_window_(nullptr),
     current_view_(OVERVIEW), running_(false) {
-    
-    // Initialize time series data
-    cpu_usage_history_ = TimeSeriesData(60);
-    memory_usage_history_ = TimeSeriesData(60);
-    storage_iops_history_ = TimeSeriesData(60);
-    perf_ipc_history_ = TimeSeriesData(60);
-    perf_cache_hit_history_ = TimeSeriesData(60);
 }
 
 AdvancedTUI::~AdvancedTUI() {
@@ -164,6 +160,9 @@ void AdvancedTUI::run() {
             case NUMA_VIEW:
                 drawNUMAView();
                 break;
+            case SOFTIRQ_HEATMAP:
+                drawSoftirqHeatmap();
+                break;
         }
         drawFooter();
         
@@ -200,6 +199,7 @@ void AdvancedTUI::drawHeader() {
         case PERFORMANCE_COUNTERS: view_name = "Performance Counters"; break;
         case PROCESS_DRILLDOWN: view_name = "Process Drill-Down"; break;
         case NUMA_VIEW: view_name = "NUMA View"; break;
+        case SOFTIRQ_HEATMAP: view_name = "Softirq Heatmap"; break;
     }
     mvwprintw(header_window_, 0, 50, "View: %s", view_name.c_str());
     
@@ -214,7 +214,7 @@ void AdvancedTUI::drawHeader() {
     }
     
     // Navigation hints
-    mvwprintw(header_window_, 2, 2, "1-5: Switch Views | Q: Quit | R: Refresh");
+    mvwprintw(header_window_, 2, 2, "1-6: Switch Views | Q: Quit | R: Refresh");
     
     wattroff(header_window_, COLOR_PAIR(COLOR_PAIR_HEADER));
 }
@@ -309,6 +309,18 @@ void AdvancedTUI::drawPerformanceCounters() {
         mvwprintw(content_window_, y++, 2, "Cache Hit Rate: %.1f%%", perf_monitor_->getCacheHitRate());
         mvwprintw(content_window_, y++, 2, "Branch Miss Rate: %.1f%%", perf_monitor_->getBranchMissRate());
         
+        // Misses per thousand instructions at each cache/TLB level
+        y++;
+        mvwprintw(content_window_, y++, 2, "%-6s %10s %10s", "Level", "Rd Miss%", "MPKI");
+        for (const auto& level : perf_monitor_->getCacheHierarchy()) {
+            if (!level.available) {
+                mvwprintw(content_window_, y++, 2, "%-6s %10s %10s", level.name.c_str(), "n/a", "n/a");
+                continue;
+            }
+            mvwprintw(content_window_, y++, 2, "%-6s %10.2f %10.2f", level.name.c_str(),
+                      level.read_miss_rate, level.mpki);
+        }
+        
         y += 2;
         
         // Performance analysis
@@ -319,6 +331,10 @@ void AdvancedTUI::drawPerformanceCounters() {
             drawAlert(content_window_, y++, 2, "🔴 CACHE THRASHING DETECTED - Memory bandwidth bottleneck", COLOR_PAIR_CRITICAL);
         }
         
+        if (perf_monitor_->isTlbBound()) {
+            drawAlert(content_window_, y++, 2, "🟡 TLB REACH LIMITED - Consider hugepages", COLOR_PAIR_WARNING);
+        }
+        
         if (perf_monitor_->isBranchMispredicting()) {
             drawAlert(content_window_, y++, 2, "🔴 HIGH BRANCH MISPREDICTION - CPU pipeline stalls", COLOR_PAIR_CRITICAL);
         }
@@ -383,6 +399,116 @@ void AdvancedTUI::drawNUMAView() {
         }
         
         mvwprintw(content_window_, y++, 2, "Memory Pressure: %.1f%%", numa_monitor_->getMemoryPressure());
+        y++;
+        
+        // Node table on the left, per-process placement beside it (below on narrow terminals)
+        int top = y;
+        mvwprintw(content_window_, y++, 2, "%-5s %7s %8s %8s", "NODE", "USED%", "LOCAL/s", "REMOTE%");
+        for (const auto& [node_id, node] : numa_monitor_->getNumaNodes()) {
+            mvwprintw(content_window_, y, 2, "%-5d %6.1f%% %8.0f", node_id, node.usage_percent, node.local_rate);
+            int color = node.remote_ratio > NumaMonitor::kRemoteRatioCriticalPercent ? COLOR_PAIR_CRITICAL :
+                        node.remote_ratio > NumaMonitor::kRemoteRatioWarnPercent ? COLOR_PAIR_WARNING : COLOR_PAIR_SUCCESS;
+            wattron(content_window_, COLOR_PAIR(color));
+            mvwprintw(content_window_, y++, 24, " %7.1f%%", node.remote_ratio);
+            wattroff(content_window_, COLOR_PAIR(color));
+        }
+        
+        const auto& placements = numa_monitor_->getProcessPlacement();
+        if (!placements.empty()) {
+            int x = getmaxx(content_window_) >= 100 ? 40 : 2;
+            y = x == 2 ? y + 1 : top;
+            mvwprintw(content_window_, y++, x, "%-8s %-15s %8s %-18s %9s", "PID", "COMMAND", "MEM(MB)", "BY NODE (MB)", "MISPLACED");
+            for (const auto& placement : placements) {
+                if (!placement.readable) {
+                    mvwprintw(content_window_, y++, x, "%-8d %-15s %8s %-18s %9s", placement.pid,
+                              placement.comm.substr(0, 15).c_str(), "-", "(no access)", "-");
+                    continue;
+                }
+                std::ostringstream nodes;
+                for (const auto& [node, kb] : placement.node_kb) {
+                    nodes << (nodes.tellp() > 0 ? " " : "") << node << ":" << kb / 1024;
+                }
+                mvwprintw(content_window_, y, x, "%-8d %-15s %8lu %-18s", placement.pid,
+                          placement.comm.substr(0, 15).c_str(), placement.total_kb / 1024,
+                          nodes.str().substr(0, 18).c_str());
+                int color = placement.misplaced_percent > NumaMonitor::kMisplacedWarnPercent ? COLOR_PAIR_WARNING : COLOR_PAIR_NORMAL;
+                wattron(content_window_, COLOR_PAIR(color));
+                mvwprintw(content_window_, y++, x + 52, " %7.1f%%%s", placement.misplaced_percent,
+                          placement.complete ? "" : "*");
+                wattroff(content_window_, COLOR_PAIR(color));
+            }
+        }
+    }
+}
+
+void AdvancedTUI::drawSoftirqHeatmap() {
+    int y = 0;
+    
+    mvwprintw(content_window_, y++, 2, "⚡ PER-CPU SOFTIRQ HEATMAP");
+    mvwprintw(content_window_, y++, 2, "─────────────────────────────────────────────────────────────────────");
+    
+    if (!cpu_monitor_) {
+        return;
+    }
+    
+    const SoftirqMonitor& softirqs = cpu_monitor_->getSoftirqMonitor();
+    size_t cpu_count = softirqs.getCpuCount();
+    if (cpu_count == 0) {
+        mvwprintw(content_window_, y++, 2, "/proc/softirqs not available");
+        return;
+    }
+    
+    // One cell per CPU; rows are scaled to their own hottest CPU
+    int max_x = getmaxx(content_window_);
+    const int label_width = 10;
+    size_t visible = std::min(cpu_count, (size_t)std::max(1, max_x - label_width - 14));
+    
+    mvwprintw(content_window_, y, 2, "%-*s", label_width, "CPU");
+    for (size_t c = 0; c < visible; c++) {
+        mvwaddch(content_window_, y, 2 + label_width + c, '0' + softirqs.getColumnCpus()[c] % 10);
+    }
+    mvwprintw(content_window_, y++, 2 + label_width + visible + 1, "%10s", "max/s");
+    
+    for (SoftirqType type : {SOFTIRQ_NET_RX, SOFTIRQ_NET_TX, SOFTIRQ_BLOCK, SOFTIRQ_TIMER, SOFTIRQ_SCHED, SOFTIRQ_RCU}) {
+        double max = softirqs.getMaxRate(type);
+        mvwprintw(content_window_, y, 2, "%-*s", label_width, SoftirqMonitor::typeName(type));
+        for (size_t c = 0; c < visible; c++) {
+            drawHeatCell(content_window_, y, 2 + label_width + c, softirqs.getRate(type, c), max);
+        }
+        mvwprintw(content_window_, y++, 2 + label_width + visible + 1, "%10.0f", max);
+    }
+    
+    // Backlog health from softnet_stat
+    double max_drops = 0.0, max_squeeze = 0.0;
+    for (size_t c = 0; c < cpu_count; c++) {
+        max_drops = std::max(max_drops, softirqs.getSoftnet(c).dropped_rate);
+        max_squeeze = std::max(max_squeeze, softirqs.getSoftnet(c).time_squeeze_rate);
+    }
+    mvwprintw(content_window_, y, 2, "%-*s", label_width, "DROPS");
+    for (size_t c = 0; c < visible; c++) {
+        drawHeatCell(content_window_, y, 2 + label_width + c, softirqs.getSoftnet(c).dropped_rate, max_drops);
+    }
+    mvwprintw(content_window_, y++, 2 + label_width + visible + 1, "%10.0f", max_drops);
+    mvwprintw(content_window_, y, 2, "%-*s", label_width, "SQUEEZE");
+    for (size_t c = 0; c < visible; c++) {
+        drawHeatCell(content_window_, y, 2 + label_width + c, softirqs.getSoftnet(c).time_squeeze_rate, max_squeeze);
+    }
+    mvwprintw(content_window_, y++, 2 + label_width + visible + 1, "%10.0f", max_squeeze);
+    
+    if (visible < cpu_count) {
+        mvwprintw(content_window_, y++, 2, "(%zu of %zu CPUs shown - widen the terminal)", visible, cpu_count);
+    }
+    
+    y++;
+    if (softirqs.getDropRate() > 0.0) {
+        drawAlert(content_window_, y++, 2, "🔴 BACKLOG DROPS - Packets discarded before the stack", COLOR_PAIR_CRITICAL);
+    }
+    if (softirqs.isNetRxConcentrated()) {
+        double share = 0.0;
+        int hot_cpu = softirqs.getHotCpu(SOFTIRQ_NET_RX, &share);
+        std::string message = "🟡 NET_RX " + std::to_string((int)(share * 100.0)) + "% on cpu" +
+                              std::to_string(hot_cpu) + " - Check RSS/RPS";
+        drawAlert(content_window_, y++, 2, message, COLOR_PAIR_WARNING);
     }
 }
 
@@ -445,14 +571,15 @@ void AdvancedTUI::drawProgressBar(WINDOW* win, int y, int x, int width, double v
 void AdvancedTUI::drawSparkline(WINDOW* win, int y, int x, int width, const TimeSeriesData& data, const std::string& label) {
     mvwprintw(win, y, x, "%s: ", label.c_str());
     
-    if (data.values.empty()) {
+    std::vector<double> values = data.recent();
+    if (values.empty()) {
         mvwprintw(win, y, x + label.length() + 2, "No data");
         return;
     }
     
     // Find min/max for scaling
-    double min_val = *std::min_element(data.values.begin(), data.values.end());
-    double max_val = *std::max_element(data.values.begin(), data.values.end());
+    double min_val = *std::min_element(values.begin(), values.end());
+    double max_val = *std::max_element(values.begin(), values.end());
     
     if (max_val == min_val) {
         mvwprintw(win, y, x + label.length() + 2, "Flat line");
@@ -461,8 +588,9 @@ void AdvancedTUI::drawSparkline(WINDOW* win, int y, int x, int width, const Time
     
     // Draw sparkline
     int spark_width = width - (int)label.length() - 15;
-    for (size_t i = 0; i < std::min(data.values.size(), (size_t)spark_width); i++) {
-        double normalized = (data.values[i] - min_val) / (max_val - min_val);
+    size_t first = values.size() > (size_t)spark_width ? values.size() - spark_width : 0;
+    for (size_t i = 0; i + first < values.size(); i++) {
+        double normalized = (values[i + first] - min_val) / (max_val - min_val);
         int height = (int)(normalized * 8);
         
         char ch;
@@ -479,7 +607,7 @@ void AdvancedTUI::drawSparkline(WINDOW* win, int y, int x, int width, const Time
     }
     
     // Show current value
-    mvwprintw(win, y, x + width - 8, " %.1f", data.values.back());
+    mvwprintw(win, y, x + width - 8, " %.1f", values.back());
 }
 
 void AdvancedTUI::drawAlert(WINDOW* win, int y, int x, const std::string& message, int color_pair) {
@@ -488,6 +616,19 @@ void AdvancedTUI::drawAlert(WINDOW* win, int y, int x, const std::string& messag
     wattroff(win, COLOR_PAIR(color_pair));
 }
 
+void AdvancedTUI::drawHeatCell(WINDOW* win, int y, int x, double value, double max) {
+    if (value <= 0.0 || max <= 0.0) {
+        mvwaddch(win, y, x, '.');
+        return;
+    }
+    
+    double level = value / max;
+    int color_pair = level > 0.66 ? COLOR_PAIR_CRITICAL : level > 0.33 ? COLOR_PAIR_WARNING : COLOR_PAIR_SUCCESS;
+    wattron(win, COLOR_PAIR(color_pair));
+    mvwaddch(win, y, x, level > 0.66 ? '#' : level > 0.33 ? '+' : '-');
+    wattroff(win, COLOR_PAIR(color_pair));
+}
+
 void AdvancedTUI::handleInput() {
     int ch = getch();
     
@@ -507,6 +648,9 @@ void AdvancedTUI::handleInput() {
         case '5':
             current_view_ = NUMA_VIEW;
             break;
+        case '6':
+            current_view_ = SOFTIRQ_HEATMAP;
+            break;
         case 'q':
         case 'Q':
             running_ = false;
@@ -526,19 +670,27 @@ void AdvancedTUI::setMonitors(CpuMonitor* cpu, MemoryMonitor* mem, StorageMonito
     perf_monitor_ = perf;
     numa_monitor_ = numa;
     process_monitor_ = process;
+    if (numa_monitor_ && process_monitor_) {
+        numa_monitor_->attachProcessMonitor(process_monitor_);
+    }
 }
 
 // TimeSeriesData implementation
 void TimeSeriesData::addPoint(double value) {
-    values.push_back(value);
-    timestamps.push_back(std::chrono::steady_clock::now());
-    
-    if (values.size() > max_points) {
-        values.pop_front();
-        timestamps.pop_front();
-    }
+    MetricStore::instance().append(series, value);
     
     // Update min/max
     if (value < min_value) min_value = value;
     if (value > max_value) max_value = value;
 }
+
+std::vector<double> TimeSeriesData::recent() const {
+    const MetricStore& store = MetricStore::instance();
+    int64_t now = MetricStore::nowMs();
+    std::vector<double> buckets, values;
+    store.downsample(series, now - static_cast<int64_t>(max_points) * store.getResolutionMs(), now, max_points, buckets);
+    for (double value : buckets) {
+        if (!std::isnan(value)) values.push_back(value);
+    }
+    return values;
+}
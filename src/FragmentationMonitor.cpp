@@ -0,0 +1,317 @@
+#include "FragmentationMonitor.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <unistd.h>
+
+namespace {
+
+// Order 4 (64 KB) is where NIC page-pool refills and many driver buffers live
+const int kHighOrder = 4;
+
+// pagetypeinfo takes each zone lock while walking the free lists; read it less often
+const int kPagetypeinfoEvery = 5;
+
+const size_t kHistorySamples = 60;
+const double kUnusableWarn = 0.75;
+const double kUnusableCritical = 0.90;
+const double kCollapseFraction = 0.25;     // High-order free fell below 25% of its window peak
+const double kTrendWarnPerMin = 0.05;
+
+double pagesToMb(unsigned long pages) {
+    static const long page_kb = sysconf(_SC_PAGESIZE) / 1024;
+    return pages * page_kb / 1024.0;
+}
+
+} // namespace
+
+FragmentationMonitor::FragmentationMonitor()
+    : max_order_(0), pageblock_order_(9), pagetypeinfo_readable_(true),
+      updates_since_pagetypeinfo_(kPagetypeinfoEvery) {
+    start_ = std::chrono::steady_clock::now();
+}
+
+int FragmentationMonitor::getHighOrder() const {
+    return kHighOrder;
+}
+
+ZoneFragmentation& FragmentationMonitor::zoneFor(int node, const std::string& zone) {
+    for (auto& entry : zones_) {
+        if (entry.node == node && entry.zone == zone) {
+            return entry;
+        }
+    }
+    ZoneFragmentation entry{};
+    entry.node = node;
+    entry.zone = zone;
+    zones_.push_back(entry);
+    return zones_.back();
+}
+
+const ZoneFragmentation* FragmentationMonitor::findZone(int node, const std::string& zone) const {
+    for (const auto& entry : zones_) {
+        if (entry.node == node && entry.zone == zone) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+bool FragmentationMonitor::update() {
+    if (!readBuddyinfo()) {
+        return false;
+    }
+    if (pagetypeinfo_readable_ && ++updates_since_pagetypeinfo_ >= kPagetypeinfoEvery) {
+        readPagetypeinfo();
+        updates_since_pagetypeinfo_ = 0;
+    }
+    calculateIndices();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    updateTrends(seconds);
+    return true;
+}
+
+bool FragmentationMonitor::readBuddyinfo() {
+    // Node 0, zone   Normal   1379    434    118     61 ...
+    std::ifstream file("/proc/buddyinfo");
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream iss(line);
+        std::string node_word, node_id, zone_word, zone;
+        if (!(iss >> node_word >> node_id >> zone_word >> zone) || node_word != "Node") {
+            continue;
+        }
+        ZoneFragmentation& entry = zoneFor(std::atoi(node_id.c_str()), zone);
+        entry.free_blocks.clear();
+        unsigned long count;
+        while (iss >> count) {
+            entry.free_blocks.push_back(count);
+        }
+        max_order_ = std::max(max_order_, static_cast<int>(entry.free_blocks.size()) - 1);
+    }
+    return !zones_.empty();
+}
+
+void FragmentationMonitor::readPagetypeinfo() {
+    std::ifstream file("/proc/pagetypeinfo");
+    if (!file.is_open()) {
+        pagetypeinfo_readable_ = false;   // 0400 root; buddyinfo alone still gives the index
+        return;
+    }
+
+    std::vector<std::string> block_types;
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream iss(line);
+        std::string first;
+        iss >> first;
+
+        if (first == "Page") {
+            // Page block order: 9
+            size_t colon = line.find(':');
+            if (colon != std::string::npos) {
+                pageblock_order_ = std::atoi(line.c_str() + colon + 1);
+            }
+        } else if (first == "Number") {
+            // Number of blocks type     Unmovable      Movable  Reclaimable ...
+            std::string word;
+            iss >> word >> word >> word;
+            block_types.clear();
+            while (iss >> word) {
+                block_types.push_back(word);
+            }
+        } else if (first == "Node") {
+            std::string node_id, zone_word, zone;
+            iss >> node_id >> zone_word >> zone;
+            if (!zone.empty() && zone.back() == ',') {
+                zone.pop_back();
+            }
+            ZoneFragmentation& entry = zoneFor(std::atoi(node_id.c_str()), zone);
+
+            std::string type_word;
+            std::streampos position = iss.tellg();
+            if (iss >> type_word && type_word == "type") {
+                // Node    0, zone   Normal, type      Movable   1378    365 ...
+                std::string type;
+                iss >> type;
+                auto& counts = entry.migrate_free_blocks[type];
+                counts.clear();
+                unsigned long count;
+                while (iss >> count) {
+                    counts.push_back(count);
+                }
+            } else {
+                // Node 0, zone   Normal           41         1484           11 ...
+                iss.clear();
+                iss.seekg(position);
+                unsigned long count;
+                for (size_t i = 0; i < block_types.size() && iss >> count; i++) {
+                    entry.pageblocks[block_types[i]] = count;
+                }
+            }
+        }
+    }
+}
+
+void FragmentationMonitor::calculateIndices() {
+    for (auto& zone : zones_) {
+        const auto& blocks = zone.free_blocks;
+        zone.free_pages = 0;
+        for (size_t order = 0; order < blocks.size(); order++) {
+            zone.free_pages += blocks[order] << order;
+        }
+
+        // Unusable index for order j = (free - pages in blocks of order >= j) / free
+        zone.unusable_index.assign(blocks.size(), 0.0);
+        unsigned long suitable = 0;
+        for (int order = static_cast<int>(blocks.size()) - 1; order >= 0; order--) {
+            suitable += blocks[order] << order;
+            zone.unusable_index[order] = zone.free_pages > 0
+                ? static_cast<double>(zone.free_pages - suitable) / zone.free_pages
+                : 1.0;
+            if (order == kHighOrder) {
+                zone.high_order_free_pages = suitable;
+            }
+        }
+    }
+}
+
+void FragmentationMonitor::updateTrends(double seconds) {
+    for (auto& zone : zones_) {
+        if (static_cast<int>(zone.unusable_index.size()) <= kHighOrder) {
+            continue;
+        }
+        zone.history.emplace_back(seconds, zone.unusable_index[kHighOrder]);
+        zone.high_order_window.push_back(zone.high_order_free_pages);
+        if (zone.history.size() > kHistorySamples) {
+            zone.history.pop_front();
+            zone.high_order_window.pop_front();
+        }
+        zone.high_order_peak = *std::max_element(zone.high_order_window.begin(), zone.high_order_window.end());
+
+        // Least-squares slope of the unusable index, per minute
+        zone.trend_per_min = 0.0;
+        if (zone.history.size() >= 3) {
+            double n = zone.history.size();
+            double sum_t = 0.0, sum_v = 0.0, sum_tt = 0.0, sum_tv = 0.0;
+            for (const auto& [t, v] : zone.history) {
+                sum_t += t;
+                sum_v += v;
+                sum_tt += t * t;
+                sum_tv += t * v;
+            }
+            double denominator = n * sum_tt - sum_t * sum_t;
+            if (denominator > 0.0) {
+                zone.trend_per_min = 60.0 * (n * sum_tv - sum_t * sum_v) / denominator;
+            }
+        }
+
+        // The legacy 16 MB DMA zone is always fragmented and never serves these allocations
+        double index = zone.unusable_index[kHighOrder];
+        bool dropped = zone.high_order_peak > 0 &&
+                       zone.high_order_free_pages < zone.high_order_peak * kCollapseFraction;
+        zone.collapsed = zone.zone != "DMA" &&
+                         (index >= kUnusableCritical || (dropped && index >= kUnusableWarn));
+    }
+}
+
+double FragmentationMonitor::getWorstUnusableIndex(int order) const {
+    double worst = 0.0;
+    for (const auto& zone : zones_) {
+        if (zone.zone == "DMA" || order >= static_cast<int>(zone.unusable_index.size())) continue;
+        worst = std::max(worst, zone.unusable_index[order]);
+    }
+    return worst;
+}
+
+bool FragmentationMonitor::isHighOrderCollapsed() const {
+    for (const auto& zone : zones_) {
+        if (zone.collapsed) return true;
+    }
+    return false;
+}
+
+void FragmentationMonitor::printStats() {
+    std::cout << "\n🧩 MEMORY FRAGMENTATION (unusable free space index per order)" << std::endl;
+    std::cout << "─────────────────────────────────────────────────────────────────────" << std::endl;
+
+    if (zones_.empty()) {
+        std::cout << "/proc/buddyinfo not available" << std::endl;
+        return;
+    }
+
+    std::cout << std::left << std::setw(6) << "NODE" << std::setw(8) << "ZONE"
+              << std::right << std::setw(10) << "FREE(MB)";
+    for (int order = 0; order <= max_order_; order++) {
+        std::cout << std::setw(6) << ("o" + std::to_string(order));
+    }
+    std::cout << std::endl;
+
+    std::cout << std::fixed;
+    for (const auto& zone : zones_) {
+        std::cout << std::left << std::setw(6) << zone.node << std::setw(8) << zone.zone
+                  << std::right << std::setw(10) << std::setprecision(1) << pagesToMb(zone.free_pages)
+                  << std::setprecision(2);
+        for (double index : zone.unusable_index) {
+            std::cout << std::setw(6) << index;
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << "\nOrder-" << kHighOrder << "+ availability (pageblock order " << pageblock_order_ << "):" << std::endl;
+    for (const auto& zone : zones_) {
+        if (zone.zone == "DMA" || zone.history.empty()) continue;
+        std::cout << "  Node " << zone.node << " " << std::left << std::setw(7) << zone.zone << std::right
+                  << std::setprecision(1) << std::setw(9) << pagesToMb(zone.high_order_free_pages) << " MB"
+                  << " (window peak " << pagesToMb(zone.high_order_peak) << " MB)"
+                  << " | unusable " << std::setprecision(2) << zone.unusable_index[kHighOrder]
+                  << " | trend " << std::showpos << zone.trend_per_min << std::noshowpos << "/min";
+        if (zone.collapsed) {
+            std::cout << "  🔴 COLLAPSED";
+        } else if (zone.trend_per_min > kTrendWarnPerMin) {
+            std::cout << "  🟡 FRAGMENTING";
+        }
+        std::cout << std::endl;
+
+        if (!zone.migrate_free_blocks.empty()) {
+            // Which migrate types hold the high-order blocks, and who owns the pageblocks
+            std::cout << "    Order-" << kHighOrder << "+ free by type:";
+            for (const auto& [type, counts] : zone.migrate_free_blocks) {
+                unsigned long pages = 0;
+                for (size_t order = kHighOrder; order < counts.size(); order++) {
+                    pages += counts[order] << order;
+                }
+                if (pages > 0) {
+                    std::cout << " " << type << " " << std::setprecision(1) << pagesToMb(pages) << " MB";
+                }
+            }
+            std::cout << " | pageblocks:";
+            for (const auto& [type, count] : zone.pageblocks) {
+                if (count > 0) {
+                    std::cout << " " << type << " " << count;
+                }
+            }
+            std::cout << std::endl;
+        }
+    }
+    if (!pagetypeinfo_readable_) {
+        std::cout << "  (run as root for per-migrate-type detail from /proc/pagetypeinfo)" << std::endl;
+    }
+
+    if (isHighOrderCollapsed()) {
+        std::cout << "🔴 HIGH-ORDER FREE MEMORY COLLAPSED: order-" << kHighOrder
+                  << "+ allocations (NIC ring refills, THP) are about to fail" << std::endl;
+        std::cout << "   → Solution: echo 1 > /proc/sys/vm/compact_memory now; raise vm.min_free_kbytes"
+                  << " or vm.watermark_scale_factor, and set vm.compaction_proactiveness" << std::endl;
+    } else if (getWorstUnusableIndex(kHighOrder) > kUnusableWarn) {
+        std::cout << "🟡 Most free memory is in blocks below order " << kHighOrder
+                  << " - high-order allocations rely on compaction" << std::endl;
+    }
+}
@@ -0,0 +1,388 @@
+#include "FrequencyMonitor.h"
+#include "SysfsUtil.h"
+#include "Topology.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <map>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+const std::string kCpuRoot = "/sys/devices/system/cpu/";
+
+// Architectural MSRs counting at the actual and the TSC-relative clock in C0
+const off_t kMsrMperf = 0xE7;
+const off_t kMsrAperf = 0xE8;
+// Intel: bits 15:8 hold the maximum non-turbo ratio, in units of the 100 MHz bus clock
+const off_t kMsrPlatformInfo = 0xCE;
+const double kBusClockMhz = 100.0;
+
+// Low clock: a busy core running below this fraction of its maximum
+const double kLowClockRatio = 0.6;
+const double kBusyC0Percent = 50.0;
+
+} // namespace
+
+FrequencyMonitor::FrequencyMonitor()
+    : has_cpufreq_(false), has_msr_(false), has_cpuinfo_mhz_(false), topology_generation_(0), first_reading_(true) {
+    // Cores (and their MSR fds) are discovered by the first update()
+}
+
+FrequencyMonitor::~FrequencyMonitor() {
+    for (int fd : msr_fds_) {
+        if (fd >= 0) close(fd);
+    }
+}
+
+void FrequencyMonitor::discoverCores() {
+    // Rebuilt on CPU hotplug; CPUs that stay online keep their counters and MSR fd
+    std::vector<CoreFrequency> old_cores;
+    std::vector<int> old_fds;
+    old_cores.swap(cores_);
+    old_fds.swap(msr_fds_);
+    has_msr_ = false;
+
+    for (int cpu : Topology::instance().getOnlineCpus()) {
+        auto it = std::find_if(old_cores.begin(), old_cores.end(), [cpu](const CoreFrequency& c) { return c.cpu == cpu; });
+        if (it != old_cores.end()) {
+            size_t index = it - old_cores.begin();
+            cores_.push_back(*it);
+            msr_fds_.push_back(old_fds[index]);
+            old_fds[index] = -1;
+            if (msr_fds_.back() >= 0) has_msr_ = true;
+            continue;
+        }
+
+        CoreFrequency core{};
+        core.cpu = cpu;
+        core.c0_percent = -1.0;
+        cores_.push_back(core);
+
+        // Needs root (CAP_SYS_RAWIO) and the msr module; silently unavailable otherwise
+        int fd = open(("/dev/cpu/" + std::to_string(cpu) + "/msr").c_str(), O_RDONLY);
+        msr_fds_.push_back(fd);
+        if (fd >= 0) has_msr_ = true;
+    }
+
+    for (int fd : old_fds) {
+        if (fd >= 0) close(fd);
+    }
+    // Newly onlined CPUs have no baseline yet; take the next reading as one
+    first_reading_ = true;
+    topology_generation_ = Topology::instance().getGeneration();
+}
+
+bool FrequencyMonitor::update() {
+    if (Topology::instance().getGeneration() != topology_generation_) {
+        discoverCores();
+    }
+    if (cores_.empty()) {
+        return false;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    double interval = std::chrono::duration<double>(now - last_update_).count();
+    last_update_ = now;
+    bool have_interval = !first_reading_ && interval > 0.0;
+
+    has_cpufreq_ = false;
+    for (size_t i = 0; i < cores_.size(); i++) {
+        CoreFrequency& core = cores_[i];
+        readCpufreq(core);
+
+        // MPERF ticks at the base clock; without base_frequency take the
+        // non-turbo ratio from MSR_PLATFORM_INFO, else leave it unknown (0)
+        if (core.base_mhz <= 0.0 && msr_fds_[i] >= 0) {
+            uint64_t platform_info = 0;
+            if (pread(msr_fds_[i], &platform_info, sizeof(platform_info), kMsrPlatformInfo) == sizeof(platform_info)) {
+                core.base_mhz = ((platform_info >> 8) & 0xff) * kBusClockMhz;
+            }
+        }
+
+        uint64_t aperf = 0, mperf = 0;
+        core.has_msr = msr_fds_[i] >= 0 && readMsr(core, aperf, mperf);
+        if (core.has_msr) {
+            uint64_t delta_aperf = aperf - core.aperf;
+            uint64_t delta_mperf = mperf - core.mperf;
+            if (have_interval && delta_mperf > 0 && core.base_mhz > 0.0) {
+                core.effective_mhz = core.base_mhz * (double)delta_aperf / (double)delta_mperf;
+            }
+            core.aperf = aperf;
+            core.mperf = mperf;
+        }
+
+        readIdleStates(core, have_interval ? interval : 0.0);
+
+        uint64_t throttle_total = core.core_throttle_count + core.package_throttle_count + core.power_limit_count;
+        readThrottle(core);
+        uint64_t new_total = core.core_throttle_count + core.package_throttle_count + core.power_limit_count;
+        core.throttle_events = have_interval && new_total > throttle_total ? new_total - throttle_total : 0;
+    }
+
+    if (!has_cpufreq_) {
+        readCpuinfoMhz();
+    }
+
+    for (auto& core : cores_) {
+        double clock = core.effective_mhz > 0.0 ? core.effective_mhz : core.cur_mhz;
+        bool busy = core.c0_percent < 0.0 || core.c0_percent >= kBusyC0Percent;
+        core.is_low_clock = core.max_mhz > 0.0 && clock > 0.0 && busy && clock < kLowClockRatio * core.max_mhz;
+    }
+
+    first_reading_ = false;
+    return true;
+}
+
+void FrequencyMonitor::readCpufreq(CoreFrequency& core) {
+    std::string dir = kCpuRoot + "cpu" + std::to_string(core.cpu) + "/cpufreq/";
+    uint64_t khz = 0;
+    if (!readUll(dir + "scaling_cur_freq", khz)) {
+        return;
+    }
+    has_cpufreq_ = true;
+    core.cur_mhz = khz / 1000.0;
+
+    // Limits only change on policy writes, but re-reading is cheap next to the rest
+    core.min_mhz = readUllOr(dir + "scaling_min_freq") / 1000.0;
+    core.max_mhz = readUllOr(dir + "cpuinfo_max_freq") / 1000.0;
+    // intel_pstate only; cpuinfo_max_freq includes turbo and is no stand-in
+    uint64_t base_khz = readUllOr(dir + "base_frequency");
+    if (base_khz > 0) {
+        core.base_mhz = base_khz / 1000.0;
+    }
+    core.governor = readFirstLine(dir + "scaling_governor");
+    core.driver = readFirstLine(dir + "scaling_driver");
+}
+
+void FrequencyMonitor::readCpuinfoMhz() {
+    // VMs and cpufreq-less kernels still report a (often nominal) clock here
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    int processor = -1;
+    std::map<int, double> mhz;
+
+    while (std::getline(cpuinfo, line)) {
+        if (line.compare(0, 9, "processor") == 0) {
+            processor = std::atoi(line.c_str() + line.find(':') + 1);
+        } else if (line.compare(0, 7, "cpu MHz") == 0 && processor >= 0) {
+            mhz[processor] = std::atof(line.c_str() + line.find(':') + 1);
+        }
+    }
+
+    has_cpuinfo_mhz_ = !mhz.empty();
+    for (auto& core : cores_) {
+        auto it = mhz.find(core.cpu);
+        if (it != mhz.end()) {
+            core.cur_mhz = it->second;
+        }
+    }
+}
+
+bool FrequencyMonitor::readMsr(CoreFrequency& core, uint64_t& aperf, uint64_t& mperf) {
+    int fd = msr_fds_[&core - cores_.data()];
+    return pread(fd, &mperf, sizeof(mperf), kMsrMperf) == sizeof(mperf) &&
+           pread(fd, &aperf, sizeof(aperf), kMsrAperf) == sizeof(aperf);
+}
+
+void FrequencyMonitor::readIdleStates(CoreFrequency& core, double interval_seconds) {
+    std::string dir = kCpuRoot + "cpu" + std::to_string(core.cpu) + "/cpuidle/state";
+    std::vector<IdleStateResidency> states;
+
+    for (int index = 0;; index++) {
+        std::string state_dir = dir + std::to_string(index) + "/";
+        IdleStateResidency state{};
+        if (!readUll(state_dir + "time", state.time_us)) {
+            break;
+        }
+        state.name = readFirstLine(state_dir + "name");
+        state.usage = readUllOr(state_dir + "usage");
+        state.latency_us = readUllOr(state_dir + "latency");
+        state.disabled = readUllOr(state_dir + "disable") != 0;
+
+        if (interval_seconds > 0.0 && (size_t)index < core.idle_states.size()) {
+            const IdleStateResidency& before = core.idle_states[index];
+            if (state.time_us >= before.time_us) {
+                state.residency_percent = 100.0 * (state.time_us - before.time_us) / (interval_seconds * 1e6);
+            }
+            if (state.usage >= before.usage) {
+                state.entry_rate = (state.usage - before.usage) / interval_seconds;
+            }
+        }
+        states.push_back(state);
+    }
+
+    core.idle_states = std::move(states);
+    if (interval_seconds > 0.0 && !core.idle_states.empty()) {
+        double idle = 0.0;
+        for (const auto& state : core.idle_states) idle += state.residency_percent;
+        core.c0_percent = std::max(0.0, 100.0 - idle);
+    }
+}
+
+void FrequencyMonitor::readThrottle(CoreFrequency& core) {
+    std::string dir = kCpuRoot + "cpu" + std::to_string(core.cpu) + "/thermal_throttle/";
+    core.core_throttle_count = readUllOr(dir + "core_throttle_count");
+    core.package_throttle_count = readUllOr(dir + "package_throttle_count");
+    core.power_limit_count = readUllOr(dir + "core_power_limit_count") +
+                             readUllOr(dir + "package_power_limit_count");
+}
+
+double FrequencyMonitor::getAverageMhz() const {
+    double total = 0.0;
+    int count = 0;
+    for (const auto& core : cores_) {
+        double clock = core.effective_mhz > 0.0 ? core.effective_mhz : core.cur_mhz;
+        if (clock > 0.0) {
+            total += clock;
+            count++;
+        }
+    }
+    return count > 0 ? total / count : 0.0;
+}
+
+double FrequencyMonitor::getAverageMaxMhz() const {
+    double total = 0.0;
+    int count = 0;
+    for (const auto& core : cores_) {
+        if (core.max_mhz > 0.0) {
+            total += core.max_mhz;
+            count++;
+        }
+    }
+    return count > 0 ? total / count : 0.0;
+}
+
+int FrequencyMonitor::getLowClockCount() const {
+    return std::count_if(cores_.begin(), cores_.end(), [](const CoreFrequency& c) { return c.is_low_clock; });
+}
+
+uint64_t FrequencyMonitor::getThrottleEvents() const {
+    uint64_t total = 0;
+    for (const auto& core : cores_) total += core.throttle_events;
+    return total;
+}
+
+bool FrequencyMonitor::hasPowersaveGovernor() const {
+    // intel_pstate/amd-pstate "powersave" is the dynamic default; elsewhere it pins the minimum
+    for (const auto& core : cores_) {
+        if (core.governor == "powersave" && core.driver.find("pstate") == std::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void FrequencyMonitor::printStats(int count) {
+    std::cout << "\n🌡️  FREQUENCY & POWER STATES" << std::endl;
+    std::cout << "─────────────────────────────────────────────────────────────────────" << std::endl;
+
+    if (!isAvailable()) {
+        std::cout << "No cpufreq, MSR or /proc/cpuinfo clock information available" << std::endl;
+        return;
+    }
+
+    const CoreFrequency& first = cores_.front();
+    std::cout << "Governor: " << (first.governor.empty() ? "n/a" : first.governor);
+    if (!first.driver.empty()) {
+        std::cout << " (" << first.driver << ")";
+    }
+    std::cout << " | Avg clock: " << std::fixed << std::setprecision(0) << getAverageMhz() << " MHz";
+    if (getAverageMaxMhz() > 0.0) {
+        std::cout << " of " << getAverageMaxMhz() << " MHz max";
+    }
+    bool effective = std::any_of(cores_.begin(), cores_.end(), [](const CoreFrequency& c) { return c.effective_mhz > 0.0; });
+    std::cout << " | Source: " << (effective ? "APERF/MPERF" : has_cpufreq_ ? "cpufreq" : "/proc/cpuinfo");
+    if (has_msr_ && !effective) {
+        std::cout << " (MSRs readable, base clock unknown)";
+    }
+    std::cout << std::endl;
+
+    std::cout << std::left << std::setw(6) << "CPU"
+              << std::right << std::setw(9) << "CUR MHz"
+              << std::setw(9) << "EFF MHz"
+              << std::setw(9) << "MAX MHz"
+              << std::setw(7) << "C0%"
+              << std::setw(10) << "DEEPEST"
+              << std::setw(8) << "RES%"
+              << std::setw(10) << "THROTTLE"
+              << "  STATUS" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+
+    // Slow or throttled cores first, then CPU order
+    std::vector<const CoreFrequency*> order;
+    for (const auto& core : cores_) order.push_back(&core);
+    std::stable_sort(order.begin(), order.end(), [](const CoreFrequency* a, const CoreFrequency* b) {
+        bool a_flagged = a->is_low_clock || a->throttle_events > 0;
+        bool b_flagged = b->is_low_clock || b->throttle_events > 0;
+        return a_flagged && !b_flagged;
+    });
+
+    for (size_t i = 0; i < order.size() && (int)i < count; i++) {
+        const CoreFrequency& core = *order[i];
+        const IdleStateResidency* deepest = nullptr;
+        for (const auto& state : core.idle_states) {
+            if (!state.disabled) deepest = &state;
+        }
+
+        std::cout << std::left << std::setw(6) << ("cpu" + std::to_string(core.cpu))
+                  << std::right << std::setprecision(0)
+                  << std::setw(9) << core.cur_mhz;
+        if (core.effective_mhz > 0.0) std::cout << std::setw(9) << core.effective_mhz;
+        else std::cout << std::setw(9) << "-";
+        if (core.max_mhz > 0.0) std::cout << std::setw(9) << core.max_mhz;
+        else std::cout << std::setw(9) << "-";
+        if (core.c0_percent >= 0.0) std::cout << std::setw(7) << std::setprecision(1) << core.c0_percent;
+        else std::cout << std::setw(7) << "-";
+        if (deepest) {
+            std::cout << std::setw(10) << deepest->name.substr(0, 9)
+                      << std::setw(8) << std::setprecision(1) << deepest->residency_percent;
+        } else {
+            std::cout << std::setw(10) << "-" << std::setw(8) << "-";
+        }
+        std::cout << std::setw(10) << (core.core_throttle_count + core.package_throttle_count + core.power_limit_count);
+
+        std::string status = core.throttle_events > 0 ? "🔴 THROTTLED" : core.is_low_clock ? "🟡 LOW CLOCK" : "🟢 OK";
+        std::cout << "  " << status << std::endl;
+    }
+    if ((int)cores_.size() > count) {
+        std::cout << "... " << cores_.size() - count << " more CPUs" << std::endl;
+    }
+
+    // System-wide C-state residency (mean over CPUs that expose the state)
+    std::map<std::string, std::pair<double, int>> residency;
+    std::vector<std::string> state_order;
+    for (const auto& core : cores_) {
+        for (const auto& state : core.idle_states) {
+            auto& entry = residency[state.name];
+            if (entry.second == 0) state_order.push_back(state.name);
+            entry.first += state.residency_percent;
+            entry.second++;
+        }
+    }
+    if (!state_order.empty()) {
+        std::cout << "C-state residency:";
+        for (const auto& name : state_order) {
+            std::cout << " " << name << "=" << std::setprecision(1)
+                      << residency[name].first / residency[name].second << "%";
+        }
+        std::cout << std::endl;
+    }
+
+    if (getThrottleEvents() > 0) {
+        std::cout << "⚠️  CRITICAL: " << getThrottleEvents() << " thermal/power-limit throttle events this interval" << std::endl;
+        std::cout << "   → Impact: Cores clocked down by the platform, throughput drops without higher CPU%" << std::endl;
+        std::cout << "   → Solution: Check cooling, BIOS power limits and RAPL settings" << std::endl;
+    }
+    if (hasPowersaveGovernor()) {
+        std::cout << "⚠️  WARNING: powersave governor pins cores at their minimum clock" << std::endl;
+        std::cout << "   → Solution: cpupower frequency-set -g performance (or schedutil)" << std::endl;
+    } else if (getLowClockCount() > 0) {
+        std::cout << "⚠️  WARNING: " << getLowClockCount() << " busy cores below "
+                  << (int)(kLowClockRatio * 100) << "% of max clock" << std::endl;
+        std::cout << "   → Solution: Check governor, energy_performance_preference and scaling_max_freq" << std::endl;
+    }
+}
@@ -0,0 +1,353 @@
+#include "HugePageMonitor.h"
+#include "SysfsUtil.h"
+#include "NumaMonitor.h"
+#include "PerfMonitor.h"
+#include "ProcessMonitor.h"
+#include "PmuCatalog.h"
+#include "Topology.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cstring>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#endif
+
+namespace {
+
+const std::string kThpRoot = "/sys/kernel/mm/transparent_hugepage/";
+
+// Compaction is rare; a small ring per CPU is plenty between updates
+const size_t kRingPages = 8;
+const size_t kMaxOpenCompactions = 4096;
+
+const double kFallbackWarnPercent = 20.0;
+const double kMinFaultRate = 1.0;              // THP faults/sec before fallback % means anything
+const double kStallMsWarn = 10.0;              // 1% of one CPU spent in direct compaction
+const double kStallRateWarn = 10.0;            // compact_stall/sec when stall time is unknown
+const double kCoverageGoodPercent = 50.0;
+const double kDtlbBoundMpki = 2.0;
+
+// "always [madvise] never" -> "madvise"
+std::string selectedChoice(const std::string& text) {
+    size_t open = text.find('[');
+    size_t close = text.find(']', open);
+    if (open == std::string::npos || close == std::string::npos) {
+        return text;
+    }
+    return text.substr(open + 1, close - open - 1);
+}
+
+} // namespace
+
+HugePageMonitor::HugePageMonitor()
+    : numa_monitor_(nullptr), perf_monitor_(nullptr), process_monitor_(nullptr), top_n_(5),
+      settings_{}, anon_kb_(0), anon_huge_kb_(0), shmem_huge_kb_(0), file_huge_kb_(0),
+      anon_coverage_percent_(0.0), fault_alloc_rate_(0.0), fault_fallback_rate_(0.0),
+      fallback_percent_(0.0), collapse_alloc_rate_(0.0), collapse_failed_rate_(0.0),
+      compact_stall_rate_(0.0), compact_fail_rate_(0.0), compact_success_rate_(0.0),
+      rings_(kRingPages, false), begin_id_(0), end_id_(0), topology_generation_(0),
+      stall_ms_per_sec_(-1.0), background_ms_per_sec_(-1.0), first_reading_(true) {
+    last_update_ = std::chrono::steady_clock::now();
+    if (openCompactionTracepoints()) {
+        stall_ms_per_sec_ = 0.0;
+        background_ms_per_sec_ = 0.0;
+    }
+}
+
+HugePageMonitor::~HugePageMonitor() {
+}
+
+void HugePageMonitor::attach(const NumaMonitor* numa, const PerfMonitor* perf, const ProcessMonitor* process, int top_n) {
+    numa_monitor_ = numa;
+    perf_monitor_ = perf;
+    process_monitor_ = process;
+    top_n_ = top_n;
+}
+
+bool HugePageMonitor::openCompactionTracepoints() {
+    PmuCatalog catalog;
+    if (!catalog.resolveTracepoint("compaction", "mm_compaction_begin", begin_id_) ||
+        !catalog.resolveTracepoint("compaction", "mm_compaction_end", end_id_)) {
+        return false;
+    }
+    // All or nothing: a partial set would pair begins with ends from nowhere
+    topology_generation_ = Topology::instance().getGeneration();
+    return rings_.open(Topology::instance().getOnlineCpus(), {begin_id_, end_id_}) && rings_.enable();
+}
+
+bool HugePageMonitor::update() {
+    if (!numa_monitor_) {
+        return false;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    double interval = std::chrono::duration<double>(now - last_update_).count();
+    last_update_ = now;
+
+    readSettings();
+    readMeminfo();
+
+    fault_alloc_rate_ = numa_monitor_->getVmstatRate("thp_fault_alloc");
+    fault_fallback_rate_ = numa_monitor_->getVmstatRate("thp_fault_fallback");
+    double attempts = fault_alloc_rate_ + fault_fallback_rate_;
+    fallback_percent_ = attempts > 0.0 ? 100.0 * fault_fallback_rate_ / attempts : 0.0;
+    collapse_alloc_rate_ = numa_monitor_->getVmstatRate("thp_collapse_alloc");
+    collapse_failed_rate_ = numa_monitor_->getVmstatRate("thp_collapse_alloc_failed");
+    compact_stall_rate_ = numa_monitor_->getVmstatRate("compact_stall");
+    compact_fail_rate_ = numa_monitor_->getVmstatRate("compact_fail");
+    compact_success_rate_ = numa_monitor_->getVmstatRate("compact_success");
+
+    // CPU hotplug: the rings are per CPU, reopen them on the new set
+    if (stall_ms_per_sec_ >= 0.0 && Topology::instance().getGeneration() != topology_generation_) {
+        drainCompactionEvents(0.0);
+        if (!openCompactionTracepoints()) {
+            stall_ms_per_sec_ = -1.0;
+            background_ms_per_sec_ = -1.0;
+        }
+    }
+    if (!rings_.empty()) {
+        drainCompactionEvents(first_reading_ ? 0.0 : interval);
+    }
+    readProcessCoverage();
+
+    first_reading_ = false;
+    return true;
+}
+
+void HugePageMonitor::readSettings() {
+    settings_.enabled = selectedChoice(readFirstLine(kThpRoot + "enabled"));
+    settings_.defrag = selectedChoice(readFirstLine(kThpRoot + "defrag"));
+    settings_.shmem_enabled = selectedChoice(readFirstLine(kThpRoot + "shmem_enabled"));
+    settings_.khugepaged_defrag = readFirstLine(kThpRoot + "khugepaged/defrag") == "1";
+    settings_.khugepaged_pages_to_scan = std::strtoul(readFirstLine(kThpRoot + "khugepaged/pages_to_scan").c_str(), nullptr, 10);
+    settings_.khugepaged_scan_sleep_ms = std::strtoul(readFirstLine(kThpRoot + "khugepaged/scan_sleep_millisecs").c_str(), nullptr, 10);
+}
+
+void HugePageMonitor::readMeminfo() {
+    std::ifstream meminfo("/proc/meminfo");
+    std::string key;
+    unsigned long value;
+    std::string unit;
+    while (meminfo >> key >> value) {
+        std::getline(meminfo, unit);
+        if (key == "AnonPages:") anon_kb_ = value;
+        else if (key == "AnonHugePages:") anon_huge_kb_ = value;
+        else if (key == "ShmemHugePages:") shmem_huge_kb_ = value;
+        else if (key == "FileHugePages:") file_huge_kb_ = value;
+    }
+    // AnonPages counts THP-backed memory as well
+    anon_coverage_percent_ = anon_kb_ > 0 ? 100.0 * anon_huge_kb_ / anon_kb_ : 0.0;
+}
+
+void HugePageMonitor::readProcessCoverage() {
+    processes_.clear();
+    if (!process_monitor_) {
+        return;
+    }
+
+    for (pid_t pid : process_monitor_->getTopMemoryProcesses(top_n_)) {
+        // smaps_rollup (4.14+) sums smaps in the kernel, far cheaper than parsing smaps
+        std::ifstream rollup("/proc/" + std::to_string(pid) + "/smaps_rollup");
+        if (!rollup.is_open()) continue;
+
+        ProcessHugePages process{pid, process_monitor_->getProcessStats(pid).comm, 0, 0, 0, 0, 0.0};
+        std::string line;
+        while (std::getline(rollup, line)) {
+            std::istringstream iss(line);
+            std::string key;
+            unsigned long value = 0;
+            if (!(iss >> key >> value)) continue;
+            if (key == "Anonymous:") process.anonymous_kb = value;
+            else if (key == "AnonHugePages:") process.anon_huge_kb = value;
+            else if (key == "ShmemPmdMapped:") process.shmem_pmd_kb = value;
+            else if (key == "FilePmdMapped:") process.file_pmd_kb = value;
+        }
+        process.coverage_percent = process.anonymous_kb > 0 ? 100.0 * process.anon_huge_kb / process.anonymous_kb : 0.0;
+        processes_.push_back(process);
+    }
+}
+
+bool HugePageMonitor::isKcompactd(pid_t tid) {
+    auto it = kcompactd_tids_.find(tid);
+    if (it != kcompactd_tids_.end()) {
+        return it->second;
+    }
+    bool kcompactd = readFirstLine("/proc/" + std::to_string(tid) + "/comm").rfind("kcompactd", 0) == 0;
+    kcompactd_tids_[tid] = kcompactd;
+    return kcompactd;
+}
+
+void HugePageMonitor::drainCompactionEvents(double interval_seconds) {
+#ifdef __linux__
+    struct Event {
+        uint64_t time;
+        pid_t tid;
+        bool begin;
+    };
+    std::vector<Event> events;
+
+    unsigned long long lost_before = rings_.getLostEvents();
+    rings_.drainAll([&](const uint8_t* record, size_t size) {
+        // Sample body: pid, tid, time, raw size, raw data (common_type first)
+        const size_t body = sizeof(perf_event_header);
+        if (size < body + 4 + 4 + 8 + 4 + 2) {
+            return;
+        }
+        Event event;
+        uint32_t tid;
+        uint16_t type;
+        memcpy(&tid, record + body + 4, sizeof(tid));
+        memcpy(&event.time, record + body + 8, sizeof(event.time));
+        memcpy(&type, record + body + 20, sizeof(type));
+        event.tid = tid;
+        event.begin = type == begin_id_;
+        if (type == begin_id_ || type == end_id_) {
+            events.push_back(event);
+        }
+    });
+
+    // A task can migrate mid-compaction, so pair begin/end across rings in time order
+    std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) { return a.time < b.time; });
+    double direct_ns = 0.0, background_ns = 0.0;
+    for (const auto& event : events) {
+        if (event.begin) {
+            open_compactions_[event.tid] = event.time;
+            continue;
+        }
+        auto it = open_compactions_.find(event.tid);
+        if (it == open_compactions_.end()) continue;
+        double duration = event.time - it->second;
+        open_compactions_.erase(it);
+        (isKcompactd(event.tid) ? background_ns : direct_ns) += duration;
+    }
+    if (rings_.getLostEvents() > lost_before || open_compactions_.size() > kMaxOpenCompactions) {
+        open_compactions_.clear();   // Lost end events; drop stale begins
+    }
+
+    if (interval_seconds > 0.0) {
+        stall_ms_per_sec_ = direct_ns / 1e6 / interval_seconds;
+        background_ms_per_sec_ = background_ns / 1e6 / interval_seconds;
+    }
+#else
+    (void)interval_seconds;
+#endif
+}
+
+bool HugePageMonitor::isCompactionCostly() const {
+    if (stall_ms_per_sec_ >= 0.0) {
+        return stall_ms_per_sec_ > kStallMsWarn;
+    }
+    return compact_stall_rate_ > kStallRateWarn;
+}
+
+bool HugePageMonitor::isFallingBack() const {
+    return fault_alloc_rate_ + fault_fallback_rate_ >= kMinFaultRate && fallback_percent_ > kFallbackWarnPercent;
+}
+
+void HugePageMonitor::printStats() {
+    std::cout << "\n🧱 TRANSPARENT HUGEPAGES & COMPACTION" << std::endl;
+    std::cout << "─────────────────────────────────────────────────────────────────────" << std::endl;
+
+    if (settings_.enabled.empty()) {
+        std::cout << "THP not supported by this kernel (" << kThpRoot << " missing)" << std::endl;
+        return;
+    }
+    std::cout << "Policy: enabled=" << settings_.enabled << " | defrag=" << settings_.defrag
+              << " | shmem=" << settings_.shmem_enabled
+              << " | khugepaged: defrag " << (settings_.khugepaged_defrag ? "on" : "off") << ", "
+              << settings_.khugepaged_pages_to_scan << " pages every " << settings_.khugepaged_scan_sleep_ms << " ms"
+              << std::endl;
+    std::cout << "Coverage: AnonHugePages " << anon_huge_kb_ / 1024 << " MB of " << anon_kb_ / 1024 << " MB anon ("
+              << std::fixed << std::setprecision(1) << anon_coverage_percent_ << "%)"
+              << " | ShmemHugePages " << shmem_huge_kb_ / 1024 << " MB"
+              << " | FileHugePages " << file_huge_kb_ / 1024 << " MB" << std::endl;
+    std::cout << "THP faults: " << std::setprecision(1) << fault_alloc_rate_ << " alloc/s, "
+              << fault_fallback_rate_ << " fallback/s (" << fallback_percent_ << "% fallback)"
+              << " | khugepaged collapse: " << collapse_alloc_rate_ << "/s, " << collapse_failed_rate_ << " failed/s"
+              << std::endl;
+    std::cout << "Compaction: " << compact_stall_rate_ << " stalls/s, " << compact_fail_rate_ << " fail/s, "
+              << compact_success_rate_ << " success/s";
+    if (stall_ms_per_sec_ >= 0.0) {
+        std::cout << " | direct stall " << std::setprecision(2) << stall_ms_per_sec_ << " ms/s"
+                  << ", kcompactd " << background_ms_per_sec_ << " ms/s";
+        if (rings_.getLostEvents() > 0) {
+            std::cout << " (" << rings_.getLostEvents() << " events lost, stall time is a lower bound)";
+        }
+    } else {
+        std::cout << " | stall time n/a (needs tracefs compaction events)";
+    }
+    std::cout << std::endl;
+
+    if (!processes_.empty()) {
+        std::cout << std::left << std::setw(8) << "PID"
+                  << std::setw(16) << "COMMAND"
+                  << std::right << std::setw(10) << "ANON(MB)"
+                  << std::setw(10) << "THP(MB)"
+                  << std::setw(10) << "COVERAGE" << std::endl;
+        for (const auto& process : processes_) {
+            std::cout << std::left << std::setw(8) << process.pid
+                      << std::setw(16) << process.comm.substr(0, 15)
+                      << std::right << std::setw(10) << process.anonymous_kb / 1024
+                      << std::setw(10) << process.anon_huge_kb / 1024
+                      << std::setw(9) << std::setprecision(1) << process.coverage_percent << "%" << std::endl;
+        }
+    } else if (!process_monitor_) {
+        std::cout << "(add --process for per-process huge-page coverage)" << std::endl;
+    }
+
+    // Verdict: cost (compaction, fallback) versus benefit (TLB misses at this coverage)
+    if (settings_.enabled == "never") {
+        std::cout << "⚪ THP disabled - dTLB misses below show what 4 KB pages cost" << std::endl;
+    }
+    if (isCompactionCostly()) {
+        std::cout << "🔴 THP COSTING LATENCY: ";
+        if (stall_ms_per_sec_ >= 0.0) {
+            std::cout << std::setprecision(1) << stall_ms_per_sec_ << " ms/s in direct compaction" << std::endl;
+        } else {
+            std::cout << std::setprecision(1) << compact_stall_rate_ << " direct compaction stalls/s" << std::endl;
+        }
+        std::cout << "   → Solution: defrag=defer+madvise so only madvised regions compact synchronously" << std::endl;
+    }
+    if (isFallingBack()) {
+        std::cout << "🟡 " << std::setprecision(1) << fallback_percent_
+                  << "% of THP faults fell back to 4 KB pages - memory is fragmented" << std::endl;
+        std::cout << "   → Solution: Raise vm.compaction_proactiveness or reserve hugetlbfs pages at boot" << std::endl;
+    }
+
+    const CacheLevelCounters* dtlb = nullptr;
+    if (perf_monitor_) {
+        for (const auto& level : perf_monitor_->getCacheHierarchy()) {
+            if (level.name == "dTLB" && level.available) dtlb = &level;
+        }
+    }
+    if (!dtlb) {
+        if (perf_monitor_) {
+            std::cout << "ℹ️  dTLB miss counters unavailable - cannot judge whether THP is helping" << std::endl;
+        } else {
+            std::cout << "ℹ️  Add --perf (dTLB miss counters) to judge whether THP is helping" << std::endl;
+        }
+        return;
+    }
+    bool tlb_bound = dtlb->mpki > kDtlbBoundMpki;
+    bool covered = anon_coverage_percent_ >= kCoverageGoodPercent;
+    std::cout << std::setprecision(2);
+    if (tlb_bound && !covered) {
+        std::cout << "🟡 THP WOULD HELP: dTLB " << dtlb->mpki << " MPKI with " << std::setprecision(1)
+                  << anon_coverage_percent_ << "% huge-page coverage" << std::endl;
+        std::cout << "   → Solution: enabled=always, or madvise(MADV_HUGEPAGE) on the hot heap" << std::endl;
+    } else if (tlb_bound) {
+        std::cout << "🟡 TLB-BOUND DESPITE THP: dTLB " << dtlb->mpki << " MPKI at " << std::setprecision(1)
+                  << anon_coverage_percent_ << "% coverage - working set exceeds 2 MB-page TLB reach" << std::endl;
+        std::cout << "   → Solution: 1 GB hugetlbfs pages for the largest structures" << std::endl;
+    } else if (covered) {
+        std::cout << "✅ THP HELPING: dTLB " << dtlb->mpki << " MPKI at " << std::setprecision(1)
+                  << anon_coverage_percent_ << "% coverage" << std::endl;
+    } else {
+        std::cout << "✅ Low TLB pressure (dTLB " << dtlb->mpki << " MPKI) - THP has little to gain here" << std::endl;
+    }
+}
@@ -0,0 +1,630 @@
+#include "InterruptMonitor.h"
+#include "SysfsUtil.h"
+#include "Topology.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstring>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <filesystem>
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+const size_t kInitialBufferSize = 64 * 1024;
+
+// Storm: a single CPU taking this many interrupts/sec is saturated by them
+const double kStormPerCpuRate = 50000.0;
+// ...or the IRQ jumped well above its own recent baseline
+const double kStormGrowthFactor = 5.0;
+const double kStormMinRate = 5000.0;
+// Unbalanced: one CPU takes most of a busy IRQ
+const double kUnbalancedShare = 0.8;
+const double kUnbalancedMinRate = 1000.0;
+const double kBaselineWeight = 0.2;
+
+// Affinity is re-read every N updates (irqbalance may move IRQs at any time)
+const int kAffinityRefreshUpdates = 5;
+
+const char* skipSpaces(const char* p, const char* end) {
+#if defined(__SSE2__)
+    // /proc/interrupts columns are right-aligned and mostly padding
+    const __m128i space = _mm_set1_epi8(' ');
+    while (p + 16 <= end) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        unsigned mask = ~(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, space)) & 0xFFFF;
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 16;
+    }
+#endif
+    while (p < end && *p == ' ') p++;
+    return p;
+}
+
+size_t digitRun(const char* p, const char* end) {
+#if defined(__SSE2__)
+    if (p + 16 <= end) {
+        // Unsigned (c - '0') <= 9 marks digits
+        __m128i chunk = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_set1_epi8('0'));
+        __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(chunk, _mm_set1_epi8(9)), chunk);
+        unsigned mask = ~(unsigned)_mm_movemask_epi8(is_digit) & 0xFFFF;
+        if (mask != 0) {
+            return __builtin_ctz(mask);
+        }
+    }
+#endif
+    size_t n = 0;
+    while (p + n < end && (unsigned)(p[n] - '0') <= 9) n++;
+    return n;
+}
+
+uint64_t parseDigits(const char* p, size_t n) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < n; i++) {
+        value = value * 10 + (uint64_t)(p[i] - '0');
+    }
+    return value;
+}
+
+// "PCI-MSIX-0000:00:05.0   2-edge      virtio4-tx" -> single-spaced
+std::string collapseSpaces(std::string_view text) {
+    std::string result;
+    result.reserve(text.size());
+    for (char c : text) {
+        if (c == ' ' && (result.empty() || result.back() == ' ')) continue;
+        result.push_back(c);
+    }
+    return result;
+}
+
+bool isPciAddress(const std::string& name) {
+    // "0000:3b:00.0"
+    return name.size() == 12 && name[4] == ':' && name[7] == ':' && name[10] == '.';
+}
+
+// Nearest PCI ancestor of a sysfs device link (virtio devices sit below their PCI function)
+std::string pciAddressOf(const std::filesystem::path& link) {
+    std::error_code ec;
+    std::filesystem::path path = std::filesystem::canonical(link, ec);
+    if (ec) {
+        return "";
+    }
+    for (; !path.empty() && path != path.root_path(); path = path.parent_path()) {
+        std::string name = path.filename().string();
+        if (isPciAddress(name)) {
+            return name;
+        }
+    }
+    return "";
+}
+
+int trailingNumber(const std::string& text) {
+    size_t end = text.size();
+    size_t start = end;
+    while (start > 0 && isdigit((unsigned char)text[start - 1])) start--;
+    return start < end ? std::stoi(text.substr(start)) : -1;
+}
+
+} // namespace
+
+InterruptMonitor::InterruptMonitor(const std::string& path)
+    : fd_(-1), buffer_(kInitialBufferSize), length_(0), updates_since_affinity_(0),
+      total_rate_(0.0), first_reading_(true) {
+    fd_ = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+        std::cerr << "Failed to open " << path << std::endl;
+    }
+    last_update_ = std::chrono::steady_clock::now();
+}
+
+InterruptMonitor::~InterruptMonitor() {
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+bool InterruptMonitor::readFile() {
+    // Keep the fd open and re-read from offset 0; grow until the whole file fits
+    while (true) {
+        length_ = 0;
+        while (length_ < buffer_.size()) {
+            ssize_t n = pread(fd_, buffer_.data() + length_, buffer_.size() - length_, length_);
+            if (n < 0) {
+                return false;
+            }
+            if (n == 0) {
+                return length_ > 0;
+            }
+            length_ += n;
+        }
+        buffer_.resize(buffer_.size() * 2);
+    }
+}
+
+bool InterruptMonitor::parseHeader(const char*& p, const char* end) {
+    const char* line_end = static_cast<const char*>(memchr(p, '\n', end - p));
+    if (!line_end) {
+        return false;
+    }
+
+    // "           CPU0       CPU1 ..." - offline CPUs have no column
+    std::vector<int> columns;
+    while (true) {
+        p = skipSpaces(p, line_end);
+        if (p + 3 > line_end || memcmp(p, "CPU", 3) != 0) break;
+        p += 3;
+        size_t n = digitRun(p, line_end);
+        columns.push_back((int)parseDigits(p, n));
+        p += n;
+    }
+    p = line_end + 1;
+
+    if (columns.empty()) {
+        return false;
+    }
+    pending_columns_.swap(columns);
+    return true;
+}
+
+bool InterruptMonitor::parseRows(const char* p, const char* end) {
+    const size_t ncols = pending_columns_.size();
+    scratch_names_.clear();
+    scratch_descriptions_.clear();
+    scratch_per_cpu_.clear();
+    scratch_counts_.clear();
+
+    while (p < end) {
+        const char* line_end = static_cast<const char*>(memchr(p, '\n', end - p));
+        if (!line_end) line_end = end;
+
+        p = skipSpaces(p, line_end);
+        const char* colon = static_cast<const char*>(memchr(p, ':', line_end - p));
+        if (!colon) {
+            p = line_end + 1;
+            continue;
+        }
+        scratch_names_.emplace_back(p, colon - p);
+        p = colon + 1;
+
+        // Per-CPU counts; ERR/MIS carry a single system-wide value
+        size_t parsed = 0;
+        while (parsed < ncols) {
+            p = skipSpaces(p, line_end);
+            size_t n = digitRun(p, line_end);
+            if (n == 0) break;
+            scratch_counts_.push_back(parseDigits(p, n));
+            p += n;
+            parsed++;
+        }
+        scratch_counts_.resize(scratch_counts_.size() + (ncols - parsed), 0);
+        scratch_per_cpu_.push_back(parsed == ncols);
+
+        p = skipSpaces(p, line_end);
+        const char* desc_end = line_end;
+        while (desc_end > p && (desc_end[-1] == ' ' || desc_end[-1] == '\r')) desc_end--;
+        scratch_descriptions_.emplace_back(p, desc_end - p);
+
+        p = line_end + 1;
+    }
+
+    return !scratch_names_.empty();
+}
+
+void InterruptMonitor::rebuildLayout() {
+    const size_t ncols = pending_columns_.size();
+    const size_t old_ncols = columns_.size();
+
+    // New column -> old column for the same CPU, so hotplug keeps valid deltas
+    std::vector<int> column_map(ncols, -1);
+    for (size_t c = 0; c < ncols; c++) {
+        auto it = std::find(columns_.begin(), columns_.end(), pending_columns_[c]);
+        if (it != columns_.end()) column_map[c] = it - columns_.begin();
+    }
+
+    std::vector<IrqRow> rows;
+    std::unordered_map<std::string, size_t> row_index;
+    // Rows without history start from their current value (zero delta)
+    std::vector<uint64_t> previous(scratch_counts_);
+
+    for (size_t r = 0; r < scratch_names_.size(); r++) {
+        IrqRow row{};
+        row.name = std::string(scratch_names_[r]);
+        row.description = collapseSpaces(scratch_descriptions_[r]);
+        row.per_cpu = scratch_per_cpu_[r];
+        row.top_cpu = -1;
+
+        auto old = row_index_.find(row.name);
+        if (old != row_index_.end() && !first_reading_) {
+            row.baseline_rate = rows_[old->second].baseline_rate;
+            for (size_t c = 0; c < ncols; c++) {
+                if (column_map[c] >= 0) {
+                    previous[r * ncols + c] = counts_[old->second * old_ncols + column_map[c]];
+                }
+            }
+        }
+
+        row_index[row.name] = r;
+        rows.push_back(std::move(row));
+    }
+
+    rows_.swap(rows);
+    row_index_.swap(row_index);
+    columns_ = pending_columns_;
+    previous_counts_.swap(previous);
+    rates_.assign(rows_.size() * ncols, 0.0);
+}
+
+bool InterruptMonitor::update() {
+    if (fd_ < 0 || !readFile()) {
+        return false;
+    }
+
+    const char* p = buffer_.data();
+    const char* end = p + length_;
+    if (!parseHeader(p, end) || !parseRows(p, end)) {
+        return false;
+    }
+
+    // Same IRQs on the same CPUs as last time: just rotate the arrays
+    bool same_layout = pending_columns_ == columns_ && scratch_names_.size() == rows_.size();
+    for (size_t r = 0; same_layout && r < rows_.size(); r++) {
+        same_layout = scratch_names_[r] == rows_[r].name;
+    }
+
+    if (same_layout) {
+        previous_counts_.swap(counts_);
+    } else {
+        rebuildLayout();
+    }
+    counts_.swap(scratch_counts_);
+    
+    if (!same_layout) {
+        resolveIdentities();
+    } else if (++updates_since_affinity_ >= kAffinityRefreshUpdates) {
+        refreshAffinity();
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    double interval_seconds = std::chrono::duration<double>(now - last_update_).count();
+    last_update_ = now;
+
+    if (!first_reading_ && interval_seconds > 0.0) {
+        calculateRates(interval_seconds);
+    }
+    first_reading_ = false;
+
+    return true;
+}
+
+void InterruptMonitor::calculateRates(double interval_seconds) {
+    const size_t ncols = columns_.size();
+    total_rate_ = 0.0;
+
+    for (size_t r = 0; r < rows_.size(); r++) {
+        IrqRow& row = rows_[r];
+        const uint64_t* current = &counts_[r * ncols];
+        const uint64_t* previous = &previous_counts_[r * ncols];
+        double* rates = &rates_[r * ncols];
+
+        double row_rate = 0.0;
+        double top_rate = 0.0;
+        int top_column = -1;
+        for (size_t c = 0; c < ncols; c++) {
+            // Counters never go backwards except across a reset
+            uint64_t delta = current[c] >= previous[c] ? current[c] - previous[c] : 0;
+            rates[c] = delta / interval_seconds;
+            row_rate += rates[c];
+            if (rates[c] > top_rate) {
+                top_rate = rates[c];
+                top_column = c;
+            }
+        }
+
+        row.rate = row_rate;
+        row.top_cpu = top_column >= 0 ? columns_[top_column] : -1;
+        row.top_cpu_share = row_rate > 0.0 ? top_rate / row_rate : 0.0;
+
+        row.is_storm = (row.per_cpu && top_rate > kStormPerCpuRate) ||
+                       (row.baseline_rate > 0.0 && row_rate > kStormMinRate &&
+                        row_rate > kStormGrowthFactor * row.baseline_rate);
+        row.is_unbalanced = row.per_cpu && ncols > 1 && row_rate > kUnbalancedMinRate &&
+                            row.top_cpu_share > kUnbalancedShare;
+
+        row.baseline_rate = row.baseline_rate > 0.0
+                                ? (1.0 - kBaselineWeight) * row.baseline_rate + kBaselineWeight * row_rate
+                                : row_rate;
+        if (row.per_cpu) {
+            total_rate_ += row_rate;
+        }
+    }
+}
+
+void InterruptMonitor::resolveIdentities() {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    
+    // PCI function -> friendly name (NVMe controller, netdev or disk)
+    std::map<std::string, std::string> pci_names;
+    std::vector<std::string> netdevs;
+    for (const char* class_dir : {"/sys/class/nvme", "/sys/class/net", "/sys/class/block"}) {
+        for (const auto& entry : fs::directory_iterator(class_dir, ec)) {
+            std::string name = entry.path().filename().string();
+            if (fs::exists(entry.path() / "partition", ec)) continue;
+            if (std::string(class_dir) == "/sys/class/net") netdevs.push_back(name);
+            std::string pci = pciAddressOf(entry.path() / "device");
+            if (!pci.empty() && !pci_names.count(pci)) {
+                pci_names[pci] = name;
+            }
+        }
+    }
+    
+    // IRQ -> PCI function, from each function's MSI vectors and legacy INTx line
+    std::map<int, std::string> irq_pci;
+    for (const auto& device : fs::directory_iterator("/sys/bus/pci/devices", ec)) {
+        std::string pci = device.path().filename().string();
+        for (const auto& msi : fs::directory_iterator(device.path() / "msi_irqs", ec)) {
+            irq_pci[std::atoi(msi.path().filename().c_str())] = pci;
+        }
+        int legacy = std::atoi(readFirstLine((device.path() / "irq").string()).c_str());
+        if (legacy > 0 && !irq_pci.count(legacy)) {
+            irq_pci[legacy] = pci;
+        }
+    }
+    
+    for (auto& row : rows_) {
+        row.irq = !row.name.empty() && std::all_of(row.name.begin(), row.name.end(), ::isdigit) ? std::stoi(row.name) : -1;
+        row.queue = -1;
+        row.device_node = -1;
+        if (row.irq < 0) continue;
+        
+        // "<chip> <hwirq>-<type> <action>[, <action>...]"
+        std::istringstream iss(row.description);
+        std::string token, rest;
+        iss >> row.chip >> row.hwirq;
+        if (iss >> token && (token == "Level" || token == "Edge")) {
+            row.hwirq += "-" + token;  // GIC style: "27 Level"
+            token.clear();
+        }
+        std::getline(iss, rest);
+        rest = token + rest;
+        row.actions.clear();
+        std::stringstream actions(rest);
+        while (std::getline(actions, token, ',')) {
+            size_t start = token.find_first_not_of(' ');
+            size_t end = token.find_last_not_of(' ');
+            if (start != std::string::npos) row.actions.push_back(token.substr(start, end - start + 1));
+        }
+        
+        auto pci = irq_pci.find(row.irq);
+        if (pci != irq_pci.end()) {
+            row.pci_address = pci->second;
+        } else if (row.chip.size() > 12 && isPciAddress(row.chip.substr(row.chip.size() - 12))) {
+            row.pci_address = row.chip.substr(row.chip.size() - 12);  // "PCI-MSIX-0000:00:05.0"
+        }
+        
+        // Queue IRQs name the device: "nvme0q3", "eth0-TxRx-3", "ens5f0-rx-2"
+        const std::string action = row.actions.empty() ? "" : row.actions.front();
+        size_t q = action.find('q');
+        if (action.rfind("nvme", 0) == 0 && q != std::string::npos && q > 4) {
+            row.device = action.substr(0, q);
+            row.queue = trailingNumber(action);
+        } else {
+            for (const auto& netdev : netdevs) {
+                if (action.size() > netdev.size() && action.compare(0, netdev.size(), netdev) == 0 &&
+                    action[netdev.size()] == '-' && netdev.size() > row.device.size()) {
+                    row.device = netdev;
+                    row.queue = trailingNumber(action);
+                }
+            }
+        }
+        if (row.device.empty() && !row.pci_address.empty()) {
+            auto name = pci_names.find(row.pci_address);
+            row.device = name != pci_names.end() ? name->second : row.pci_address;
+            // "virtio3-input.0", "mlx5_comp3@pci:0000:3b:00.0"
+            row.queue = trailingNumber(action.substr(0, action.find('@')));
+        }
+        
+        if (!row.pci_address.empty()) {
+            std::string node = readFirstLine("/sys/bus/pci/devices/" + row.pci_address + "/numa_node");
+            row.device_node = node.empty() ? -1 : std::atoi(node.c_str());
+        }
+    }
+    
+    refreshAffinity();
+}
+
+void InterruptMonitor::refreshAffinity() {
+    for (auto& row : rows_) {
+        if (row.irq < 0) continue;
+        
+        std::string base = "/proc/irq/" + std::to_string(row.irq) + "/";
+        row.affinity = Topology::parseCpuList(readFirstLine(base + "smp_affinity_list"));
+        row.effective_affinity = Topology::parseCpuList(readFirstLine(base + "effective_affinity_list"));
+        if (row.effective_affinity.empty()) {
+            row.effective_affinity = row.affinity;
+        }
+        
+        row.effective_node = -1;
+        bool on_device_node = false;
+        for (size_t i = 0; i < row.effective_affinity.size(); i++) {
+            int node = Topology::instance().getNodeOfCpu(row.effective_affinity[i]);
+            if (i == 0) {
+                row.effective_node = node;
+            } else if (node != row.effective_node) {
+                row.effective_node = -1;
+            }
+            on_device_node = on_device_node || node == row.device_node;
+        }
+        row.is_cross_numa = row.device_node >= 0 && !row.effective_affinity.empty() && !on_device_node;
+    }
+    updates_since_affinity_ = 0;
+}
+
+int InterruptMonitor::getCrossNumaCount() const {
+    return std::count_if(rows_.begin(), rows_.end(),
+                         [](const IrqRow& row) { return row.is_cross_numa && row.rate > 0.0; });
+}
+
+const IrqRow* InterruptMonitor::findRow(const std::string& name) const {
+    auto it = row_index_.find(name);
+    return it != row_index_.end() ? &rows_[it->second] : nullptr;
+}
+
+double InterruptMonitor::getCpuRate(size_t column) const {
+    double total = 0.0;
+    const size_t ncols = columns_.size();
+    for (size_t r = 0; r < rows_.size(); r++) {
+        if (rows_[r].per_cpu) {
+            total += rates_[r * ncols + column];
+        }
+    }
+    return total;
+}
+
+std::map<int, double> InterruptMonitor::getCpuRates() const {
+    std::map<int, double> rates;
+    for (size_t c = 0; c < columns_.size(); c++) {
+        rates[columns_[c]] = getCpuRate(c);
+    }
+    return rates;
+}
+
+int InterruptMonitor::getStormCount() const {
+    return std::count_if(rows_.begin(), rows_.end(), [](const IrqRow& row) { return row.is_storm; });
+}
+
+int InterruptMonitor::getUnbalancedCount() const {
+    return std::count_if(rows_.begin(), rows_.end(), [](const IrqRow& row) { return row.is_unbalanced; });
+}
+
+void InterruptMonitor::printStats(int count) {
+    std::cout << "🔍 INTERRUPT ANALYSIS" << std::endl;
+    std::cout << "─────────────────────────────────────────────────────────────────────" << std::endl;
+
+    if (first_reading_ || rows_.empty()) {
+        std::cout << "Interrupt rates (first reading - not available yet)" << std::endl;
+        return;
+    }
+
+    // Rank by what is happening now, not by counts accumulated since boot
+    std::vector<size_t> order;
+    for (size_t r = 0; r < rows_.size(); r++) {
+        if (rows_[r].rate > 0.0) order.push_back(r);
+    }
+    std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        if (rows_[a].is_storm != rows_[b].is_storm) return rows_[a].is_storm;
+        return rows_[a].rate > rows_[b].rate;
+    });
+
+    std::cout << "Total: " << std::fixed << std::setprecision(0) << total_rate_ << " interrupts/sec on "
+              << columns_.size() << " CPUs" << std::endl;
+    std::cout << std::left << std::setw(8) << "IRQ"
+              << std::right << std::setw(12) << "RATE/s"
+              << std::setw(9) << "TOP CPU"
+              << std::setw(8) << "SHARE"
+              << "  " << std::left << std::setw(14) << "STATUS"
+              << "DESCRIPTION" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+
+    for (size_t i = 0; i < order.size() && (int)i < count; i++) {
+        const IrqRow& row = rows_[order[i]];
+        std::string status = row.is_storm ? "🔴 STORM" : row.is_unbalanced ? "🟡 UNBALANCED" : "🟢 OK";
+
+        std::cout << std::left << std::setw(8) << row.name
+                  << std::right << std::setw(12) << std::setprecision(0) << row.rate;
+        if (row.per_cpu && row.top_cpu >= 0) {
+            std::cout << std::setw(9) << ("cpu" + std::to_string(row.top_cpu))
+                      << std::setw(7) << std::setprecision(0) << row.top_cpu_share * 100.0 << "%";
+        } else {
+            std::cout << std::setw(9) << "-" << std::setw(8) << "-";
+        }
+        std::cout << "  " << std::left << std::setw(16) << status << row.description.substr(0, 40) << std::endl;
+    }
+
+    if (order.empty()) {
+        std::cout << "No interrupt activity in the last interval" << std::endl;
+    }
+
+    // Busiest CPUs by interrupt load
+    if (columns_.size() > 1) {
+        std::vector<std::pair<double, int>> cpu_rates;
+        for (size_t c = 0; c < columns_.size(); c++) {
+            cpu_rates.push_back({getCpuRate(c), columns_[c]});
+        }
+        std::sort(cpu_rates.rbegin(), cpu_rates.rend());
+        std::cout << "Busiest CPUs:";
+        for (size_t i = 0; i < cpu_rates.size() && i < 5; i++) {
+            std::cout << " cpu" << cpu_rates[i].second << "=" << std::setprecision(0) << cpu_rates[i].first << "/s";
+        }
+        std::cout << std::endl;
+    }
+
+    int storm_count = getStormCount();
+    int unbalanced_count = getUnbalancedCount();
+    if (storm_count > 0 || unbalanced_count > 0) {
+        std::cout << std::endl;
+        if (storm_count > 0) {
+            std::cout << "⚠️  CRITICAL: " << storm_count << " interrupt storms detected!" << std::endl;
+            std::cout << "   → Impact: CPU overwhelmed by interrupts, I/O performance severely degraded" << std::endl;
+            std::cout << "   → Solution: Check device drivers, consider interrupt affinity tuning" << std::endl;
+        }
+        if (unbalanced_count > 0) {
+            std::cout << "⚠️  WARNING: " << unbalanced_count << " unbalanced interrupts" << std::endl;
+            std::cout << "   → Impact: Some CPU cores overloaded, others idle - poor scaling" << std::endl;
+            std::cout << "   → Solution: Use irqbalance, or preview a layout with --plan-irq-affinity (sysprobe-advanced)" << std::endl;
+        }
+    }
+}
+
+void InterruptMonitor::printIrqAffinity(int count) const {
+    std::vector<const IrqRow*> device_irqs;
+    for (const auto& row : rows_) {
+        if (row.irq >= 0 && !row.device.empty()) device_irqs.push_back(&row);
+    }
+    std::sort(device_irqs.begin(), device_irqs.end(),
+              [](const IrqRow* a, const IrqRow* b) { return a->rate > b->rate; });
+    
+    std::cout << "\n🧭 DEVICE IRQ AFFINITY" << std::endl;
+    std::cout << std::left << std::setw(6) << "IRQ"
+              << std::setw(14) << "DEVICE"
+              << std::setw(18) << "ACTION"
+              << std::right << std::setw(9) << "DEV NODE"
+              << std::setw(12) << "EFF CPUS"
+              << std::setw(10) << "CPU NODE"
+              << std::setw(10) << "RATE/s" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+    
+    for (size_t i = 0; i < device_irqs.size() && (int)i < count; i++) {
+        const IrqRow& row = *device_irqs[i];
+        auto node = [](int n) { return n >= 0 ? std::to_string(n) : std::string("-"); };
+        std::cout << std::left << std::setw(6) << row.irq
+                  << std::setw(14) << row.device.substr(0, 13)
+                  << std::setw(18) << (row.actions.empty() ? "-" : row.actions.front().substr(0, 17))
+                  << std::right << std::setw(9) << node(row.device_node)
+                  << std::setw(12) << Topology::formatCpuList(row.effective_affinity).substr(0, 11)
+                  << std::setw(10) << node(row.effective_node)
+                  << std::setw(10) << std::fixed << std::setprecision(0) << row.rate
+                  << (row.is_cross_numa ? "  ⚠️ CROSS-NUMA" : "") << std::endl;
+    }
+    
+    if (device_irqs.empty()) {
+        std::cout << "No device IRQs found" << std::endl;
+    }
+    
+    int cross_numa = getCrossNumaCount();
+    if (cross_numa > 0) {
+        std::cout << "🔴 CROSS-NUMA IRQS: " << cross_numa << " active device IRQs serviced on a remote node" << std::endl;
+        std::cout << "   → Impact: Completions and packet data cross the interconnect, adding latency" << std::endl;
+        std::cout << "   → Solution: Pin queue IRQs to CPUs on the device's node (smp_affinity_list)" << std::endl;
+    }
+}
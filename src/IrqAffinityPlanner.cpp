@@ -0,0 +1,214 @@
+#include "IrqAffinityPlanner.h"
+#include "CpuMonitor.h"
+#include "Topology.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+// Per-CPU planning state; queues of one device spread before loads are compared
+struct CpuSlot {
+    int cpu;
+    int device_queues;
+    double irq_rate;               // IRQs that stay where they are plus planned queues
+    double softirq_rate;           // Measured NET_RX/NET_TX/BLOCK/IRQ_POLL softirqs per second
+    double irq_percent;            // Measured hardirq + softirq time
+};
+
+// Softirqs that multi-queue NICs and block devices raise from their IRQ handlers
+const SoftirqType kDeviceSoftirqs[] = {SOFTIRQ_NET_TX, SOFTIRQ_NET_RX, SOFTIRQ_BLOCK, SOFTIRQ_IRQ_POLL};
+
+} // namespace
+
+std::map<int, double> IrqAffinityPlanner::cpuIrqPercent(const std::map<int, CpuTimes>& before,
+                                                        const std::map<int, CpuTimes>& after) {
+    std::map<int, double> percent;
+    for (const auto& [cpu, end] : after) {
+        auto start = before.find(cpu);
+        if (start == before.end()) continue;
+        unsigned long start_total = CpuMonitor::totalTicks(start->second);
+        unsigned long end_total = CpuMonitor::totalTicks(end);
+        unsigned long start_irq = start->second.irq + start->second.softirq;
+        unsigned long end_irq = end.irq + end.softirq;
+        if (end_total <= start_total || end_irq < start_irq) continue;
+        percent[cpu] = 100.0 * (end_irq - start_irq) / (end_total - start_total);
+    }
+    return percent;
+}
+
+bool IrqAffinityPlanner::plan(const InterruptMonitor& interrupts, const SoftirqMonitor& softirqs,
+                              const std::map<int, double>& cpu_irq_percent) {
+    assignments_.clear();
+    const auto& rows = interrupts.getRows();
+    const auto& columns = interrupts.getColumnCpus();
+
+    // Multi-queue devices: at least two queue IRQs under one device name
+    std::map<std::string, std::vector<size_t>> devices;
+    for (size_t r = 0; r < rows.size(); r++) {
+        if (rows[r].irq >= 0 && rows[r].queue >= 0 && !rows[r].device.empty()) {
+            devices[rows[r].device].push_back(r);
+        }
+    }
+    for (auto it = devices.begin(); it != devices.end();) {
+        it = it->second.size() < 2 ? devices.erase(it) : std::next(it);
+    }
+    if (devices.empty()) {
+        return false;
+    }
+
+    // Baseline per CPU: rate of every IRQ that is not being planned
+    std::vector<bool> planned_row(rows.size(), false);
+    for (const auto& [device, row_ids] : devices) {
+        for (size_t r : row_ids) planned_row[r] = true;
+    }
+    std::map<int, double> softirq_rates;
+    for (SoftirqType type : kDeviceSoftirqs) {
+        for (const auto& [cpu, rate] : softirqs.getCpuRates(type)) softirq_rates[cpu] += rate;
+    }
+    std::map<int, CpuSlot> slots;
+    for (size_t c = 0; c < columns.size(); c++) {
+        CpuSlot slot{columns[c], 0, 0.0, 0.0, 0.0};
+        auto softirq = softirq_rates.find(columns[c]);
+        if (softirq != softirq_rates.end()) slot.softirq_rate = softirq->second;
+        auto percent = cpu_irq_percent.find(columns[c]);
+        if (percent != cpu_irq_percent.end()) slot.irq_percent = percent->second;
+        for (size_t r = 0; r < rows.size(); r++) {
+            if (rows[r].per_cpu && !planned_row[r]) slot.irq_rate += interrupts.getRate(r, c);
+        }
+        slots[columns[c]] = slot;
+    }
+
+    // Busiest devices first so their queues get the quietest CPUs
+    std::vector<std::pair<double, std::string>> device_order;
+    for (const auto& [device, row_ids] : devices) {
+        double rate = 0.0;
+        for (size_t r : row_ids) rate += rows[r].rate;
+        device_order.push_back({rate, device});
+    }
+    std::sort(device_order.rbegin(), device_order.rend());
+
+    for (const auto& [device_rate, device] : device_order) {
+        std::vector<size_t> row_ids = devices[device];
+        int node = rows[row_ids.front()].device_node;
+
+        // Local CPUs when the device's node is known and has online CPUs
+        std::vector<CpuSlot*> candidates;
+        for (auto& [cpu, slot] : slots) {
+            slot.device_queues = 0;
+            if (node < 0 || Topology::instance().getNodeOfCpu(cpu) == node) candidates.push_back(&slot);
+        }
+        if (candidates.empty()) {
+            for (auto& [cpu, slot] : slots) candidates.push_back(&slot);
+        }
+
+        // Longest-processing-time first: heaviest queue onto the least loaded CPU
+        std::sort(row_ids.begin(), row_ids.end(), [&rows](size_t a, size_t b) {
+            if (rows[a].rate != rows[b].rate) return rows[a].rate > rows[b].rate;
+            return rows[a].queue < rows[b].queue;
+        });
+        for (size_t r : row_ids) {
+            CpuSlot* best = *std::min_element(candidates.begin(), candidates.end(),
+                [](const CpuSlot* a, const CpuSlot* b) {
+                    if (a->device_queues != b->device_queues) return a->device_queues < b->device_queues;
+                    if (a->irq_rate != b->irq_rate) return a->irq_rate < b->irq_rate;
+                    if (a->softirq_rate != b->softirq_rate) return a->softirq_rate < b->softirq_rate;
+                    if (a->irq_percent != b->irq_percent) return a->irq_percent < b->irq_percent;
+                    return a->cpu < b->cpu;
+                });
+            best->device_queues++;
+            best->irq_rate += rows[r].rate;
+
+            const IrqRow& row = rows[r];
+            IrqAssignment assignment{row.irq, row.device, row.actions.empty() ? "" : row.actions.front(),
+                                     row.queue, row.device_node, row.rate, row.affinity, {best->cpu},
+                                     false, false, ""};
+            assignment.changed = assignment.current != assignment.planned;
+            assignments_.push_back(assignment);
+        }
+    }
+
+    std::sort(assignments_.begin(), assignments_.end(), [](const IrqAssignment& a, const IrqAssignment& b) {
+        return a.device != b.device ? a.device < b.device : a.queue < b.queue;
+    });
+    return true;
+}
+
+int IrqAffinityPlanner::getChangeCount() const {
+    return std::count_if(assignments_.begin(), assignments_.end(),
+                         [](const IrqAssignment& a) { return a.changed; });
+}
+
+void IrqAffinityPlanner::printPlan() const {
+    std::cout << "\n🧭 IRQ AFFINITY PLAN" << std::endl;
+    std::cout << "─────────────────────────────────────────────────────────────────────" << std::endl;
+
+    if (assignments_.empty()) {
+        std::cout << "No multi-queue NVMe/NIC devices found - nothing to plan" << std::endl;
+        return;
+    }
+
+    std::cout << std::left << std::setw(6) << "IRQ"
+              << std::setw(12) << "DEVICE"
+              << std::setw(20) << "ACTION"
+              << std::right << std::setw(6) << "NODE"
+              << std::setw(10) << "RATE/s"
+              << "  " << std::left << "AFFINITY" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+
+    for (const auto& a : assignments_) {
+        std::cout << std::left << std::setw(6) << a.irq
+                  << std::setw(12) << a.device.substr(0, 11)
+                  << std::setw(20) << a.action.substr(0, 19)
+                  << std::right << std::setw(6) << (a.device_node >= 0 ? std::to_string(a.device_node) : "-")
+                  << std::setw(10) << std::fixed << std::setprecision(0) << a.rate << "  ";
+        if (a.changed) {
+            std::cout << "- " << Topology::formatCpuList(a.current)
+                      << "  + " << Topology::formatCpuList(a.planned);
+        } else {
+            std::cout << "= " << Topology::formatCpuList(a.current);
+        }
+        if (!a.error.empty()) {
+            std::cout << "  ⚠️ " << a.error;
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << getChangeCount() << " of " << assignments_.size() << " queue IRQs would move" << std::endl;
+}
+
+int IrqAffinityPlanner::apply() {
+    int moved = 0;
+    for (auto& a : assignments_) {
+        if (!a.changed) continue;
+
+        std::string path = "/proc/irq/" + std::to_string(a.irq) + "/smp_affinity_list";
+        std::string cpus = Topology::formatCpuList(a.planned) + "\n";
+        int fd = open(path.c_str(), O_WRONLY);
+        if (fd < 0) {
+            a.error = std::string("open failed: ") + strerror(errno);
+            continue;
+        }
+        ssize_t written = write(fd, cpus.data(), cpus.size());
+        int write_errno = errno;
+        close(fd);
+
+        if (written < 0) {
+            // Managed IRQs (e.g. NVMe with managed_irq) reject writes with EIO;
+            // EINVAL means no online CPU in the mask or an IRQ that cannot move
+            if (write_errno == EIO) {
+                a.error = "kernel-managed, not movable (EIO)";
+            } else {
+                a.error = std::string("write failed: ") + strerror(write_errno);
+            }
+            continue;
+        }
+        a.applied = true;
+        moved++;
+    }
+    return moved;
+}
@@ -0,0 +1,415 @@
+#include "MemoryBenchmark.h"
+#include "SysfsUtil.h"
+#include "Topology.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
+#include <sched.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+namespace {
+
+// <linux/mempolicy.h> values; spelled out so the build needs no libnuma headers
+const int kMpolDefault = 0;
+const int kMpolBind = 2;
+const unsigned kMpolMfStrict = 1 << 0;
+const unsigned kMpolMfMove = 1 << 1;
+const unsigned long kMpolFNode = 1 << 0;
+const unsigned long kMpolFAddr = 1 << 1;
+
+const size_t kCacheLine = 64;
+const size_t kHugePage = 2 * 1024 * 1024;
+const int kMapHuge2MB = 21 << 26;       // MAP_HUGE_2MB: log2(size) << MAP_HUGE_SHIFT
+const size_t kLatencyLoads = 20 * 1000 * 1000;
+
+// Remote/local latency below this on a multi-node box suggests BIOS interleaving
+const double kUniformLatencyRatio = 1.1;
+// Remote/local triad bandwidth above this suggests the same
+const double kUniformBandwidthRatio = 0.9;
+
+long mbindNode(void* addr, size_t len, int node) {
+    unsigned long mask[16] = {};
+    mask[node / 64] |= 1UL << (node % 64);
+    return syscall(SYS_mbind, addr, len, kMpolBind, mask, sizeof(mask) * 8, kMpolMfStrict | kMpolMfMove);
+}
+
+long setMempolicyNode(int node) {
+    if (node < 0) {
+        return syscall(SYS_set_mempolicy, kMpolDefault, nullptr, 0);
+    }
+    unsigned long mask[16] = {};
+    mask[node / 64] |= 1UL << (node % 64);
+    return syscall(SYS_set_mempolicy, kMpolBind, mask, sizeof(mask) * 8);
+}
+
+// Node actually backing the page at addr, -1 if unknown
+int nodeOfAddress(void* addr) {
+    int node = -1;
+    if (syscall(SYS_get_mempolicy, &node, nullptr, 0, addr, kMpolFNode | kMpolFAddr) != 0) {
+        return -1;
+    }
+    return node;
+}
+
+// Free 2 MB hugetlbfs pages in one node's pool; 0 without NUMA hugepage sysfs
+size_t freeHugePagesOnNode(int node) {
+    std::string value = readFirstLine("/sys/devices/system/node/node" + std::to_string(node) +
+                                      "/hugepages/hugepages-2048kB/free_hugepages");
+    return value.empty() ? 0 : std::stoul(value);
+}
+
+// AnonHugePages of the mapping holding addr, from /proc/self/smaps; the VMA
+// may have merged with a neighbouring anonymous mapping, so this is an upper bound
+size_t anonHugeBytes(const void* addr) {
+    std::ifstream smaps("/proc/self/smaps");
+    uintptr_t target = reinterpret_cast<uintptr_t>(addr);
+    bool inside = false;
+    std::string line;
+    while (std::getline(smaps, line)) {
+        // "7f12c0000000-7f12c4000000 rw-p 00000000 00:00 0"
+        unsigned long start, end;
+        char dash;
+        std::istringstream range(line);
+        if (range >> std::hex >> start >> dash >> end && dash == '-') {
+            inside = target >= start && target < end;
+        } else if (inside && line.compare(0, 14, "AnonHugePages:") == 0) {
+            return std::strtoul(line.c_str() + 14, nullptr, 10) * 1024;
+        }
+    }
+    return 0;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+MemoryBenchmark::MemoryBenchmark(const MembenchConfig& config) : config_(config) {
+    const Topology& topology = Topology::instance();
+    for (const auto& [node, info] : topology.getNodes()) {
+        if (!info.cpus.empty()) cpu_nodes_.push_back(node);
+    }
+    memory_nodes_ = Topology::parseCpuList(readFirstLine("/sys/devices/system/node/has_memory"));
+
+    // Kernels without NUMA: a single node 0 covering every CPU
+    if (cpu_nodes_.empty()) cpu_nodes_.push_back(0);
+    if (memory_nodes_.empty()) memory_nodes_.push_back(0);
+}
+
+bool MemoryBenchmark::run() {
+    const Topology& topology = Topology::instance();
+    cpu_set_t original;
+    sched_getaffinity(0, sizeof(original), &original);
+
+    for (int cpu_node : cpu_nodes_) {
+        std::vector<int> cpus = topology.getNodeCpus(cpu_node);
+        if (cpus.empty()) cpus = topology.getOnlineCpus();
+
+        for (int memory_node : memory_nodes_) {
+            MembenchCell cell{-1.0, -1.0, -1.0, true, false};
+            std::cout << "⏱️  CPU node " << cpu_node << " → memory node " << memory_node << "..." << std::flush;
+
+            if (config_.run_latency) {
+                // Chase from one CPU: idle latency, no other traffic from this tool
+                pinToCpus({cpus.front()});
+                cell.latency_ns = measureLatency(memory_node, cell);
+            }
+            if (config_.run_bandwidth) {
+                measureBandwidth(cpu_node, memory_node, cell);
+            }
+            cells_[{cpu_node, memory_node}] = cell;
+            std::cout << "\r\033[K" << std::flush;
+        }
+    }
+
+    sched_setaffinity(0, sizeof(original), &original);
+    return !cells_.empty();
+}
+
+void* MemoryBenchmark::allocateOnNode(size_t bytes, int node, bool& bound, bool& huge, size_t& mapped) {
+    mapped = (bytes + kHugePage - 1) / kHugePage * kHugePage;
+
+    // Reserved hugetlbfs pages first, but only when this node's own pool can
+    // back the whole buffer: the reservation is global, so a short node pool
+    // would pass mmap and then SIGBUS on first touch under MPOL_BIND.
+    // Binding the task first makes the reservation count this node's pages.
+    void* memory = MAP_FAILED;
+    if (freeHugePagesOnNode(node) >= mapped / kHugePage && setMempolicyNode(node) == 0) {
+        memory = mmap(nullptr, mapped, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | kMapHuge2MB, -1, 0);
+        setMempolicyNode(-1);
+    }
+    huge = memory != MAP_FAILED;
+    if (!huge) {
+        memory = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            return nullptr;
+        }
+        // Only a hint: THP may be "never", or the fault path may fall back to 4 KB
+        madvise(memory, mapped, MADV_HUGEPAGE);
+    }
+
+    // mbind before first touch; without it, bind the touching thread instead
+    bool policy_set = mbindNode(memory, mapped, node) == 0;
+    if (!policy_set) {
+        policy_set = setMempolicyNode(node) == 0;
+    }
+    memset(memory, 0, mapped);
+    setMempolicyNode(-1);
+
+    // Count THP backing only when the kernel actually supplied most of it
+    if (!huge) {
+        huge = anonHugeBytes(memory) * 2 >= mapped;
+    }
+
+    bound = policy_set && nodeOfAddress(memory) == node;
+    return memory;
+}
+
+bool MemoryBenchmark::pinToCpus(const std::vector<int>& cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+double MemoryBenchmark::measureLatency(int memory_node, MembenchCell& cell) {
+    size_t mapped = 0;
+    bool bound = false, huge = false;
+    char* buffer = static_cast<char*>(allocateOnNode(config_.latency_mb << 20, memory_node, bound, huge, mapped));
+    if (!buffer) {
+        return -1.0;
+    }
+    cell.bound = cell.bound && bound;
+    cell.huge_pages = huge;
+
+    // One pointer per cache line, linked in random order so the prefetchers cannot follow
+    size_t lines = mapped / kCacheLine;
+    std::vector<size_t> order(lines);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin() + 1, order.end(), std::mt19937_64(42));
+    for (size_t i = 0; i < lines; i++) {
+        *reinterpret_cast<void**>(buffer + order[i] * kCacheLine) = buffer + order[(i + 1) % lines] * kCacheLine;
+    }
+
+    // One full lap warms the TLB, then time a fixed number of dependent loads
+    void* p = buffer;
+    for (size_t i = 0; i < lines; i++) p = *static_cast<void**>(p);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kLatencyLoads; i += 8) {
+        p = *static_cast<void**>(p); p = *static_cast<void**>(p);
+        p = *static_cast<void**>(p); p = *static_cast<void**>(p);
+        p = *static_cast<void**>(p); p = *static_cast<void**>(p);
+        p = *static_cast<void**>(p); p = *static_cast<void**>(p);
+    }
+    double elapsed = secondsSince(start);
+
+    // Keep the chain live so the loop is not optimised away
+    volatile void* sink = p;
+    (void)sink;
+    munmap(buffer, mapped);
+    return elapsed * 1e9 / kLatencyLoads;
+}
+
+void MemoryBenchmark::measureBandwidth(int cpu_node, int memory_node, MembenchCell& cell) {
+    std::vector<int> cpus = Topology::instance().getNodeCpus(cpu_node);
+    if (cpus.empty()) cpus = Topology::instance().getOnlineCpus();
+    if (config_.threads > 0 && (size_t)config_.threads < cpus.size()) cpus.resize(config_.threads);
+
+    size_t bytes = config_.bandwidth_mb << 20;
+    size_t mapped[3];
+    bool bound[3], huge;
+    double* arrays[3];
+    for (int i = 0; i < 3; i++) {
+        arrays[i] = static_cast<double*>(allocateOnNode(bytes, memory_node, bound[i], huge, mapped[i]));
+    }
+    if (arrays[0] && arrays[1] && arrays[2]) {
+        double* a = arrays[0];
+        double* b = arrays[1];
+        double* c = arrays[2];
+        size_t count = bytes / sizeof(double);
+        std::fill(a, a + count, 1.0);
+        std::fill(b, b + count, 2.0);
+        std::fill(c, c + count, 0.0);
+        cell.bound = cell.bound && bound[0] && bound[1] && bound[2];
+
+        // Each pinned thread streams its own slice; best of N repetitions.
+        // Threads are created and pinned before the clock starts and released
+        // together, and the run ends when the slowest one finishes its slice
+        auto kernel = [&](bool triad) {
+            std::vector<std::thread> workers;
+            std::vector<std::chrono::steady_clock::time_point> finished(cpus.size());
+            std::atomic<size_t> ready{0};
+            std::atomic<bool> go{false};
+            size_t slice = count / cpus.size();
+            for (size_t t = 0; t < cpus.size(); t++) {
+                workers.emplace_back([&, t]() {
+                    pinToCpus({cpus[t]});
+                    ready.fetch_add(1, std::memory_order_release);
+                    while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+                    size_t begin = t * slice;
+                    size_t end = t + 1 == cpus.size() ? count : begin + slice;
+                    if (triad) {
+                        for (size_t i = begin; i < end; i++) a[i] = b[i] + 3.0 * c[i];
+                    } else {
+                        for (size_t i = begin; i < end; i++) c[i] = a[i];
+                    }
+                    finished[t] = std::chrono::steady_clock::now();
+                });
+            }
+            while (ready.load(std::memory_order_acquire) < cpus.size()) std::this_thread::yield();
+            auto start = std::chrono::steady_clock::now();
+            go.store(true, std::memory_order_release);
+            for (auto& worker : workers) worker.join();
+            return std::chrono::duration<double>(*std::max_element(finished.begin(), finished.end()) - start).count();
+        };
+
+        double best_copy = 0.0, best_triad = 0.0;
+        for (int rep = 0; rep < config_.repetitions; rep++) {
+            double copy = kernel(false);
+            double triad = kernel(true);
+            if (best_copy == 0.0 || copy < best_copy) best_copy = copy;
+            if (best_triad == 0.0 || triad < best_triad) best_triad = triad;
+        }
+        // STREAM counting: copy moves 2 arrays, triad 3 (write-allocate not included)
+        cell.copy_gbs = best_copy > 0.0 ? 2.0 * bytes / best_copy / 1e9 : -1.0;
+        cell.triad_gbs = best_triad > 0.0 ? 3.0 * bytes / best_triad / 1e9 : -1.0;
+    }
+    for (int i = 0; i < 3; i++) {
+        if (arrays[i]) munmap(arrays[i], mapped[i]);
+    }
+}
+
+const MembenchCell* MemoryBenchmark::getCell(int cpu_node, int memory_node) const {
+    auto it = cells_.find({cpu_node, memory_node});
+    return it != cells_.end() ? &it->second : nullptr;
+}
+
+void MemoryBenchmark::printTable(const std::string& title, double MembenchCell::*field, int precision) const {
+    std::cout << "\n" << title << " (rows: CPU node, columns: memory node)" << std::endl;
+    std::cout << std::left << std::setw(8) << "CPU\\MEM";
+    for (int memory_node : memory_nodes_) {
+        std::cout << std::right << std::setw(10) << ("node" + std::to_string(memory_node));
+    }
+    std::cout << std::endl;
+
+    for (int cpu_node : cpu_nodes_) {
+        std::cout << std::left << std::setw(8) << ("node" + std::to_string(cpu_node)) << std::right;
+        for (int memory_node : memory_nodes_) {
+            const MembenchCell* cell = getCell(cpu_node, memory_node);
+            if (!cell || cell->*field < 0.0) {
+                std::cout << std::setw(10) << "-";
+                continue;
+            }
+            std::ostringstream value;
+            value << std::fixed << std::setprecision(precision) << cell->*field << (cell->bound ? "" : "*");
+            std::cout << std::setw(10) << value.str();
+        }
+        std::cout << std::endl;
+    }
+}
+
+void MemoryBenchmark::printMatrix() const {
+    std::cout << "\n🧪 NUMA MEMORY BENCHMARK" << std::endl;
+    std::cout << "─────────────────────────────────────────────────────────────────────" << std::endl;
+    std::cout << "CPU nodes: " << cpu_nodes_.size() << " | Memory nodes: " << memory_nodes_.size()
+              << " | Latency buffer: " << config_.latency_mb << " MB"
+              << " | STREAM arrays: 3 x " << config_.bandwidth_mb << " MB" << std::endl;
+
+    if (config_.run_latency) {
+        printTable("Idle latency (ns)", &MembenchCell::latency_ns, 1);
+    }
+    if (config_.run_bandwidth) {
+        printTable("Copy bandwidth (GB/s)", &MembenchCell::copy_gbs, 1);
+        printTable("Triad bandwidth (GB/s)", &MembenchCell::triad_gbs, 1);
+    }
+
+    bool any_unbound = std::any_of(cells_.begin(), cells_.end(), [](const auto& entry) { return !entry.second.bound; });
+    bool any_small_pages = std::any_of(cells_.begin(), cells_.end(), [](const auto& entry) {
+        return entry.second.latency_ns >= 0.0 && !entry.second.huge_pages;
+    });
+    if (any_unbound) {
+        std::cout << "* placement not confirmed on the target node (mbind/set_mempolicy refused or no NUMA)" << std::endl;
+    }
+    if (any_small_pages) {
+        std::cout << "Latency measured on 4 KB pages (no hugetlbfs or THP) - includes page-walk cost" << std::endl;
+    }
+}
+
+void MemoryBenchmark::printAssessment() const {
+    std::cout << "\n📋 ASSESSMENT" << std::endl;
+    const Topology& topology = Topology::instance();
+
+    if (topology.getSocketCount() > 1 && memory_nodes_.size() == 1) {
+        std::cout << "🔴 " << topology.getSocketCount() << " sockets but a single memory node"
+                  << " - BIOS node interleaving is likely enabled" << std::endl;
+        std::cout << "   → Solution: Disable memory/node interleaving in firmware to expose NUMA" << std::endl;
+        return;
+    }
+    if (cpu_nodes_.size() < 2) {
+        std::cout << "✅ Single NUMA node - no cross-node paths to compare" << std::endl;
+        return;
+    }
+    if (!config_.run_latency) {
+        printBandwidthAssessment();
+        return;
+    }
+
+    // Compare each row's remote latencies with its local one
+    bool healthy = true;
+    for (int cpu_node : cpu_nodes_) {
+        const MembenchCell* local = getCell(cpu_node, cpu_node);
+        if (!local || local->latency_ns <= 0.0) continue;
+        for (int memory_node : memory_nodes_) {
+            const MembenchCell* remote = getCell(cpu_node, memory_node);
+            if (memory_node == cpu_node || !remote || remote->latency_ns <= 0.0) continue;
+            double ratio = remote->latency_ns / local->latency_ns;
+            if (ratio < kUniformLatencyRatio) {
+                healthy = false;
+                std::cout << "🟡 node" << cpu_node << " → node" << memory_node << " latency is only "
+                          << std::fixed << std::setprecision(2) << ratio
+                          << "x local - memory may be interleaved across nodes" << std::endl;
+            }
+        }
+    }
+    if (healthy) {
+        std::cout << "✅ Remote latency exceeds local on every node pair - NUMA layout looks intact" << std::endl;
+    }
+}
+
+void MemoryBenchmark::printBandwidthAssessment() const {
+    // Without latencies, compare each row's remote triad bandwidth with its local one
+    bool healthy = true;
+    for (int cpu_node : cpu_nodes_) {
+        const MembenchCell* local = getCell(cpu_node, cpu_node);
+        if (!local || local->triad_gbs <= 0.0) continue;
+        for (int memory_node : memory_nodes_) {
+            const MembenchCell* remote = getCell(cpu_node, memory_node);
+            if (memory_node == cpu_node || !remote || remote->triad_gbs <= 0.0) continue;
+            double ratio = remote->triad_gbs / local->triad_gbs;
+            if (ratio > kUniformBandwidthRatio) {
+                healthy = false;
+                std::cout << "🟡 node" << cpu_node << " → node" << memory_node << " triad bandwidth is "
+                          << std::fixed << std::setprecision(2) << ratio
+                          << "x local - memory may be interleaved across nodes" << std::endl;
+            }
+        }
+    }
+    if (healthy) {
+        std::cout << "✅ Remote bandwidth trails local on every node pair - NUMA layout looks intact" << std::endl;
+    }
+}
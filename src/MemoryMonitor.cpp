@@ -3,7 +3,7 @@
 #include <sstream>
 #include <iomanip>
 
-MemoryMonitor::MemoryMonitor() {
+MemoryMonitor::MemoryMonitor() : current_{} {
     // Open /proc/meminfo for reading
     meminfo_file_.open("/proc/meminfo");
     if (!meminfo_file_.is_open()) {
@@ -52,6 +52,10 @@ bool MemoryMonitor::parseProcMeminfo() {
             current_.cached = std::stoul(value);
         } else if (key == "SwapCached:") {
             current_.swap_cached = std::stoul(value);
+        } else if (key == "SwapTotal:") {
+            current_.swap_total = std::stoul(value);
+        } else if (key == "SwapFree:") {
+            current_.swap_free = std::stoul(value);
         } else if (key == "Active:") {
             current_.active = std::stoul(value);
         } else if (key == "Inactive:") {
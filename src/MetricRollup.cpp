@@ -0,0 +1,179 @@
+#include "MetricRollup.h"
+#include "QuantileSketch.h"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace {
+
+// Relative accuracy a, shared bin layout with QuantileSketch
+const double kRelativeAccuracy = 0.02;
+const LogarithmicMapping kMapping(kRelativeAccuracy);
+const double kMinIndexable = 1e-9;
+
+const int64_t kTierWidthMs[ROLLUP_TIER_COUNT] = {10 * 1000, 60 * 1000, 600 * 1000};
+const size_t kTierRetention[ROLLUP_TIER_COUNT] = {360, 360, 144};    // 1 h, 6 h, 24 h
+const char* const kTierNames[ROLLUP_TIER_COUNT] = {"10s", "1m", "10m"};
+
+} // namespace
+
+void WindowSketch::add(double value) {
+    count_++;
+    if (!(value > kMinIndexable)) {
+        zero_count_++;
+        return;
+    }
+    insert(kMapping.key(value), 1);
+}
+
+void WindowSketch::insert(int32_t key, uint32_t count) {
+    auto it = std::lower_bound(bins_.begin(), bins_.end(), key,
+                               [](const Bin& bin, int32_t k) { return bin.key < k; });
+    if (it != bins_.end() && it->key == key) {
+        it->count += count;
+        return;
+    }
+    bins_.insert(it, Bin{key, count});
+    collapse();
+}
+
+void WindowSketch::merge(const WindowSketch& other) {
+    std::vector<Bin> merged;
+    merged.reserve(bins_.size() + other.bins_.size());
+    auto a = bins_.begin();
+    auto b = other.bins_.begin();
+    while (a != bins_.end() || b != other.bins_.end()) {
+        if (b == other.bins_.end() || (a != bins_.end() && a->key < b->key)) {
+            merged.push_back(*a++);
+        } else if (a == bins_.end() || b->key < a->key) {
+            merged.push_back(*b++);
+        } else {
+            merged.push_back(Bin{a->key, a->count + b->count});
+            ++a;
+            ++b;
+        }
+    }
+    bins_.swap(merged);
+    zero_count_ += other.zero_count_;
+    count_ += other.count_;
+    collapse();
+}
+
+void WindowSketch::collapse() {
+    if (bins_.size() <= kMaxBins) {
+        return;
+    }
+    size_t excess = bins_.size() - kMaxBins;
+    for (size_t i = 0; i < excess; i++) {
+        bins_[excess].count += bins_[i].count;
+    }
+    bins_.erase(bins_.begin(), bins_.begin() + excess);
+}
+
+double WindowSketch::quantile(double q) const {
+    if (count_ == 0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    double rank = std::clamp(q, 0.0, 1.0) * (count_ - 1);
+    uint64_t cumulative = zero_count_;
+    if (rank < cumulative) {
+        return 0.0;
+    }
+    for (const Bin& bin : bins_) {
+        cumulative += bin.count;
+        if (rank < cumulative) {
+            return kMapping.value(bin.key);
+        }
+    }
+    return kMapping.value(bins_.back().key);
+}
+
+double RollupWindow::mean() const {
+    return count > 0 ? sum / count : 0.0;
+}
+
+double RollupWindow::quantile(double q) const {
+    return std::clamp(sketch.quantile(q), min, max);
+}
+
+void RollupWindow::merge(const RollupWindow& other) {
+    if (other.count == 0) {
+        return;
+    }
+    min = count > 0 ? std::min(min, other.min) : other.min;
+    max = count > 0 ? std::max(max, other.max) : other.max;
+    sum += other.sum;
+    count += other.count;
+    sketch.merge(other.sketch);
+}
+
+void MetricRollup::add(int64_t timestamp_ms, double value) {
+    for (int tier = 0; tier < ROLLUP_TIER_COUNT; tier++) {
+        std::deque<RollupWindow>& windows = tiers_[tier];
+        int64_t width = kTierWidthMs[tier];
+        int64_t start = timestamp_ms - ((timestamp_ms % width) + width) % width;
+
+        if (windows.empty() || windows.back().start_ms < start) {
+            if (!windows.empty()) {
+                windows.back().sketch.shrink();   // Closed: drop the growth slack
+            }
+            windows.push_back(RollupWindow{start, value, value, 0.0, 0, WindowSketch()});
+            while (windows.size() > kTierRetention[tier]) {
+                windows.pop_front();
+            }
+        } else if (windows.back().start_ms > start) {
+            continue;                              // Older than the open window
+        }
+
+        RollupWindow& window = windows.back();
+        window.min = std::min(window.min, value);
+        window.max = std::max(window.max, value);
+        window.sum += value;
+        window.count++;
+        window.sketch.add(value);
+    }
+}
+
+size_t MetricRollup::windows(RollupTier tier, int64_t from_ms, int64_t to_ms, std::vector<RollupWindow>& out) const {
+    const std::deque<RollupWindow>& windows = tiers_[tier];
+    auto it = std::lower_bound(windows.begin(), windows.end(), from_ms,
+                               [](const RollupWindow& window, int64_t ms) { return window.start_ms < ms; });
+    size_t before = out.size();
+    for (; it != windows.end() && it->start_ms <= to_ms; ++it) {
+        out.push_back(*it);
+    }
+    return out.size() - before;
+}
+
+bool MetricRollup::summarize(RollupTier tier, int64_t from_ms, int64_t to_ms, RollupWindow& out) const {
+    const std::deque<RollupWindow>& windows = tiers_[tier];
+    auto it = std::lower_bound(windows.begin(), windows.end(), from_ms,
+                               [](const RollupWindow& window, int64_t ms) { return window.start_ms < ms; });
+    out = RollupWindow{from_ms, 0.0, 0.0, 0.0, 0, WindowSketch()};
+    for (; it != windows.end() && it->start_ms <= to_ms; ++it) {
+        out.merge(*it);
+    }
+    return out.count > 0;
+}
+
+size_t MetricRollup::bytes() const {
+    size_t total = 0;
+    for (const auto& windows : tiers_) {
+        for (const auto& window : windows) {
+            total += sizeof(RollupWindow) + window.sketch.bytes();
+        }
+    }
+    return total;
+}
+
+int64_t MetricRollup::tierWidthMs(RollupTier tier) {
+    return kTierWidthMs[tier];
+}
+
+size_t MetricRollup::tierRetention(RollupTier tier) {
+    return kTierRetention[tier];
+}
+
+const char* MetricRollup::tierName(RollupTier tier) {
+    return kTierNames[tier];
+}
@@ -0,0 +1,397 @@
+#include "MetricStore.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+// Worst case per sample: '1111' + 64-bit delta-of-delta, '11' + 5 + 6 + 64 value bits
+const uint32_t kMaxSampleBits = 4 + 64 + 2 + 5 + 6 + 64;
+
+void writeBits(uint64_t* words, uint32_t& position, uint64_t value, int count) {
+    // MSB-first; count is 1..64
+    if (count < 64) {
+        value &= (1ULL << count) - 1;
+    }
+    uint32_t word = position / 64;
+    int offset = position % 64;
+    int room = 64 - offset;
+    if (count <= room) {
+        words[word] |= value << (room - count);
+    } else {
+        words[word] |= value >> (count - room);
+        words[word + 1] |= value << (64 - (count - room));
+    }
+    position += count;
+}
+
+uint64_t readBits(const uint64_t* words, uint32_t& position, int count) {
+    uint32_t word = position / 64;
+    int offset = position % 64;
+    int room = 64 - offset;
+    uint64_t value;
+    if (count <= room) {
+        value = words[word] >> (room - count);
+    } else {
+        value = (words[word] << (count - room)) | (words[word + 1] >> (64 - (count - room)));
+    }
+    position += count;
+    return count < 64 ? value & ((1ULL << count) - 1) : value;
+}
+
+int64_t signExtend(uint64_t value, int bits) {
+    uint64_t sign = 1ULL << (bits - 1);
+    return static_cast<int64_t>((value ^ sign) - sign);
+}
+
+uint64_t toBits(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double fromBits(uint64_t bits) {
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+} // namespace
+
+MetricStore& MetricStore::instance() {
+    static MetricStore store;
+    return store;
+}
+
+MetricStore::MetricStore(int64_t resolution_ms, int64_t retention_ms)
+    : resolution_ms_(std::max<int64_t>(1, resolution_ms)),
+      retention_ticks_(retention_ms / std::max<int64_t>(1, resolution_ms)) {
+    static_assert(sizeof(Block) == kBlockBytes, "Block must fill exactly one arena slot");
+}
+
+MetricStore::~MetricStore() = default;
+
+int64_t MetricStore::nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+MetricStore::Block* MetricStore::Arena::allocate() {
+    Block* block;
+    if (free_) {
+        block = free_;
+        free_ = free_->next;
+    } else {
+        if (used_in_chunk_ == kChunkBlocks) {
+            chunks_.emplace_back(new Block[kChunkBlocks]);
+            used_in_chunk_ = 0;
+        }
+        block = &chunks_.back()[used_in_chunk_++];
+    }
+    memset(block, 0, sizeof(Block));
+    return block;
+}
+
+void MetricStore::Arena::release(Block* block) {
+    block->next = free_;
+    free_ = block;
+}
+
+SeriesId MetricStore::series(const std::string& name, int precision_bits) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(name);
+    if (it != index_.end()) {
+        return it->second;
+    }
+    Series series{name, precision_bits, nullptr, nullptr, 0, 0, 0, 0, 0, -1, MetricRollup()};
+    series_.push_back(std::move(series));
+    SeriesId id = static_cast<SeriesId>(series_.size() - 1);
+    index_[name] = id;
+    return id;
+}
+
+bool MetricStore::append(SeriesId id, double value) {
+    return append(id, nowMs(), value);
+}
+
+bool MetricStore::append(SeriesId id, int64_t timestamp_ms, double value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (id >= series_.size() || std::isnan(value)) {
+        return false;
+    }
+    Series& series = series_[id];
+
+    // Truncate to the resolution so steady sampling gives a delta-of-delta of 0 (one bit)
+    int64_t tick = timestamp_ms / resolution_ms_;
+    if (series.tail && tick < series.previous_tick) {
+        return false;
+    }
+    if (series.precision_bits != kLossless) {
+        value = std::ldexp(std::nearbyint(std::ldexp(value, series.precision_bits)), -series.precision_bits);
+    }
+    uint64_t value_bits = toBits(value);
+
+    if (!series.tail || series.tail->bit_length + kMaxSampleBits > kPayloadBits) {
+        startBlock(series, tick, value_bits, value);
+    } else {
+        encode(series, tick, value_bits);
+        Block& block = *series.tail;
+        block.count++;
+        block.last_tick = tick;
+        block.min = std::min(block.min, value);
+        block.max = std::max(block.max, value);
+    }
+    expire(series, tick);
+    series.rollup.add(tick * resolution_ms_, value);
+    return true;
+}
+
+void MetricStore::startBlock(Series& series, int64_t tick, uint64_t value_bits, double value) {
+    Block* block = arena_.allocate();
+    block->first_tick = block->last_tick = tick;
+    block->min = block->max = value;
+    block->count = 1;
+    writeBits(block->bits, block->bit_length, value_bits, 64);   // First value raw, time in the header
+
+    if (series.tail) {
+        series.tail->next = block;
+    } else {
+        series.head = block;
+    }
+    series.tail = block;
+    series.blocks++;
+    series.previous_tick = tick;
+    series.previous_delta = 0;
+    series.previous_bits = value_bits;
+    series.previous_trailing = -1;
+}
+
+void MetricStore::encode(Series& series, int64_t tick, uint64_t value_bits) {
+    Block& block = *series.tail;
+
+    // Timestamp: delta-of-delta in buckets of 1, 9, 12, 16 and 68 bits
+    int64_t delta = tick - series.previous_tick;
+    int64_t dod = delta - series.previous_delta;
+    if (dod == 0) {
+        writeBits(block.bits, block.bit_length, 0b0, 1);
+    } else if (dod >= -64 && dod <= 63) {
+        writeBits(block.bits, block.bit_length, 0b10, 2);
+        writeBits(block.bits, block.bit_length, static_cast<uint64_t>(dod), 7);
+    } else if (dod >= -256 && dod <= 255) {
+        writeBits(block.bits, block.bit_length, 0b110, 3);
+        writeBits(block.bits, block.bit_length, static_cast<uint64_t>(dod), 9);
+    } else if (dod >= -2048 && dod <= 2047) {
+        writeBits(block.bits, block.bit_length, 0b1110, 4);
+        writeBits(block.bits, block.bit_length, static_cast<uint64_t>(dod), 12);
+    } else {
+        writeBits(block.bits, block.bit_length, 0b1111, 4);
+        writeBits(block.bits, block.bit_length, static_cast<uint64_t>(dod), 64);
+    }
+    series.previous_delta = delta;
+    series.previous_tick = tick;
+
+    // Value: XOR with the previous value; reuse the last leading/trailing window when it fits
+    uint64_t x = value_bits ^ series.previous_bits;
+    series.previous_bits = value_bits;
+    if (x == 0) {
+        writeBits(block.bits, block.bit_length, 0b0, 1);
+        return;
+    }
+    int leading = std::min(__builtin_clzll(x), 31);
+    int trailing = __builtin_ctzll(x);
+    if (series.previous_trailing >= 0 && leading >= series.previous_leading && trailing >= series.previous_trailing) {
+        int meaningful = 64 - series.previous_leading - series.previous_trailing;
+        writeBits(block.bits, block.bit_length, 0b10, 2);
+        writeBits(block.bits, block.bit_length, x >> series.previous_trailing, meaningful);
+    } else {
+        int meaningful = 64 - leading - trailing;
+        writeBits(block.bits, block.bit_length, 0b11, 2);
+        writeBits(block.bits, block.bit_length, leading, 5);
+        writeBits(block.bits, block.bit_length, meaningful & 63, 6);   // 64 is stored as 0
+        writeBits(block.bits, block.bit_length, x >> trailing, meaningful);
+        series.previous_leading = leading;
+        series.previous_trailing = trailing;
+    }
+}
+
+void MetricStore::expire(Series& series, int64_t now_tick) {
+    // Whole blocks only: the head goes once its newest sample is past retention
+    while (series.head != series.tail && series.head->last_tick < now_tick - retention_ticks_) {
+        Block* expired = series.head;
+        series.head = expired->next;
+        arena_.release(expired);
+        series.blocks--;
+    }
+}
+
+template <typename Visitor>
+void MetricStore::decodeBlock(const Block& block, Visitor&& visit) const {
+    uint32_t position = 0;
+    int64_t tick = block.first_tick;
+    int64_t delta = 0;
+    uint64_t value_bits = readBits(block.bits, position, 64);
+    int leading = 0, trailing = 0;
+    visit(tick * resolution_ms_, fromBits(value_bits));
+
+    for (uint32_t i = 1; i < block.count; i++) {
+        int64_t dod;
+        if (readBits(block.bits, position, 1) == 0) {
+            dod = 0;
+        } else if (readBits(block.bits, position, 1) == 0) {
+            dod = signExtend(readBits(block.bits, position, 7), 7);
+        } else if (readBits(block.bits, position, 1) == 0) {
+            dod = signExtend(readBits(block.bits, position, 9), 9);
+        } else if (readBits(block.bits, position, 1) == 0) {
+            dod = signExtend(readBits(block.bits, position, 12), 12);
+        } else {
+            dod = static_cast<int64_t>(readBits(block.bits, position, 64));
+        }
+        delta += dod;
+        tick += delta;
+
+        if (readBits(block.bits, position, 1) == 1) {
+            if (readBits(block.bits, position, 1) == 1) {
+                leading = static_cast<int>(readBits(block.bits, position, 5));
+                int meaningful = static_cast<int>(readBits(block.bits, position, 6));
+                if (meaningful == 0) meaningful = 64;
+                trailing = 64 - leading - meaningful;
+            }
+            int meaningful = 64 - leading - trailing;
+            value_bits ^= readBits(block.bits, position, meaningful) << trailing;
+        }
+        visit(tick * resolution_ms_, fromBits(value_bits));
+    }
+}
+
+size_t MetricStore::query(SeriesId id, int64_t from_ms, int64_t to_ms, std::vector<MetricSample>& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (id >= series_.size()) {
+        return 0;
+    }
+    size_t before = out.size();
+    for (const Block* block = series_[id].head; block; block = block->next) {
+        if (block->last_tick * resolution_ms_ < from_ms) continue;
+        if (block->first_tick * resolution_ms_ > to_ms) break;
+        decodeBlock(*block, [&](int64_t timestamp, double value) {
+            if (timestamp >= from_ms && timestamp <= to_ms) {
+                out.push_back(MetricSample{timestamp, value});
+            }
+        });
+    }
+    return out.size() - before;
+}
+
+void MetricStore::downsample(SeriesId id, int64_t from_ms, int64_t to_ms, size_t buckets, std::vector<double>& out) const {
+    out.assign(buckets, std::numeric_limits<double>::quiet_NaN());
+    if (buckets == 0 || to_ms <= from_ms) {
+        return;
+    }
+    std::vector<double> sums(buckets, 0.0);
+    std::vector<size_t> counts(buckets, 0);
+    double width = static_cast<double>(to_ms - from_ms) / buckets;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (id >= series_.size()) {
+        return;
+    }
+    for (const Block* block = series_[id].head; block; block = block->next) {
+        if (block->last_tick * resolution_ms_ < from_ms) continue;
+        if (block->first_tick * resolution_ms_ > to_ms) break;
+        decodeBlock(*block, [&](int64_t timestamp, double value) {
+            if (timestamp < from_ms || timestamp > to_ms) return;
+            size_t bucket = std::min(buckets - 1, static_cast<size_t>((timestamp - from_ms) / width));
+            sums[bucket] += value;
+            counts[bucket]++;
+        });
+    }
+    for (size_t i = 0; i < buckets; i++) {
+        if (counts[i] > 0) out[i] = sums[i] / counts[i];
+    }
+}
+
+bool MetricStore::latest(SeriesId id, MetricSample& sample) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (id >= series_.size() || !series_[id].tail) {
+        return false;
+    }
+    const Series& series = series_[id];
+    sample.timestamp_ms = series.previous_tick * resolution_ms_;
+    sample.value = fromBits(series.previous_bits);
+    return true;
+}
+
+bool MetricStore::range(SeriesId id, int64_t from_ms, int64_t to_ms, double& min, double& max) const {
+    // Block min/max only: may widen the range by the samples of edge blocks
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (id >= series_.size()) {
+        return false;
+    }
+    bool found = false;
+    for (const Block* block = series_[id].head; block; block = block->next) {
+        if (block->last_tick * resolution_ms_ < from_ms) continue;
+        if (block->first_tick * resolution_ms_ > to_ms) break;
+        min = found ? std::min(min, block->min) : block->min;
+        max = found ? std::max(max, block->max) : block->max;
+        found = true;
+    }
+    return found;
+}
+
+size_t MetricStore::rollups(SeriesId id, RollupTier tier, int64_t from_ms, int64_t to_ms,
+                            std::vector<RollupWindow>& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (id >= series_.size()) {
+        return 0;
+    }
+    return series_[id].rollup.windows(tier, from_ms, to_ms, out);
+}
+
+bool MetricStore::summarize(SeriesId id, RollupTier tier, int64_t from_ms, int64_t to_ms, RollupWindow& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (id >= series_.size()) {
+        return false;
+    }
+    return series_[id].rollup.summarize(tier, from_ms, to_ms, out);
+}
+
+std::vector<SeriesInfo> MetricStore::getSeriesInfo() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<SeriesInfo> info;
+    const size_t header_bytes = sizeof(Block) - sizeof(Block::bits);
+    for (const auto& series : series_) {
+        SeriesInfo entry{series.name, 0, series.blocks, 0, 0.0, 0, 0};
+        for (const Block* block = series.head; block; block = block->next) {
+            entry.samples += block->count;
+            entry.compressed_bytes += header_bytes + (block->bit_length + 7) / 8;
+        }
+        if (series.head) {
+            entry.first_ms = series.head->first_tick * resolution_ms_;
+            entry.last_ms = series.tail->last_tick * resolution_ms_;
+        }
+        entry.bytes_per_sample = entry.samples > 0 ? static_cast<double>(entry.compressed_bytes) / entry.samples : 0.0;
+        info.push_back(entry);
+    }
+    return info;
+}
+
+size_t MetricStore::getSeriesCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return series_.size();
+}
+
+size_t MetricStore::getArenaBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return arena_.bytes();
+}
+
+size_t MetricStore::getRollupBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t bytes = 0;
+    for (const auto& series : series_) {
+        bytes += series.rollup.bytes();
+    }
+    return bytes;
+}
@@ -1,13 +1,58 @@
 #include "NumaMonitor.h"
+#include "PressureMonitor.h"
+#include "Topology.h"
+#include "ProcessMonitor.h"
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 #include <filesystem>
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
 
-NumaMonitor::NumaMonitor() : first_reading_(true) {
-    vmstat_file_.open("/proc/vmstat");
-    if (!vmstat_file_.is_open()) {
+namespace {
+
+// numa_maps of a large process runs to tens of thousands of lines
+const std::chrono::milliseconds kPlacementBudget(50);
+
+// VmstatCounters fields filled from the dense /proc/vmstat array
+struct VmstatField {
+    const char* key;
+    unsigned long VmstatCounters::*field;
+};
+
+const VmstatField kVmstatFields[] = {
+    {"pgfault",                &VmstatCounters::pgfault},
+    {"pgmajfault",             &VmstatCounters::pgmajfault},
+    {"pgpgin",                 &VmstatCounters::pgpgin},
+    {"pgpgout",                &VmstatCounters::pgpgout},
+    {"pswpin",                 &VmstatCounters::pswpin},
+    {"pswpout",                &VmstatCounters::pswpout},
+    {"pgsteal",                &VmstatCounters::pgsteal},
+    {"pgscan_kswapd",          &VmstatCounters::pgscan_kswapd},
+    {"pgscan_direct",          &VmstatCounters::pgscan_direct},
+    {"nr_dirty",               &VmstatCounters::nr_dirty},
+    {"nr_writeback",           &VmstatCounters::nr_writeback},
+    {"nr_unstable",            &VmstatCounters::nr_unstable},
+    {"nr_slab_reclaimable",    &VmstatCounters::nr_slab_reclaimable},
+    {"nr_slab_unreclaimable",  &VmstatCounters::nr_slab_unreclaimable},
+    {"numa_pages_migrated",    &VmstatCounters::numa_pages_migrated},
+    {"numa_hint_faults",       &VmstatCounters::numa_hint_faults},
+    {"numa_hint_faults_local", &VmstatCounters::numa_hint_faults_local},
+};
+
+} // namespace
+
+NumaMonitor::NumaMonitor() : vmstat_buffer_(16384), vmstat_length_(0),
+                             current_vmstat_{}, previous_vmstat_{}, first_reading_(true),
+                             psi_some_total_(0), psi_full_total_(0),
+                             process_monitor_(nullptr), placement_top_n_(5) {
+    last_update_ = std::chrono::steady_clock::now();
+    vmstat_fd_ = open("/proc/vmstat", O_RDONLY | O_CLOEXEC);
+    if (vmstat_fd_ < 0) {
         std::cerr << "Failed to open /proc/vmstat" << std::endl;
     }
     
@@ -15,23 +60,36 @@ NumaMonitor::NumaMonitor() : first_reading_(true) {
     discoverNumaTopology();
 }
 
+NumaMonitor::~NumaMonitor() {
+    if (vmstat_fd_ >= 0) {
+        close(vmstat_fd_);
+    }
+}
+
 bool NumaMonitor::update() {
-    if (!vmstat_file_.is_open()) {
+    if (vmstat_fd_ < 0) {
         return false;
     }
     
+    auto now = std::chrono::steady_clock::now();
+    double interval = first_reading_ ? 0.0 : std::chrono::duration<double>(now - last_numastat_).count();
+    last_numastat_ = now;
+    
     // Store previous reading
     previous_vmstat_ = current_vmstat_;
     
     // Parse vmstat
-    if (!parseVmstat()) {
+    if (!parseVmstat(interval)) {
         return false;
     }
     
     // Update NUMA node information
     for (auto& [node_id, node] : numa_nodes_) {
         parseNumaNode(node_id);
+        parseNumaStat(node, interval);
     }
+    calculateBalancingRates(interval);
+    updateProcessPlacement();
     
     // Calculate memory pressure (skip first reading)
     if (!first_reading_) {
@@ -44,48 +102,29 @@ bool NumaMonitor::update() {
     return true;
 }
 
-bool NumaMonitor::parseVmstat() {
+bool NumaMonitor::parseVmstat(double interval_seconds) {
 #ifdef __linux__
-    vmstat_file_.seekg(0);
-    vmstat_file_.clear();
+    if (!readVmstatFile()) {
+        return false;
+    }
     
-    std::string line;
-    while (std::getline(vmstat_file_, line)) {
-        if (line.empty()) continue;
-        
-        std::istringstream iss(line);
-        std::string key, value;
-        iss >> key >> value;
-        
-        // Parse key vmstat metrics
-        if (key == "pgfault") {
-            current_vmstat_.pgfault = std::stoul(value);
-        } else if (key == "pgmajfault") {
-            current_vmstat_.pgmajfault = std::stoul(value);
-        } else if (key == "pgpgin") {
-            current_vmstat_.pgpgin = std::stoul(value);
-        } else if (key == "pgpgout") {
-            current_vmstat_.pgpgout = std::stoul(value);
-        } else if (key == "pswpin") {
-            current_vmstat_.pswpin = std::stoul(value);
-        } else if (key == "pswpout") {
-            current_vmstat_.pswpout = std::stoul(value);
-        } else if (key == "pgsteal") {
-            current_vmstat_.pgsteal = std::stoul(value);
-        } else if (key == "pgscan_kswapd") {
-            current_vmstat_.pgscan_kswapd = std::stoul(value);
-        } else if (key == "pgscan_direct") {
-            current_vmstat_.pgscan_direct = std::stoul(value);
-        } else if (key == "nr_dirty") {
-            current_vmstat_.nr_dirty = std::stoul(value);
-        } else if (key == "nr_writeback") {
-            current_vmstat_.nr_writeback = std::stoul(value);
-        } else if (key == "nr_unstable") {
-            current_vmstat_.nr_unstable = std::stoul(value);
-        } else if (key == "nr_slab_reclaimable") {
-            current_vmstat_.nr_slab_reclaimable = std::stoul(value);
-        } else if (key == "nr_slab_unreclaimable") {
-            current_vmstat_.nr_slab_unreclaimable = std::stoul(value);
+    vmstat_previous_.swap(vmstat_values_);
+    if (!scanVmstat()) {
+        learnVmstatLayout();
+    }
+    
+    vmstat_rates_.assign(vmstat_values_.size(), 0.0);
+    if (interval_seconds > 0.0 && vmstat_previous_.size() == vmstat_values_.size()) {
+        for (size_t i = 0; i < vmstat_values_.size(); i++) {
+            if (vmstat_values_[i] >= vmstat_previous_[i]) {
+                vmstat_rates_[i] = (vmstat_values_[i] - vmstat_previous_[i]) / interval_seconds;
+            }
+        }
+    }
+    
+    for (size_t f = 0; f < vmstat_field_slots_.size(); f++) {
+        if (vmstat_field_slots_[f] >= 0) {
+            current_vmstat_.*(kVmstatFields[f].field) = vmstat_values_[vmstat_field_slots_[f]];
         }
     }
     
@@ -114,6 +153,107 @@ bool NumaMonitor::parseVmstat() {
 #endif
 }
 
+bool NumaMonitor::readVmstatFile() {
+    // Keep the fd open and re-read from offset 0; grow until the whole file fits
+    while (true) {
+        vmstat_length_ = 0;
+        while (vmstat_length_ < vmstat_buffer_.size()) {
+            ssize_t n = pread(vmstat_fd_, vmstat_buffer_.data() + vmstat_length_,
+                              vmstat_buffer_.size() - vmstat_length_, vmstat_length_);
+            if (n < 0) {
+                return false;
+            }
+            if (n == 0) {
+                return vmstat_length_ > 0;
+            }
+            vmstat_length_ += n;
+        }
+        vmstat_buffer_.resize(vmstat_buffer_.size() * 2);
+    }
+}
+
+bool NumaMonitor::scanVmstat() {
+    // Fast path: same keys in the same order as last time, so each line is
+    // "<known-length key> <digits>\n" and only the digits need parsing
+    if (vmstat_keys_.empty()) {
+        return false;
+    }
+    vmstat_values_.resize(vmstat_keys_.size());
+    
+    const char* p = vmstat_buffer_.data();
+    const char* end = p + vmstat_length_;
+    for (size_t i = 0; i < vmstat_keys_.size(); i++) {
+        p += vmstat_keys_[i].size();
+        if (p >= end || *p != ' ') {
+            return false;
+        }
+        p++;
+        unsigned long long value = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            value = value * 10 + (*p++ - '0');
+        }
+        if (p >= end || *p != '\n') {
+            return false;
+        }
+        vmstat_values_[i] = value;
+        p++;
+    }
+    return p == end;
+}
+
+void NumaMonitor::learnVmstatLayout() {
+    // Slow path on the first read (or if the layout ever changes): key every line
+    std::vector<std::string> old_keys;
+    old_keys.swap(vmstat_keys_);
+    std::vector<unsigned long long> old_values;
+    old_values.swap(vmstat_previous_);
+    vmstat_index_.clear();
+    vmstat_values_.clear();
+    
+    std::istringstream file(std::string(vmstat_buffer_.data(), vmstat_length_));
+    std::string key;
+    unsigned long long value;
+    while (file >> key >> value) {
+        vmstat_index_[key] = vmstat_keys_.size();
+        vmstat_keys_.push_back(key);
+        vmstat_values_.push_back(value);
+    }
+    
+    // Carry previous values over by name so rates survive a relayout
+    vmstat_previous_.assign(vmstat_values_.size(), 0);
+    bool complete = !old_keys.empty();
+    for (size_t i = 0; i < old_keys.size() && i < old_values.size(); i++) {
+        auto it = vmstat_index_.find(old_keys[i]);
+        if (it != vmstat_index_.end()) vmstat_previous_[it->second] = old_values[i];
+    }
+    for (const auto& k : vmstat_keys_) {
+        if (std::find(old_keys.begin(), old_keys.end(), k) == old_keys.end()) complete = false;
+    }
+    if (!complete) {
+        vmstat_previous_.clear();   // No baseline for new keys: skip rates this interval
+    }
+    
+    vmstat_field_slots_.clear();
+    for (const auto& field : kVmstatFields) {
+        vmstat_field_slots_.push_back(findVmstatCounter(field.key));
+    }
+}
+
+int NumaMonitor::findVmstatCounter(const std::string& key) const {
+    auto it = vmstat_index_.find(key);
+    return it != vmstat_index_.end() ? (int)it->second : -1;
+}
+
+unsigned long long NumaMonitor::getVmstatValue(const std::string& key) const {
+    int index = findVmstatCounter(key);
+    return index >= 0 ? vmstat_values_[index] : 0;
+}
+
+double NumaMonitor::getVmstatRate(const std::string& key) const {
+    int index = findVmstatCounter(key);
+    return index >= 0 && (size_t)index < vmstat_rates_.size() ? vmstat_rates_[index] : 0.0;
+}
+
 bool NumaMonitor::discoverNumaTopology() {
     numa_nodes_.clear();
     
@@ -132,7 +272,7 @@ bool NumaMonitor::discoverNumaTopology() {
             
             if (node_name.substr(0, 4) == "node") {
                 int node_id = std::stoi(node_name.substr(4));
-                numa_nodes_[node_id] = NumaNode{node_id, 0, 0, 0, 0.0, {}, false};
+                numa_nodes_[node_id] = NumaNode{node_id, 0, 0, 0, 0.0, {}, false, {}, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
             }
         }
         
@@ -145,7 +285,7 @@ bool NumaMonitor::discoverNumaTopology() {
     }
 #else
     // On non-Linux platforms, simulate a single NUMA node
-    numa_nodes_[0] = NumaNode{0, 8ULL * 1024 * 1024 * 1024, 4ULL * 1024 * 1024 * 1024, 4ULL * 1024 * 1024 * 1024, 50.0, {0, 1, 2, 3}, true};
+    numa_nodes_[0] = NumaNode{0, 8ULL * 1024 * 1024 * 1024, 4ULL * 1024 * 1024 * 1024, 4ULL * 1024 * 1024 * 1024, 50.0, {0, 1, 2, 3}, true, {}, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
     std::cout << "NUMA simulation mode - single node with 8GB memory" << std::endl;
     return true;
 #endif
@@ -182,31 +322,168 @@ bool NumaMonitor::parseNumaNode(int node_id) {
         }
     }
     
-    // Parse CPU cores for this node
-    std::string cpulist_path = "/sys/devices/system/node/node" + std::to_string(node_id) + "/cpulist";
-    std::ifstream cpulist_file(cpulist_path);
+    // CPU membership comes from the shared topology (refreshed on hotplug)
+    node.cpu_cores = Topology::instance().getNodeCpus(node_id);
     
-    if (cpulist_file.is_open()) {
-        std::string cpulist;
-        std::getline(cpulist_file, cpulist);
-        
-        // Parse CPU list (e.g., "0-3,8-11")
-        std::istringstream iss(cpulist);
-        std::string range;
-        while (std::getline(iss, range, ',')) {
-            size_t dash_pos = range.find('-');
-            if (dash_pos != std::string::npos) {
-                int start = std::stoi(range.substr(0, dash_pos));
-                int end = std::stoi(range.substr(dash_pos + 1));
-                for (int cpu = start; cpu <= end; cpu++) {
-                    node.cpu_cores.push_back(cpu);
-                }
-            } else {
-                node.cpu_cores.push_back(std::stoi(range));
+    return true;
+}
+
+bool NumaMonitor::parseNumaStat(NumaNode& node, double interval_seconds) {
+    std::ifstream file("/sys/devices/system/node/node" + std::to_string(node.node_id) + "/numastat");
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    NumaStatCounters counters = node.numastat;
+    std::string key;
+    unsigned long long value;
+    while (file >> key >> value) {
+        if (key == "numa_hit") counters.numa_hit = value;
+        else if (key == "numa_miss") counters.numa_miss = value;
+        else if (key == "numa_foreign") counters.numa_foreign = value;
+        else if (key == "interleave_hit") counters.interleave_hit = value;
+        else if (key == "local_node") counters.local_node = value;
+        else if (key == "other_node") counters.other_node = value;
+    }
+    
+    if (interval_seconds > 0.0) {
+        const NumaStatCounters& before = node.numastat;
+        auto rate = [interval_seconds](unsigned long long now, unsigned long long then) {
+            return now >= then ? (now - then) / interval_seconds : 0.0;
+        };
+        node.hit_rate = rate(counters.numa_hit, before.numa_hit);
+        node.miss_rate = rate(counters.numa_miss, before.numa_miss);
+        node.foreign_rate = rate(counters.numa_foreign, before.numa_foreign);
+        node.interleave_rate = rate(counters.interleave_hit, before.interleave_hit);
+        node.local_rate = rate(counters.local_node, before.local_node);
+        node.other_rate = rate(counters.other_node, before.other_node);
+        double total = node.local_rate + node.other_rate;
+        node.remote_ratio = total > 0.0 ? 100.0 * node.other_rate / total : 0.0;
+    }
+    node.numastat = counters;
+    return true;
+}
+
+void NumaMonitor::calculateBalancingRates(double interval_seconds) {
+    if (interval_seconds <= 0.0) {
+        return;
+    }
+    unsigned long migrated = current_vmstat_.numa_pages_migrated - previous_vmstat_.numa_pages_migrated;
+    unsigned long hint_faults = current_vmstat_.numa_hint_faults - previous_vmstat_.numa_hint_faults;
+    unsigned long hint_local = current_vmstat_.numa_hint_faults_local - previous_vmstat_.numa_hint_faults_local;
+    
+    current_vmstat_.pages_migrated_rate = migrated / interval_seconds;
+    current_vmstat_.hint_fault_rate = hint_faults / interval_seconds;
+    current_vmstat_.hint_local_percent = hint_faults > 0 ? 100.0 * hint_local / hint_faults : 0.0;
+}
+
+double NumaMonitor::getRemoteAccessRatio() const {
+    double local = 0.0, other = 0.0;
+    for (const auto& [node_id, node] : numa_nodes_) {
+        local += node.local_rate;
+        other += node.other_rate;
+    }
+    return local + other > 0.0 ? 100.0 * other / (local + other) : 0.0;
+}
+
+bool NumaMonitor::isRemoteAccessHigh() const {
+    return numa_nodes_.size() > 1 && getRemoteAccessRatio() > kRemoteRatioWarnPercent;
+}
+
+void NumaMonitor::attachProcessMonitor(const ProcessMonitor* process_monitor, int top_n) {
+    process_monitor_ = process_monitor;
+    placement_top_n_ = top_n;
+}
+
+void NumaMonitor::updateProcessPlacement() {
+    if (!process_monitor_) {
+        return;
+    }
+    
+    // Processes past the deadline keep their previous sample, marked incomplete
+    auto deadline = std::chrono::steady_clock::now() + kPlacementBudget;
+    std::vector<ProcessNumaPlacement> placements;
+    for (pid_t pid : process_monitor_->getTopMemoryProcesses(placement_top_n_)) {
+        ProcessNumaPlacement placement{pid, process_monitor_->getProcessStats(pid).comm, {}, {}, 0, 0.0, false, true};
+        if (std::chrono::steady_clock::now() < deadline) {
+            if (!sampleNumaMaps(placement, deadline)) continue;   // Exited
+        } else {
+            auto previous = std::find_if(placements_.begin(), placements_.end(),
+                                         [pid](const ProcessNumaPlacement& p) { return p.pid == pid; });
+            if (previous == placements_.end()) continue;
+            placement = *previous;
+            placement.complete = false;
+        }
+        placements.push_back(placement);
+    }
+    placements_ = std::move(placements);
+}
+
+bool NumaMonitor::sampleNumaMaps(ProcessNumaPlacement& placement, std::chrono::steady_clock::time_point deadline) {
+    std::string proc = "/proc/" + std::to_string(placement.pid);
+    std::ifstream numa_maps(proc + "/numa_maps");
+    if (!numa_maps.is_open() && errno != EACCES && errno != EPERM) {
+        return false;
+    }
+    
+    // "7f12c0000000 default anon=512 dirty=512 N0=256 N1=256 kernelpagesize_kB=4"
+    std::string line;
+    std::map<int, unsigned long> pages;
+    size_t lines = 0;
+    placement.complete = true;
+    while (std::getline(numa_maps, line)) {
+        pages.clear();
+        unsigned long page_kb = 4;
+        for (const char* p = line.c_str(); (p = std::strchr(p, ' ')) != nullptr;) {
+            p++;
+            if (p[0] == 'N' && p[1] >= '0' && p[1] <= '9') {
+                char* end;
+                int node = std::strtol(p + 1, &end, 10);
+                if (*end == '=') pages[node] += std::strtoul(end + 1, nullptr, 10);
+            } else if (std::strncmp(p, "kernelpagesize_kB=", 18) == 0) {
+                page_kb = std::strtoul(p + 18, nullptr, 10);
             }
         }
+        for (const auto& [node, count] : pages) {
+            placement.node_kb[node] += count * page_kb;
+            placement.total_kb += count * page_kb;
+        }
+        if (++lines % 256 == 0 && std::chrono::steady_clock::now() >= deadline) {
+            placement.complete = false;
+            break;
+        }
     }
     
+    // Without ptrace access the open fails with EACCES; keep the row so the
+    // gap is visible rather than the process silently missing from the table
+    if (!numa_maps.is_open()) {
+        placement.readable = false;
+        placement.complete = false;
+    }
+    
+    // Field 39 of each thread's stat is the CPU it last ran on
+    std::error_code ec;
+    for (const auto& task : std::filesystem::directory_iterator(proc + "/task", ec)) {
+        std::ifstream stat(task.path() / "stat");
+        std::string text;
+        std::getline(stat, text);
+        size_t comm_end = text.rfind(')');
+        if (comm_end == std::string::npos) continue;
+        std::istringstream fields(text.substr(comm_end + 2));
+        std::string field;
+        for (int i = 3; i < 39 && fields >> field; i++) {}
+        int cpu;
+        if (fields >> cpu) {
+            placement.thread_nodes[Topology::instance().getNodeOfCpu(cpu)]++;
+        }
+    }
+    
+    unsigned long misplaced_kb = 0;
+    for (const auto& [node, kb] : placement.node_kb) {
+        if (!placement.thread_nodes.count(node)) misplaced_kb += kb;
+    }
+    placement.misplaced_percent = placement.total_kb > 0 && !placement.thread_nodes.empty()
+                                  ? 100.0 * misplaced_kb / placement.total_kb : 0.0;
     return true;
 }
 
@@ -225,7 +502,28 @@ void NumaMonitor::calculateMemoryPressure() {
     current_vmstat_.swap_rate = swap_in_delta + swap_out_delta;
     current_vmstat_.is_swapping = (swap_in_delta > 0 || swap_out_delta > 0);
     
-    // Calculate memory pressure score
+    // Prefer PSI: the share of wall time tasks were stalled on memory
+    PressureLine some{}, full{};
+    bool has_full = false;
+    auto now = std::chrono::steady_clock::now();
+    double interval_us = std::chrono::duration<double, std::micro>(now - last_update_).count();
+    last_update_ = now;
+    
+    if (PressureMonitor::readPressureFile("/proc/pressure/memory", some, full, has_full)) {
+        bool has_baseline = previous_vmstat_.has_psi;
+        current_vmstat_.has_psi = true;
+        if (has_baseline && interval_us > 0.0) {
+            current_vmstat_.memory_pressure = 100.0 * (some.total_us - psi_some_total_) / interval_us;
+            current_vmstat_.memory_stall_full = 100.0 * (full.total_us - psi_full_total_) / interval_us;
+        }
+        psi_some_total_ = some.total_us;
+        psi_full_total_ = full.total_us;
+        current_vmstat_.is_memory_pressured = current_vmstat_.memory_pressure > 10.0 ||
+                                              current_vmstat_.memory_stall_full > 5.0;
+        return;
+    }
+    
+    // Without PSI, fall back to a heuristic score
     double pressure_score = 0.0;
     
     // Factor in dirty pages
@@ -281,7 +579,8 @@ void NumaMonitor::printStats() {
     std::cout << "Swap Activity/sec:     " << std::setw(8) << current_vmstat_.swap_rate << std::endl;
     std::cout << "Dirty Pages:          " << std::setw(8) << current_vmstat_.nr_dirty << std::endl;
     std::cout << "Writeback Pages:      " << std::setw(8) << current_vmstat_.nr_writeback << std::endl;
-    std::cout << "Memory Pressure:      " << std::setw(8) << std::fixed << std::setprecision(1) 
+    std::cout << (current_vmstat_.has_psi ? "Memory Stall (PSI):   " : "Memory Pressure:      ")
+              << std::setw(8) << std::fixed << std::setprecision(1) 
               << current_vmstat_.memory_pressure << "%" << std::endl;
 }
 
@@ -336,6 +635,137 @@ void NumaMonitor::printNumaTopology() {
     }
 }
 
+void NumaMonitor::printNumaLocality() {
+    if (first_reading_ || numa_nodes_.empty()) {
+        return;
+    }
+    
+    std::cout << "\n📍 NUMA LOCALITY (pages/sec)" << std::endl;
+    std::cout << "─────────────────────────────────────────────────────────────────────" << std::endl;
+    std::cout << std::left << std::setw(6) << "NODE"
+              << std::right << std::setw(11) << "HIT"
+              << std::setw(9) << "MISS"
+              << std::setw(9) << "FOREIGN"
+              << std::setw(9) << "INTRLV"
+              << std::setw(11) << "LOCAL"
+              << std::setw(9) << "OTHER"
+              << std::setw(9) << "REMOTE" << std::endl;
+    
+    for (const auto& [node_id, node] : numa_nodes_) {
+        std::cout << std::left << std::setw(6) << node_id
+                  << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(11) << node.hit_rate
+                  << std::setw(9) << node.miss_rate
+                  << std::setw(9) << node.foreign_rate
+                  << std::setw(9) << node.interleave_rate
+                  << std::setw(11) << node.local_rate
+                  << std::setw(9) << node.other_rate
+                  << std::setw(8) << std::setprecision(1) << node.remote_ratio << "%";
+        if (node.remote_ratio > kRemoteRatioCriticalPercent) {
+            std::cout << " 🔴";
+        } else if (node.remote_ratio > kRemoteRatioWarnPercent) {
+            std::cout << " 🟡";
+        }
+        std::cout << std::endl;
+    }
+    
+    std::cout << "NUMA balancing: " << std::fixed << std::setprecision(0)
+              << current_vmstat_.pages_migrated_rate << " pages migrated/s, "
+              << current_vmstat_.hint_fault_rate << " hint faults/s";
+    if (current_vmstat_.hint_fault_rate > 0.0) {
+        std::cout << " (" << std::setprecision(1) << current_vmstat_.hint_local_percent << "% local)";
+    }
+    std::cout << std::endl;
+    
+    if (isRemoteAccessHigh()) {
+        std::cout << "🟡 " << std::setprecision(1) << getRemoteAccessRatio()
+                  << "% of allocations serve tasks on another node" << std::endl;
+        std::cout << "   → Impact: Cross-socket memory latency and interconnect traffic" << std::endl;
+        std::cout << "   → Solution: Bind tasks and memory together (numactl --cpunodebind/--membind)" << std::endl;
+    }
+}
+
+void NumaMonitor::printProcessPlacement() {
+    if (!process_monitor_) {
+        return;
+    }
+    
+    std::cout << "\n🧭 PROCESS NUMA PLACEMENT (top " << placement_top_n_ << " by memory)" << std::endl;
+    std::cout << "─────────────────────────────────────────────────────────────────────" << std::endl;
+    if (placements_.empty()) {
+        std::cout << "No processes sampled yet" << std::endl;
+        return;
+    }
+    
+    std::cout << std::left << std::setw(8) << "PID"
+              << std::setw(16) << "COMMAND"
+              << std::right << std::setw(10) << "MEM(MB)"
+              << "  " << std::left << std::setw(24) << "MEMORY BY NODE (MB)"
+              << std::setw(14) << "THREAD NODES"
+              << std::right << std::setw(10) << "MISPLACED" << std::endl;
+    
+    int unreadable = 0;
+    for (const auto& placement : placements_) {
+        std::ostringstream memory, threads;
+        for (const auto& [node, kb] : placement.node_kb) {
+            memory << (memory.tellp() > 0 ? " " : "") << "N" << node << "=" << kb / 1024;
+        }
+        for (const auto& [node, count] : placement.thread_nodes) {
+            threads << (threads.tellp() > 0 ? " " : "") << "N" << node << "x" << count;
+        }
+        std::cout << std::left << std::setw(8) << placement.pid
+                  << std::setw(16) << placement.comm.substr(0, 15);
+        if (!placement.readable) {
+            std::cout << std::right << std::setw(10) << "-"
+                      << "  " << std::left << std::setw(24) << "(no access)"
+                      << std::setw(14) << threads.str().substr(0, 13)
+                      << std::right << std::setw(10) << "-" << std::endl;
+            unreadable++;
+            continue;
+        }
+        std::cout << std::right << std::setw(10) << placement.total_kb / 1024
+                  << "  " << std::left << std::setw(24) << memory.str().substr(0, 23)
+                  << std::setw(14) << threads.str().substr(0, 13)
+                  << std::right << std::fixed << std::setprecision(1) << std::setw(9)
+                  << placement.misplaced_percent << "%";
+        if (!placement.complete) {
+            std::cout << " (partial)";
+        } else if (placement.misplaced_percent > kMisplacedWarnPercent) {
+            std::cout << " 🟡";
+        }
+        std::cout << std::endl;
+    }
+    if (unreadable > 0) {
+        std::cout << unreadable << " process(es) denied numa_maps - run as root or with CAP_SYS_PTRACE" << std::endl;
+    }
+}
+
+void NumaMonitor::printVmstatActivity(int count) {
+    if (vmstat_rates_.empty()) {
+        return;
+    }
+    
+    // Event counters only; nr_* gauges are levels, not activity
+    std::vector<std::pair<double, size_t>> active;
+    for (size_t i = 0; i < vmstat_rates_.size(); i++) {
+        if (vmstat_rates_[i] > 0.0 && vmstat_keys_[i].compare(0, 3, "nr_") != 0) {
+            active.push_back({vmstat_rates_[i], i});
+        }
+    }
+    std::sort(active.rbegin(), active.rend());
+    
+    std::cout << "\n📈 VMSTAT ACTIVITY (" << vmstat_keys_.size() << " counters tracked)" << std::endl;
+    if (active.empty()) {
+        std::cout << "No vmstat events in the last interval" << std::endl;
+        return;
+    }
+    for (size_t i = 0; i < active.size() && i < (size_t)count; i++) {
+        std::cout << "  " << std::left << std::setw(32) << vmstat_keys_[active[i].second]
+                  << std::right << std::fixed << std::setprecision(0) << std::setw(12) << active[i].first
+                  << "/s" << std::endl;
+    }
+}
+
 void NumaMonitor::printMemoryPressureAnalysis() {
     if (first_reading_) {
         return;
@@ -376,19 +806,35 @@ void NumaMonitor::printMemoryPressureAnalysis() {
     
     // Memory pressure assessment
     std::cout << "📊 MEMORY PRESSURE ASSESSMENT" << std::endl;
-    std::cout << "Pressure Score: " << std::fixed << std::setprecision(1) 
-              << current_vmstat_.memory_pressure << "%";
-    
-    if (current_vmstat_.memory_pressure > 80.0) {
-        std::cout << " 🔴 CRITICAL - Severe memory pressure" << std::endl;
-        std::cout << "   → Impact: System performance severely degraded" << std::endl;
-        std::cout << "   → Solution: Immediate memory increase required" << std::endl;
-    } else if (current_vmstat_.memory_pressure > 60.0) {
-        std::cout << " 🟡 WARNING - Elevated memory pressure" << std::endl;
-        std::cout << "   → Impact: Performance may be affected" << std::endl;
-        std::cout << "   → Solution: Monitor closely, consider memory upgrade" << std::endl;
+    if (current_vmstat_.has_psi) {
+        std::cout << "Memory Stall (PSI): some " << std::fixed << std::setprecision(1)
+                  << current_vmstat_.memory_pressure << "%, full " << current_vmstat_.memory_stall_full << "%";
+        if (current_vmstat_.memory_stall_full > 5.0) {
+            std::cout << " 🔴 CRITICAL - All non-idle tasks stalled on memory" << std::endl;
+            std::cout << "   → Impact: Reclaim or swap-in is blocking the whole workload" << std::endl;
+            std::cout << "   → Solution: Reduce working set, add memory, check memory.high limits" << std::endl;
+        } else if (current_vmstat_.memory_pressure > 10.0) {
+            std::cout << " 🟡 WARNING - Tasks waiting on reclaim/refaults" << std::endl;
+            std::cout << "   → Impact: Latency added to memory allocations" << std::endl;
+            std::cout << "   → Solution: Monitor closely, consider memory upgrade" << std::endl;
+        } else {
+            std::cout << " ✅ NORMAL - Memory pressure under control" << std::endl;
+        }
     } else {
-        std::cout << " ✅ NORMAL - Memory pressure under control" << std::endl;
+        std::cout << "Pressure Score: " << std::fixed << std::setprecision(1) 
+                  << current_vmstat_.memory_pressure << "%";
+        
+        if (current_vmstat_.memory_pressure > 80.0) {
+            std::cout << " 🔴 CRITICAL - Severe memory pressure" << std::endl;
+            std::cout << "   → Impact: System performance severely degraded" << std::endl;
+            std::cout << "   → Solution: Immediate memory increase required" << std::endl;
+        } else if (current_vmstat_.memory_pressure > 60.0) {
+            std::cout << " 🟡 WARNING - Elevated memory pressure" << std::endl;
+            std::cout << "   → Impact: Performance may be affected" << std::endl;
+            std::cout << "   → Solution: Monitor closely, consider memory upgrade" << std::endl;
+        } else {
+            std::cout << " ✅ NORMAL - Memory pressure under control" << std::endl;
+        }
     }
     
     // Dirty page analysis
@@ -0,0 +1,326 @@
+#include "PageCacheInspector.h"
+#include <iostream>
+#include <iomanip>
+#include <filesystem>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <sstream>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#ifndef __NR_cachestat
+#define __NR_cachestat 451         // Same number on every architecture
+#endif
+
+namespace {
+
+// Mapping window for mincore: 1 GiB keeps the vector at 256 KB with 4 KB pages
+const uint64_t kMincoreWindow = 1ULL << 30;
+
+// Layouts of struct cachestat_range / struct cachestat from <linux/mman.h> (6.5+)
+struct CachestatRange {
+    uint64_t off;
+    uint64_t len;                  // 0 = to end of file
+};
+
+struct CachestatResult {
+    uint64_t nr_cache;
+    uint64_t nr_dirty;
+    uint64_t nr_writeback;
+    uint64_t nr_evicted;
+    uint64_t nr_recently_evicted;
+};
+
+double toMb(double bytes) {
+    return bytes / (1024.0 * 1024.0);
+}
+
+std::string formatBytes(double bytes) {
+    const char* units[] = {"B", "KB", "MB", "GB", "TB"};
+    int unit = 0;
+    while (bytes >= 1024.0 && unit < 4) {
+        bytes /= 1024.0;
+        unit++;
+    }
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(unit == 0 ? 0 : 1) << bytes << " " << units[unit];
+    return out.str();
+}
+
+} // namespace
+
+PageCacheInspector::PageCacheInspector(int threads)
+    : threads_(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency())),
+      page_size_(sysconf(_SC_PAGESIZE)), cachestat_supported_(true), skipped_(0) {
+}
+
+bool PageCacheInspector::scan(const std::vector<std::string>& paths) {
+    namespace fs = std::filesystem;
+    roots_ = paths;
+    files_.clear();
+
+    std::deque<std::pair<std::string, size_t>> directories;
+    for (size_t i = 0; i < paths.size(); i++) {
+        std::error_code ec;
+        fs::file_status status = fs::status(paths[i], ec);
+        if (ec) {
+            std::cerr << "fincore: " << paths[i] << ": " << ec.message() << std::endl;
+            skipped_++;
+        } else if (fs::is_regular_file(status)) {
+            uint64_t size = fs::file_size(paths[i], ec);
+            addFile(paths[i], i, ec ? 0 : size);
+        } else if (fs::is_directory(status)) {
+            directories.emplace_back(paths[i], i);
+        } else {
+            skipped_++;
+        }
+    }
+
+    // Directory walk: workers share a queue of directories still to list
+    std::mutex mutex;
+    std::condition_variable changed;
+    int busy = 0;
+    auto walker = [&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            changed.wait(lock, [&]() { return !directories.empty() || busy == 0; });
+            if (directories.empty()) {
+                return;
+            }
+            auto [directory, root] = directories.front();
+            directories.pop_front();
+            busy++;
+            lock.unlock();
+
+            std::vector<std::string> subdirectories;
+            std::vector<FileResidency> found;
+            size_t errors = 0;
+            listDirectory(directory, root, subdirectories, found, errors);
+
+            lock.lock();
+            for (auto& subdirectory : subdirectories) {
+                directories.emplace_back(std::move(subdirectory), root);
+            }
+            files_.insert(files_.end(), std::make_move_iterator(found.begin()), std::make_move_iterator(found.end()));
+            skipped_ += errors;
+            busy--;
+            changed.notify_all();
+        }
+    };
+    runWorkers(walker);
+    if (files_.empty()) {
+        return false;
+    }
+
+    // Files are independent; workers claim them by index
+    std::atomic<size_t> next{0};
+    runWorkers([this, &next]() {
+        for (size_t i = next++; i < files_.size(); i = next++) {
+            inspect(files_[i]);
+        }
+    });
+    return true;
+}
+
+void PageCacheInspector::runWorkers(const std::function<void()>& worker) const {
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads_; i++) {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+}
+
+void PageCacheInspector::addFile(const std::string& path, size_t root, uint64_t size) {
+    files_.push_back(makeResidency(path, root, size));
+}
+
+FileResidency PageCacheInspector::makeResidency(const std::string& path, size_t root, uint64_t size) {
+    FileResidency residency{};
+    residency.path = path;
+    residency.root = root;
+    residency.size_bytes = size;
+    residency.dirty_pages = residency.writeback_pages = residency.evicted_pages = -1;
+    return residency;
+}
+
+void PageCacheInspector::listDirectory(const std::string& directory, size_t root, std::vector<std::string>& subdirectories,
+                                       std::vector<FileResidency>& found, size_t& errors) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+
+    // Metadata only; symlinks are not followed so a dataset is never counted twice
+    for (auto it = fs::directory_iterator(directory, fs::directory_options::skip_permission_denied, ec);
+         it != fs::directory_iterator(); it.increment(ec)) {
+        if (ec) {
+            errors++;
+            break;
+        }
+        fs::file_status status = it->symlink_status(ec);
+        if (fs::is_directory(status)) {
+            subdirectories.push_back(it->path().string());
+        } else if (fs::is_regular_file(status)) {
+            uint64_t size = it->file_size(ec);
+            found.push_back(makeResidency(it->path().string(), root, ec ? 0 : size));
+        }
+    }
+    if (ec) {
+        errors++;
+    }
+}
+
+void PageCacheInspector::inspect(FileResidency& file) {
+    // O_NOATIME needs ownership (or CAP_FOWNER); retry without it
+    int fd = open(file.path.c_str(), O_RDONLY | O_CLOEXEC | O_NOATIME);
+    if (fd < 0 && errno == EPERM) {
+        fd = open(file.path.c_str(), O_RDONLY | O_CLOEXEC);
+    }
+    if (fd < 0) {
+        file.error = true;
+        return;
+    }
+
+    if (!(cachestat_supported_.load(std::memory_order_relaxed) && inspectCachestat(fd, file))) {
+        file.error = !inspectMincore(fd, file);
+    }
+    close(fd);
+}
+
+bool PageCacheInspector::inspectCachestat(int fd, FileResidency& file) {
+    CachestatRange range{0, 0};
+    CachestatResult result{};
+    if (syscall(__NR_cachestat, fd, &range, &result, 0) != 0) {
+        if (errno == ENOSYS) {
+            cachestat_supported_ = false;   // Pre-6.5 kernel: mincore from now on
+        }
+        return false;
+    }
+    file.cached_pages = result.nr_cache;
+    file.dirty_pages = result.nr_dirty;
+    file.writeback_pages = result.nr_writeback;
+    file.evicted_pages = result.nr_evicted;
+    return true;
+}
+
+bool PageCacheInspector::inspectMincore(int fd, FileResidency& file) {
+    // mincore reports page cache of a file mapping only to callers that own the
+    // file or could open it for writing (Linux 5.0+); others see it as uncached
+    std::vector<unsigned char> vec;
+    file.cached_pages = 0;
+    for (uint64_t offset = 0; offset < file.size_bytes; offset += kMincoreWindow) {
+        size_t length = std::min(kMincoreWindow, file.size_bytes - offset);
+        void* base = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, offset);
+        if (base == MAP_FAILED) {
+            return false;
+        }
+        size_t pages = (length + page_size_ - 1) / page_size_;
+        vec.resize(pages);
+        bool ok = mincore(base, length, vec.data()) == 0;
+        munmap(base, length);
+        if (!ok) {
+            return false;
+        }
+        for (unsigned char resident : vec) {
+            file.cached_pages += resident & 1;
+        }
+    }
+    return true;
+}
+
+uint64_t PageCacheInspector::getCachedBytes() const {
+    uint64_t bytes = 0;
+    for (const auto& file : files_) {
+        bytes += file.cached_pages * page_size_;
+    }
+    return bytes;
+}
+
+uint64_t PageCacheInspector::getTotalBytes() const {
+    uint64_t bytes = 0;
+    for (const auto& file : files_) {
+        bytes += file.size_bytes;
+    }
+    return bytes;
+}
+
+void PageCacheInspector::printReport(unsigned long system_cached_kb, int top) const {
+    bool cachestat = cachestat_supported_.load();
+    std::cout << "\n📄 PAGE CACHE RESIDENCY (" << (cachestat ? "cachestat" : "mincore") << ", "
+              << threads_ << " worker threads)" << std::endl;
+    std::cout << "─────────────────────────────────────────────────────────────────────" << std::endl;
+
+    std::vector<const FileResidency*> ranked;
+    size_t errors = 0;
+    for (const auto& file : files_) {
+        if (file.error) {
+            errors++;
+        } else {
+            ranked.push_back(&file);
+        }
+    }
+    std::sort(ranked.begin(), ranked.end(), [](const FileResidency* a, const FileResidency* b) {
+        if (a->cached_pages != b->cached_pages) return a->cached_pages > b->cached_pages;
+        return a->size_bytes > b->size_bytes;
+    });
+
+    std::cout << std::right << std::setw(11) << "SIZE"
+              << std::setw(11) << "CACHED"
+              << std::setw(8) << "CACHE%"
+              << std::setw(10) << "DIRTY"
+              << std::setw(10) << "WRITEBACK"
+              << std::setw(10) << "EVICTED" << "  FILE" << std::endl;
+    std::cout << std::fixed;
+    int shown = 0;
+    for (const FileResidency* file : ranked) {
+        if (shown++ >= top) break;
+        double cached_bytes = static_cast<double>(file->cached_pages) * page_size_;
+        double percent = file->size_bytes > 0 ? std::min(100.0, 100.0 * cached_bytes / file->size_bytes) : 0.0;
+        std::cout << std::setw(11) << formatBytes(file->size_bytes)
+                  << std::setw(11) << formatBytes(cached_bytes)
+                  << std::setw(7) << std::setprecision(1) << percent << "%"
+                  << std::setw(10) << (file->dirty_pages >= 0 ? formatBytes(static_cast<double>(file->dirty_pages) * page_size_) : "-")
+                  << std::setw(10) << (file->writeback_pages >= 0 ? formatBytes(static_cast<double>(file->writeback_pages) * page_size_) : "-")
+                  << std::setw(10) << (file->evicted_pages >= 0 ? formatBytes(static_cast<double>(file->evicted_pages) * page_size_) : "-")
+                  << "  " << file->path << std::endl;
+    }
+    if (ranked.size() > static_cast<size_t>(top)) {
+        std::cout << "  ... " << ranked.size() - top << " more files" << std::endl;
+    }
+
+    // Per command-line path
+    std::cout << "\n" << std::right << std::setw(11) << "SIZE" << std::setw(11) << "CACHED"
+              << std::setw(8) << "CACHE%" << std::setw(9) << "FILES" << "  PATH" << std::endl;
+    for (size_t root = 0; root < roots_.size(); root++) {
+        uint64_t size = 0, cached = 0;
+        size_t count = 0;
+        for (const auto& file : files_) {
+            if (file.root != root || file.error) continue;
+            size += file.size_bytes;
+            cached += file.cached_pages * page_size_;
+            count++;
+        }
+        double percent = size > 0 ? std::min(100.0, 100.0 * cached / size) : 0.0;
+        std::cout << std::setw(11) << formatBytes(size) << std::setw(11) << formatBytes(cached)
+                  << std::setw(7) << std::setprecision(1) << percent << "%"
+                  << std::setw(9) << count << "  " << roots_[root] << std::endl;
+    }
+
+    uint64_t cached = getCachedBytes();
+    std::cout << "\nTotal: " << formatBytes(cached) << " of " << formatBytes(getTotalBytes()) << " cached across "
+              << ranked.size() << " files";
+    if (system_cached_kb > 0) {
+        std::cout << " = " << std::setprecision(1) << 100.0 * toMb(cached) / (system_cached_kb / 1024.0)
+                  << "% of the system's " << formatBytes(system_cached_kb * 1024.0) << " Cached";
+    }
+    std::cout << std::endl;
+    if (errors > 0 || skipped_ > 0) {
+        std::cout << "Skipped: " << errors << " unreadable files, " << skipped_ << " other entries" << std::endl;
+    }
+}
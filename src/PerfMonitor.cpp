@@ -1,118 +1,443 @@
 #include "PerfMonitor.h"
+#include "Topology.h"
 #include <iostream>
 #include <iomanip>
 #include <chrono>
 #include <cstring>
+#include <cerrno>
+#include <filesystem>
+#include <algorithm>
+#include <cctype>
+#include <sys/resource.h>
 
-PerfMonitor::PerfMonitor() : first_reading_(true), initialized_(false) {
-    // Initialize perf event file descriptors
-    perf_fds_.resize(8, -1);
+namespace {
+
+// Built-in counters feeding PerfCounters; order defines builtin_counters_ indices
+struct BuiltinEvent {
+    const char* name;
+    uint32_t type;
+    uint64_t config;
+    unsigned long long PerfCounters::* field;
+};
+
+const BuiltinEvent kBuiltinEvents[] = {
+    {"cpu_cycles",          PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES,          &PerfCounters::cpu_cycles},
+    {"instructions",        PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS,        &PerfCounters::instructions},
+    {"cache_references",    PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES,    &PerfCounters::cache_references},
+    {"cache_misses",        PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES,        &PerfCounters::cache_misses},
+    {"branch_instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS, &PerfCounters::branch_instructions},
+    {"branch_misses",       PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES,       &PerfCounters::branch_misses},
+    {"context_switches",    PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES,    &PerfCounters::context_switches},
+    {"page_faults",         PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS,         &PerfCounters::page_faults},
+};
+
+// Cache/TLB levels probed through PERF_TYPE_HW_CACHE; unsupported
+// op/result combinations (e.g. L1I writes) simply fail to open
+struct CacheLevelEvent {
+    const char* name;
+    uint64_t cache_id;
+};
+
+const CacheLevelEvent kCacheLevels[] = {
+    {"L1D",  PERF_COUNT_HW_CACHE_L1D},
+    {"L1I",  PERF_COUNT_HW_CACHE_L1I},
+    {"LLC",  PERF_COUNT_HW_CACHE_LL},
+    {"dTLB", PERF_COUNT_HW_CACHE_DTLB},
+    {"iTLB", PERF_COUNT_HW_CACHE_ITLB},
+};
+
+const uint64_t kCacheOps[] = {PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_OP_WRITE};
+const uint64_t kCacheResults[] = {PERF_COUNT_HW_CACHE_RESULT_ACCESS, PERF_COUNT_HW_CACHE_RESULT_MISS};
+
+// Index of a counter within cache_counters_
+size_t cacheCounterIndex(size_t level, size_t op, size_t result) {
+    return level * 4 + op * 2 + result;
+}
+
+// Misses per thousand instructions above which the level is the bottleneck
+const double kLlcThrashingMpki = 10.0;
+const double kTlbBoundMpki = 2.0;
+
+std::vector<pid_t> listThreads(pid_t pid) {
+    std::vector<pid_t> threads;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator("/proc/" + std::to_string(pid) + "/task", ec)) {
+        std::string name = entry.path().filename().string();
+        if (!name.empty() && std::all_of(name.begin(), name.end(), ::isdigit)) {
+            threads.push_back(std::stoi(name));
+        }
+    }
+    return threads;
+}
+
+// Per-process group members, leader first; order matches ProcessPerfCounters::totals.
+// The generic cache-miss event counts last-level misses on x86 and most ARM cores.
+const std::pair<uint32_t, uint64_t> kProcessEvents[] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+const size_t kProcessEventCount = sizeof(kProcessEvents) / sizeof(kProcessEvents[0]);
+
+// Open order of kCacheLevels when fds are short: LLC and dTLB decide the
+// capacity-versus-reach verdict, L1I is the least actionable
+const size_t kCacheLevelPriority[] = {2, 3, 0, 4, 1};
+
+// Descriptors left for /proc readers, perf rings and the other monitors
+const size_t kFdReserve = 64;
+
+rlim_t raiseFdLimit() {
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0) {
+        return 1024;
+    }
+    if (limit.rlim_cur < limit.rlim_max) {
+        rlim_t previous = limit.rlim_cur;
+        limit.rlim_cur = limit.rlim_max;
+        if (setrlimit(RLIMIT_NOFILE, &limit) != 0) {
+            return previous;
+        }
+    }
+    return limit.rlim_cur;
+}
+
+size_t countOpenFds() {
+    size_t count = 0;
+    std::error_code ec;
+    for (auto it = std::filesystem::directory_iterator("/proc/self/fd", ec);
+         !ec && it != std::filesystem::directory_iterator(); it.increment(ec)) {
+        count++;
+    }
+    return count;
+}
+
+void reportFdExhaustion(rlim_t limit) {
+    if (errno == EMFILE) {
+        std::cerr << "   → Out of file descriptors (RLIMIT_NOFILE " << limit
+                  << "); raise ulimit -n or monitor fewer events" << std::endl;
+    }
+}
+
+// Bound the fds spent on a single heavily threaded process
+const size_t kMaxThreadsPerProcess = 64;
+
+// Intel IMC CAS counters; each CAS moves one 64-byte line, sysfs .scale converts to MiB
+const char* kMemoryBandwidthEvents[] = {
+    "uncore_imc/cas_count_read/",
+    "uncore_imc/cas_count_write/",
+};
+
+} // namespace
+
+PerfMonitor::PerfMonitor() : catalog_ready_(false), topology_generation_(0), target_pid_(-1), current_{}, previous_{},
+                             interval_seconds_(0.0), first_reading_(true), initialized_(false) {
 }
 
 PerfMonitor::~PerfMonitor() {
     // Close all perf event file descriptors
-    for (int fd : perf_fds_) {
-        if (fd >= 0) {
+    closeCounters();
+    for (const auto& [pid, counters] : process_counters_) {
+        for (int fd : counters.fds) {
             close(fd);
         }
     }
 }
 
-bool PerfMonitor::initialize() {
-    if (initialized_) {
-        return true;
+void PerfMonitor::closeCounters() {
+    for (auto* counters : {&builtin_counters_, &cache_counters_, &custom_counters_}) {
+        for (const auto& handle : *counters) {
+            for (int fd : handle.fds) {
+                if (fd >= 0) {
+                    close(fd);
+                }
+            }
+        }
+        counters->clear();
     }
-    
-#ifdef __linux__
-    // Setup performance counters
-    perf_events_["cpu_cycles"] = 0;
-    perf_events_["instructions"] = 1;
-    perf_events_["cache_references"] = 2;
-    perf_events_["cache_misses"] = 3;
-    perf_events_["branch_instructions"] = 4;
-    perf_events_["branch_misses"] = 5;
-    perf_events_["context_switches"] = 6;
-    perf_events_["page_faults"] = 7;
-    
-    // Setup perf events
-    if (!setupPerfEvent(perf_fds_[0], PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES)) {
-        std::cerr << "Failed to setup CPU cycles counter" << std::endl;
+    cache_levels_.clear();
+}
+
+bool PerfMonitor::ensureCatalog() {
+    if (!catalog_ready_) {
+        catalog_ready_ = catalog_.discover();
+    }
+    return catalog_ready_;
+}
+
+bool PerfMonitor::addEvent(const std::string& spec) {
+    if (!ensureCatalog()) {
+        std::cerr << "Cannot add event '" << spec << "': PMU catalog unavailable" << std::endl;
         return false;
     }
     
-    if (!setupPerfEvent(perf_fds_[1], PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS)) {
-        std::cerr << "Failed to setup instructions counter" << std::endl;
+    PerfEventDesc desc;
+    std::string error;
+    if (!catalog_.parseEventSpec(spec, desc, error)) {
+        std::cerr << "Invalid event '" << spec << "': " << error << std::endl;
         return false;
     }
     
-    if (!setupPerfEvent(perf_fds_[2], PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES)) {
-        std::cerr << "Failed to setup cache references counter" << std::endl;
+    custom_events_.push_back(desc);
+    return true;
+}
+
+bool PerfMonitor::addMemoryBandwidthEvents() {
+    if (!ensureCatalog()) {
         return false;
     }
     
-    if (!setupPerfEvent(perf_fds_[3], PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES)) {
-        std::cerr << "Failed to setup cache misses counter" << std::endl;
-        return false;
+    bool added = false;
+    for (const char* spec : kMemoryBandwidthEvents) {
+        PerfEventDesc desc;
+        std::string error;
+        if (catalog_.parseEventSpec(spec, desc, error)) {
+            custom_events_.push_back(desc);
+            added = true;
+        }
     }
     
-    if (!setupPerfEvent(perf_fds_[4], PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS)) {
-        std::cerr << "Failed to setup branch instructions counter" << std::endl;
-        return false;
+    if (!added) {
+        std::cerr << "Memory bandwidth counters unavailable (no uncore_imc PMU)" << std::endl;
+    }
+    return added;
+}
+
+void PerfMonitor::printEventCatalog() {
+    ensureCatalog();
+    catalog_.printCatalog();
+}
+
+bool PerfMonitor::initialize() {
+    if (initialized_) {
+        return true;
     }
     
-    if (!setupPerfEvent(perf_fds_[5], PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES)) {
-        std::cerr << "Failed to setup branch misses counter" << std::endl;
-        return false;
+#ifdef __linux__
+    ensureCatalog();
+    online_cpus_ = Topology::instance().getOnlineCpus();
+    topology_generation_ = Topology::instance().getGeneration();
+    
+    // Every counter costs one fd per CPU (or per thread), which exhausts the
+    // default 1024 soft limit on large machines; take the hard limit up front
+    rlim_t fd_limit = raiseFdLimit();
+    
+    // Setup built-in counters system-wide (one fd per online CPU) or per thread of target_pid_
+    size_t opened = 0;
+    for (const auto& event : kBuiltinEvents) {
+        PerfCounterHandle handle{event.name, {}, 1.0, "", 0, 0, 0.0, false, {}, {}, {}, {}};
+        PerfEventDesc desc{event.name, 1.0, "", {PerfEventTarget{"", event.type, event.config, 0, 0, {}}}};
+        
+        if (openCounter(handle, desc)) {
+            opened++;
+        } else {
+            std::cerr << "Failed to setup " << event.name << " counter: " << strerror(errno) << std::endl;
+            reportFdExhaustion(fd_limit);
+        }
+        builtin_counters_.push_back(handle);
     }
     
-    if (!setupPerfEvent(perf_fds_[6], PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES)) {
-        std::cerr << "Failed to setup context switches counter" << std::endl;
-        return false;
+    // Setup user-defined counters from --event specs; asked for explicitly, so
+    // they are opened before the cache hierarchy competes for descriptors
+    for (const auto& desc : custom_events_) {
+        PerfCounterHandle handle{desc.name, {}, desc.scale, desc.unit, 0, 0, 0.0, false, {}, {}, {}, {}};
+        for (const char* spec : kMemoryBandwidthEvents) {
+            if (desc.name == spec) handle.is_memory_bandwidth = true;
+        }
+        
+        if (openCounter(handle, desc)) {
+            opened++;
+            custom_counters_.push_back(handle);
+        } else {
+            std::cerr << "Failed to setup event '" << desc.name << "': " << strerror(errno) << std::endl;
+            reportFdExhaustion(fd_limit);
+        }
     }
     
-    if (!setupPerfEvent(perf_fds_[7], PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS)) {
-        std::cerr << "Failed to setup page faults counter" << std::endl;
+    // Setup the cache/TLB hierarchy; missing levels are reported as unavailable.
+    // Levels open in priority order and are dropped whole when the fd budget
+    // cannot cover all four counters, rather than failing at whatever CPU runs out
+    size_t scopes = target_pid_ > 0 ? listThreads(target_pid_).size() : online_cpus_.size();
+    size_t level_count = sizeof(kCacheLevels) / sizeof(kCacheLevels[0]);
+    for (size_t level = 0; level < level_count; level++) {
+        cache_levels_.push_back(CacheLevelCounters{kCacheLevels[level].name, 0, 0, 0, 0, 0.0, 0.0, false});
+        for (size_t op = 0; op < 2; op++) {
+            for (size_t result = 0; result < 2; result++) {
+                std::string name = std::string(kCacheLevels[level].name) + (op == 0 ? "_read" : "_write") +
+                                   (result == 0 ? "_access" : "_miss");
+                cache_counters_.push_back(PerfCounterHandle{name, {}, 1.0, "", 0, 0, 0.0, false, {}, {}, {}, {}});
+            }
+        }
+    }
+    
+    std::vector<std::string> dropped;
+    for (size_t level : kCacheLevelPriority) {
+        if (countOpenFds() + 4 * scopes + kFdReserve > fd_limit) {
+            dropped.push_back(kCacheLevels[level].name);
+            continue;
+        }
+        
+        auto& counters = cache_levels_[level];
+        for (size_t op = 0; op < 2; op++) {
+            PerfCounterHandle& access = cache_counters_[cacheCounterIndex(level, op, 0)];
+            PerfCounterHandle& miss = cache_counters_[cacheCounterIndex(level, op, 1)];
+            PerfEventTarget targets[2];
+            for (size_t result = 0; result < 2; result++) {
+                uint64_t config = kCacheLevels[level].cache_id | (kCacheOps[op] << 8) | (kCacheResults[result] << 16);
+                targets[result] = PerfEventTarget{"", PERF_TYPE_HW_CACHE, config, 0, 0, {}};
+            }
+            
+            // Access and miss share a group so both see the same multiplexing
+            // window; cores without an access event (L1I on Intel) count misses alone
+            if (openCachePair(access, miss, targets[0], targets[1])) {
+                opened += 2;
+                counters.available = true;
+            } else if (openCounter(miss, PerfEventDesc{miss.name, 1.0, "", {targets[1]}})) {
+                opened++;
+                counters.available = true;
+            } else {
+                reportFdExhaustion(fd_limit);
+            }
+        }
+    }
+    if (!dropped.empty()) {
+        std::cerr << "⚠️  Skipped cache levels";
+        for (const auto& name : dropped) {
+            std::cerr << " " << name;
+        }
+        std::cerr << ": fd limit " << fd_limit << " cannot cover " << 4 * scopes
+                  << " more counters (raise ulimit -n)" << std::endl;
+    }
+    
+    if (opened == 0) {
+        std::cerr << "No performance counters could be opened (check /proc/sys/kernel/perf_event_paranoid)" << std::endl;
         return false;
     }
     
     initialized_ = true;
-    std::cout << "✅ PerfMonitor initialized with hardware performance counters" << std::endl;
+    last_sample_ = std::chrono::steady_clock::now();
+    std::cout << "✅ PerfMonitor initialized with " << opened << " performance counters" << std::endl;
     return true;
 #else
     // On non-Linux platforms, initialize with dummy data
-    perf_events_["cpu_cycles"] = 0;
-    perf_events_["instructions"] = 1;
-    perf_events_["cache_references"] = 2;
-    perf_events_["cache_misses"] = 3;
-    perf_events_["branch_instructions"] = 4;
-    perf_events_["branch_misses"] = 5;
-    perf_events_["context_switches"] = 6;
-    perf_events_["page_faults"] = 7;
+    for (const auto& event : kBuiltinEvents) {
+        builtin_counters_.push_back(PerfCounterHandle{event.name, {}, 1.0, "", 0, 0, 0.0, false, {}, {}, {}, {}});
+    }
     
     initialized_ = true;
+    last_sample_ = std::chrono::steady_clock::now();
     std::cout << "⚠️  PerfMonitor initialized in compatibility mode (hardware counters not available on this platform)" << std::endl;
     return true;
 #endif
 }
 
-bool PerfMonitor::setupPerfEvent(int& fd, uint64_t type, uint64_t config, int cpu) {
+bool PerfMonitor::openCounter(PerfCounterHandle& handle, const PerfEventDesc& desc) {
+    // Existing threads get their own fd; inherit covers threads created later
+    std::vector<pid_t> threads;
+    if (target_pid_ > 0) {
+        threads = listThreads(target_pid_);
+    }
+    
+    for (const auto& target : desc.targets) {
+        for (const auto& [pid, cpu] : counterScopes(target, threads)) {
+            int fd = -1;
+            if (!setupPerfEvent(fd, target, pid, cpu)) {
+                int saved_errno = errno;
+                for (int open_fd : handle.fds) {
+                    close(open_fd);
+                }
+                handle.fds.clear();
+                handle.fd_cpus.clear();
+                errno = saved_errno;
+                return false;
+            }
+            handle.fds.push_back(fd);
+            handle.fd_cpus.push_back(cpu);
+        }
+    }
+    
+    return !handle.fds.empty();
+}
+
+std::vector<std::pair<pid_t, int>> PerfMonitor::counterScopes(const PerfEventTarget& target,
+                                                             const std::vector<pid_t>& threads) const {
+    // (pid, cpu) pairs: uncore PMUs count on the CPUs in their cpumask,
+    // per-process counters follow each thread, otherwise one per online CPU
+    std::vector<std::pair<pid_t, int>> scopes;
+    if (!target.cpus.empty()) {
+        for (int cpu : target.cpus) scopes.push_back({-1, cpu});
+    } else if (target_pid_ > 0) {
+        for (pid_t tid : threads) scopes.push_back({tid, -1});
+    } else {
+        for (int cpu : online_cpus_) scopes.push_back({-1, cpu});
+    }
+    return scopes;
+}
+
+bool PerfMonitor::openCachePair(PerfCounterHandle& access, PerfCounterHandle& miss,
+                                const PerfEventTarget& access_target, const PerfEventTarget& miss_target) {
+    std::vector<pid_t> threads;
+    if (target_pid_ > 0) {
+        threads = listThreads(target_pid_);
+    }
+    
+    // One group per scope: access leads, miss follows; fds stay index-aligned
+    for (const auto& [pid, cpu] : counterScopes(access_target, threads)) {
+        int leader = -1;
+        int member = -1;
+        if (!setupPerfEvent(leader, access_target, pid, cpu, true) ||
+            !setupPerfEvent(member, miss_target, pid, cpu, true, leader)) {
+            int saved_errno = errno;
+            if (leader >= 0) close(leader);
+            for (auto* handle : {&access, &miss}) {
+                for (int open_fd : handle->fds) {
+                    close(open_fd);
+                }
+                handle->fds.clear();
+                handle->fd_cpus.clear();
+            }
+            errno = saved_errno;
+            return false;
+        }
+        access.fds.push_back(leader);
+        access.fd_cpus.push_back(cpu);
+        miss.fds.push_back(member);
+        miss.fd_cpus.push_back(cpu);
+    }
+    
+    return !access.fds.empty();
+}
+
+bool PerfMonitor::setupPerfEvent(int& fd, const PerfEventTarget& target, pid_t pid, int cpu, bool group_read, int group_fd) {
 #ifdef __linux__
     struct perf_event_attr attr;
     memset(&attr, 0, sizeof(attr));
     
-    attr.type = type;
+    attr.type = target.type;
     attr.size = sizeof(attr);
-    attr.config = config;
-    attr.disabled = 1;
-    attr.exclude_kernel = 0;
-    attr.exclude_hv = 1;
-    attr.exclude_idle = 1;
+    attr.config = target.config;
+    attr.config1 = target.config1;
+    attr.config2 = target.config2;
+    attr.disabled = (group_fd < 0) ? 1 : 0;  // Members start with the leader
     attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    if (group_read) {
+        attr.read_format |= PERF_FORMAT_GROUP;
+    }
+    attr.inherit = (pid > 0) ? 1 : 0;
     
-    fd = syscall(__NR_perf_event_open, &attr, 0, cpu, -1, 0);
+    // Uncore and other non-core PMUs reject the exclude_* filters
+    if (target.type == PERF_TYPE_HARDWARE || target.type == PERF_TYPE_HW_CACHE || target.type == PERF_TYPE_RAW) {
+        attr.exclude_hv = 1;
+        attr.exclude_idle = 1;
+    }
+    
+    fd = syscall(__NR_perf_event_open, &attr, pid, cpu, group_fd, 0);
     if (fd < 0) {
         return false;
     }
+    if (group_fd >= 0) {
+        return true;
+    }
     
     // Enable the counter
     if (ioctl(fd, PERF_EVENT_IOC_ENABLE, 0) < 0) {
@@ -124,12 +449,280 @@ bool PerfMonitor::setupPerfEvent(int& fd, uint64_t type, uint64_t config, int cp
     return true;
 #else
     // On non-Linux platforms, return false to indicate perf events are not available
+    (void)target;
+    (void)pid;
+    (void)cpu;
+    (void)group_read;
+    (void)group_fd;
     fd = -1;
     return false;
 #endif
 }
 
+bool PerfMonitor::readCounter(PerfCounterHandle& handle) {
+    if (handle.fds.empty()) {
+        return false;
+    }
+    
+    // Layout selected by PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // every fd is read before anything is committed so a failed read leaves the handle intact
+    std::vector<PerfRawReading> raw(handle.fds.size());
+    for (size_t i = 0; i < handle.fds.size(); i++) {
+        if (read(handle.fds[i], &raw[i], sizeof(raw[i])) != sizeof(raw[i])) {
+            return false;
+        }
+    }
+    
+    commitReadings(handle, raw);
+    return true;
+}
+
+bool PerfMonitor::readCachePair(PerfCounterHandle& access, PerfCounterHandle& miss) {
+    if (access.fds.empty() || access.fds.size() != miss.fds.size()) {
+        return false;
+    }
+    
+    // Layout selected by PERF_FORMAT_GROUP | TOTAL_TIME_ENABLED | TOTAL_TIME_RUNNING
+    struct {
+        uint64_t nr;
+        uint64_t time_enabled;
+        uint64_t time_running;
+        uint64_t values[2];
+    } sample;
+    
+    std::vector<PerfRawReading> access_raw(access.fds.size());
+    std::vector<PerfRawReading> miss_raw(miss.fds.size());
+    for (size_t i = 0; i < access.fds.size(); i++) {
+        if (read(access.fds[i], &sample, sizeof(sample)) != sizeof(sample) || sample.nr != 2) {
+            return false;
+        }
+        access_raw[i] = PerfRawReading{sample.values[0], sample.time_enabled, sample.time_running};
+        miss_raw[i] = PerfRawReading{sample.values[1], sample.time_enabled, sample.time_running};
+    }
+    
+    commitReadings(access, access_raw);
+    commitReadings(miss, miss_raw);
+    return true;
+}
+
+void PerfMonitor::commitReadings(PerfCounterHandle& handle, std::vector<PerfRawReading>& raw) {
+    bool baseline = handle.fd_raw.size() != raw.size();
+    std::vector<unsigned long long> values(raw.size(), 0);
+    unsigned long long total = 0;
+    for (size_t i = 0; i < raw.size(); i++) {
+        values[i] = baseline ? scaledDelta(PerfRawReading{0, 0, 0}, raw[i])
+                             : handle.fd_values[i] + scaledDelta(handle.fd_raw[i], raw[i]);
+        total += values[i];
+    }
+    
+    handle.fd_raw.swap(raw);
+    handle.fd_previous = baseline ? values : handle.fd_values;
+    handle.fd_values.swap(values);
+    handle.previous = baseline ? total : handle.value;
+    handle.value = total;
+}
+
+unsigned long long PerfMonitor::scaledDelta(const PerfRawReading& before, const PerfRawReading& after) {
+    // Extrapolate this interval only: the running/enabled ratio changes as the
+    // PMU rotates events, so scaling cumulative totals would not be monotonic
+    if (after.value < before.value || after.time_running <= before.time_running) {
+        return 0;
+    }
+    uint64_t value = after.value - before.value;
+    uint64_t enabled = after.time_enabled - before.time_enabled;
+    uint64_t running = after.time_running - before.time_running;
+    if (running >= enabled) {
+        return value;
+    }
+    return (unsigned long long)((long double)value * enabled / running);
+}
+
+std::map<int, double> PerfMonitor::cpuDeltas(const PerfCounterHandle& handle) {
+    std::map<int, double> deltas;
+    if (handle.fd_previous.size() != handle.fd_values.size() || handle.fd_cpus.size() != handle.fds.size()) {
+        return deltas;
+    }
+    for (size_t i = 0; i < handle.fds.size(); i++) {
+        if (handle.fd_cpus[i] >= 0 && handle.fd_values[i] >= handle.fd_previous[i]) {
+            deltas[handle.fd_cpus[i]] += handle.fd_values[i] - handle.fd_previous[i];
+        }
+    }
+    return deltas;
+}
+
+std::map<int, double> PerfMonitor::getCpuCycles() const {
+    return builtin_counters_.empty() ? std::map<int, double>{} : cpuDeltas(builtin_counters_[0]);
+}
+
+std::map<int, double> PerfMonitor::getCpuInstructions() const {
+    return builtin_counters_.size() < 2 ? std::map<int, double>{} : cpuDeltas(builtin_counters_[1]);
+}
+
+bool PerfMonitor::openProcessGroup(pid_t tid, ProcessPerfCounters& counters) {
+#ifdef __linux__
+    std::vector<int> group;
+    for (size_t i = 0; i < kProcessEventCount; i++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        
+        attr.type = kProcessEvents[i].first;
+        attr.size = sizeof(attr);
+        attr.config = kProcessEvents[i].second;
+        attr.disabled = (i == 0) ? 1 : 0;  // Members start with the leader
+        attr.inherit = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        
+        int fd = syscall(__NR_perf_event_open, &attr, tid, -1, group.empty() ? -1 : group[0], 0);
+        if (fd < 0) {
+            for (int open_fd : group) {
+                close(open_fd);
+            }
+            return false;
+        }
+        group.push_back(fd);
+    }
+    
+    if (ioctl(group[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) < 0) {
+        for (int fd : group) {
+            close(fd);
+        }
+        return false;
+    }
+    
+    counters.leader_fds.push_back(group[0]);
+    counters.fds.insert(counters.fds.end(), group.begin(), group.end());
+    return true;
+#else
+    (void)tid;
+    (void)counters;
+    return false;
+#endif
+}
+
+bool PerfMonitor::attachProcess(pid_t pid) {
+    if (process_counters_.count(pid)) {
+        return true;
+    }
+    
+    ProcessPerfCounters counters{};
+    counters.pid = pid;
+    
+    std::vector<pid_t> threads = listThreads(pid);
+    if (threads.size() > kMaxThreadsPerProcess) {
+        threads.resize(kMaxThreadsPerProcess);
+    }
+    for (pid_t tid : threads) {
+        openProcessGroup(tid, counters);
+    }
+    
+    if (counters.leader_fds.empty()) {
+        return false;
+    }
+    
+    process_counters_[pid] = counters;
+    return true;
+}
+
+void PerfMonitor::detachProcess(pid_t pid) {
+    auto it = process_counters_.find(pid);
+    if (it == process_counters_.end()) {
+        return;
+    }
+    for (int fd : it->second.fds) {
+        close(fd);
+    }
+    process_counters_.erase(it);
+}
+
+bool PerfMonitor::readProcessCounters(ProcessPerfCounters& counters) {
+    // Layout selected by PERF_FORMAT_GROUP | TOTAL_TIME_ENABLED | TOTAL_TIME_RUNNING
+    struct {
+        uint64_t nr;
+        uint64_t time_enabled;
+        uint64_t time_running;
+        uint64_t values[kProcessEventCount];
+    } sample;
+    
+    // Read every group before committing any, so a failed read leaves the
+    // previous readings intact for the next interval
+    std::vector<std::array<PerfRawReading, kProcessEventCount>> raw(counters.leader_fds.size());
+    for (size_t g = 0; g < counters.leader_fds.size(); g++) {
+        if (read(counters.leader_fds[g], &sample, sizeof(sample)) != sizeof(sample) || sample.nr != kProcessEventCount) {
+            return false;
+        }
+        // The group is scheduled as a unit, so every member shares its times
+        for (size_t i = 0; i < kProcessEventCount; i++) {
+            raw[g][i] = PerfRawReading{sample.values[i], sample.time_enabled, sample.time_running};
+        }
+    }
+    
+    bool baseline = !counters.has_baseline || counters.raw.size() != raw.size();
+    std::array<unsigned long long, kProcessEventCount> deltas{};
+    for (size_t g = 0; g < raw.size(); g++) {
+        for (size_t i = 0; i < kProcessEventCount; i++) {
+            deltas[i] += scaledDelta(baseline ? PerfRawReading{0, 0, 0} : counters.raw[g][i], raw[g][i]);
+        }
+    }
+    
+    counters.raw.swap(raw);
+    counters.previous = baseline ? deltas : counters.totals;
+    for (size_t i = 0; i < kProcessEventCount; i++) {
+        counters.totals[i] = (baseline ? 0 : counters.totals[i]) + deltas[i];
+    }
+    if (baseline) {
+        counters.has_baseline = true;
+        return true;
+    }
+    
+    counters.cycles = deltas[0];
+    counters.instructions = deltas[1];
+    counters.llc_misses = deltas[2];
+    counters.branch_misses = deltas[3];
+    counters.ipc = counters.cycles > 0 ? (double)counters.instructions / counters.cycles : 0.0;
+    if (counters.instructions > 0) {
+        counters.llc_mpki = 1000.0 * counters.llc_misses / counters.instructions;
+        counters.branch_mpki = 1000.0 * counters.branch_misses / counters.instructions;
+    } else {
+        counters.llc_mpki = 0.0;
+        counters.branch_mpki = 0.0;
+    }
+    counters.valid = true;
+    return true;
+}
+
+void PerfMonitor::updateProcessCounters(const std::vector<pid_t>& pids) {
+    // Detach processes that left the set so the fd count stays bounded
+    std::vector<pid_t> stale;
+    for (const auto& [pid, counters] : process_counters_) {
+        if (std::find(pids.begin(), pids.end(), pid) == pids.end()) {
+            stale.push_back(pid);
+        }
+    }
+    for (pid_t pid : stale) {
+        detachProcess(pid);
+    }
+    
+    for (pid_t pid : pids) {
+        attachProcess(pid);
+    }
+    
+    for (auto& [pid, counters] : process_counters_) {
+        if (!readProcessCounters(counters)) {
+            counters.valid = false;
+        }
+    }
+}
+
 bool PerfMonitor::update() {
+    // CPU hotplug: system-wide counters hold one fd per CPU, so reopen them on
+    // the new set and restart the baseline; per-thread counters follow their tasks
+    if (initialized_ && target_pid_ <= 0 && Topology::instance().getGeneration() != topology_generation_) {
+        closeCounters();
+        initialized_ = false;
+        first_reading_ = true;
+    }
+    
     if (!initialized_) {
         if (!initialize()) {
             return false;
@@ -139,25 +732,30 @@ bool PerfMonitor::update() {
     // Store previous reading
     previous_ = current_;
     
+    auto now = std::chrono::steady_clock::now();
+    interval_seconds_ = std::chrono::duration<double>(now - last_sample_).count();
+    last_sample_ = now;
+    
 #ifdef __linux__
     // Read performance counters
-    for (const auto& [event_name, index] : perf_events_) {
-        if (perf_fds_[index] < 0) continue;
-        
-        uint64_t count;
-        if (read(perf_fds_[index], &count, sizeof(count)) != sizeof(count)) {
-            continue;
+    for (size_t i = 0; i < builtin_counters_.size(); i++) {
+        if (readCounter(builtin_counters_[i])) {
+            current_.*(kBuiltinEvents[i].field) = builtin_counters_[i].value;
+        }
+    }
+    
+    for (size_t i = 0; i + 1 < cache_counters_.size(); i += 2) {
+        if (!cache_counters_[i].fds.empty()) {
+            readCachePair(cache_counters_[i], cache_counters_[i + 1]);
+        } else {
+            readCounter(cache_counters_[i + 1]);
+        }
+    }
+    
+    for (auto& handle : custom_counters_) {
+        if (readCounter(handle) && !first_reading_ && interval_seconds_ > 0.0) {
+            handle.rate = handle.scale * (handle.value - handle.previous) / interval_seconds_;
         }
-        
-        // Update current counters
-        if (event_name == "cpu_cycles") current_.cpu_cycles = count;
-        else if (event_name == "instructions") current_.instructions = count;
-        else if (event_name == "cache_references") current_.cache_references = count;
-        else if (event_name == "cache_misses") current_.cache_misses = count;
-        else if (event_name == "branch_instructions") current_.branch_instructions = count;
-        else if (event_name == "branch_misses") current_.branch_misses = count;
-        else if (event_name == "context_switches") current_.context_switches = count;
-        else if (event_name == "page_faults") current_.page_faults = count;
     }
 #else
     // On non-Linux platforms, simulate some basic metrics
@@ -185,6 +783,16 @@ bool PerfMonitor::update() {
     return true;
 }
 
+double PerfMonitor::getMemoryBandwidth() const {
+    double total = 0.0;
+    for (const auto& handle : custom_counters_) {
+        if (handle.is_memory_bandwidth) {
+            total += handle.rate;
+        }
+    }
+    return total;
+}
+
 void PerfMonitor::calculateMetrics() {
     // Calculate IPC (Instructions Per Cycle)
     unsigned long long cycles_delta = current_.cpu_cycles - previous_.cpu_cycles;
@@ -217,8 +825,107 @@ void PerfMonitor::calculateMetrics() {
     }
     
     // Calculate rates (per second)
-    current_.context_switch_rate = current_.context_switches - previous_.context_switches;
-    current_.page_fault_rate = current_.page_faults - previous_.page_faults;
+    double seconds = interval_seconds_ > 0.0 ? interval_seconds_ : 1.0;
+    current_.context_switch_rate = (current_.context_switches - previous_.context_switches) / seconds;
+    current_.page_fault_rate = (current_.page_faults - previous_.page_faults) / seconds;
+    
+    calculateCacheHierarchy();
+}
+
+void PerfMonitor::calculateCacheHierarchy() {
+    unsigned long long instructions_delta = current_.instructions - previous_.instructions;
+    
+    for (size_t level = 0; level < cache_levels_.size(); level++) {
+        auto delta = [&](size_t op, size_t result) -> unsigned long long {
+            const auto& handle = cache_counters_[cacheCounterIndex(level, op, result)];
+            return handle.fds.empty() ? 0 : handle.value - handle.previous;
+        };
+        
+        auto& counters = cache_levels_[level];
+        counters.read_accesses = delta(0, 0);
+        counters.read_misses = delta(0, 1);
+        counters.write_accesses = delta(1, 0);
+        counters.write_misses = delta(1, 1);
+        
+        counters.read_miss_rate = counters.read_accesses > 0
+            ? 100.0 * counters.read_misses / counters.read_accesses
+            : 0.0;
+        counters.mpki = instructions_delta > 0
+            ? 1000.0 * (counters.read_misses + counters.write_misses) / instructions_delta
+            : 0.0;
+    }
+}
+
+double PerfMonitor::getMPKI(const std::string& level) const {
+    for (const auto& counters : cache_levels_) {
+        if (counters.name == level && counters.available) {
+            return counters.mpki;
+        }
+    }
+    return 0.0;
+}
+
+bool PerfMonitor::isCacheThrashing() const {
+    // Prefer LLC misses per instruction; a low hit rate on few references is not thrashing
+    for (const auto& counters : cache_levels_) {
+        if (counters.name == "LLC" && counters.available) {
+            return counters.mpki > kLlcThrashingMpki;
+        }
+    }
+    return current_.cache_references > previous_.cache_references && current_.cache_hit_rate < 80.0;
+}
+
+bool PerfMonitor::isTlbBound() const {
+    return getMPKI("dTLB") > kTlbBoundMpki || getMPKI("iTLB") > kTlbBoundMpki;
+}
+
+void PerfMonitor::printCacheHierarchy() {
+    if (first_reading_) {
+        return;
+    }
+    
+    std::cout << "\n📊 CACHE & TLB HIERARCHY";
+    if (target_pid_ > 0) {
+        std::cout << " (PID " << target_pid_ << ")";
+    }
+    std::cout << std::endl;
+    std::cout << std::left << std::setw(6) << "Level"
+              << std::right << std::setw(14) << "Reads"
+              << std::setw(14) << "Read Misses"
+              << std::setw(9) << "Miss%"
+              << std::setw(14) << "Writes"
+              << std::setw(14) << "Write Misses"
+              << std::setw(9) << "MPKI" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+    
+    for (const auto& counters : cache_levels_) {
+        std::cout << std::left << std::setw(6) << counters.name << std::right;
+        if (!counters.available) {
+            std::cout << std::setw(14) << "n/a" << std::endl;
+            continue;
+        }
+        std::cout << std::setw(14) << counters.read_accesses
+                  << std::setw(14) << counters.read_misses
+                  << std::setw(9) << std::fixed << std::setprecision(2) << counters.read_miss_rate
+                  << std::setw(14) << counters.write_accesses
+                  << std::setw(14) << counters.write_misses
+                  << std::setw(9) << std::fixed << std::setprecision(2) << counters.mpki << std::endl;
+    }
+    
+    // LLC capacity versus TLB reach decides whether hugepages are worth enabling
+    double llc_mpki = getMPKI("LLC");
+    double dtlb_mpki = getMPKI("dTLB");
+    if (isTlbBound() && dtlb_mpki >= llc_mpki) {
+        std::cout << "🔴 TLB REACH LIMITED: dTLB " << std::setprecision(2) << dtlb_mpki
+                  << " MPKI vs LLC " << llc_mpki << " MPKI" << std::endl;
+        std::cout << "   → Impact: Page walks dominate memory stalls" << std::endl;
+        std::cout << "   → Solution: Enable transparent hugepages or hugetlbfs for the hot heap" << std::endl;
+    } else if (llc_mpki > kLlcThrashingMpki) {
+        std::cout << "🔴 LLC CAPACITY LIMITED: " << std::setprecision(2) << llc_mpki
+                  << " MPKI (dTLB " << dtlb_mpki << " MPKI)" << std::endl;
+        std::cout << "   → Impact: Working set exceeds last-level cache, DRAM bound" << std::endl;
+        std::cout << "   → Solution: Shrink the working set or improve locality; hugepages will not help" << std::endl;
+    }
 }
 
 void PerfMonitor::printStats() {
@@ -235,6 +942,20 @@ void PerfMonitor::printStats() {
     std::cout << "Branch Miss Rate:         " << std::setw(8) << current_.branch_miss_rate << "%" << std::endl;
     std::cout << "Context Switches/sec:     " << std::setw(8) << current_.context_switch_rate << std::endl;
     std::cout << "Page Faults/sec:          " << std::setw(8) << current_.page_fault_rate << std::endl;
+    
+    if (!custom_counters_.empty()) {
+        std::cout << "\nUser-Defined Events:" << std::endl;
+        for (const auto& handle : custom_counters_) {
+            std::string unit = handle.unit.empty() ? "events" : handle.unit;
+            std::cout << "  " << std::left << std::setw(40) << handle.name << std::right
+                      << std::setw(14) << handle.rate << " " << unit << "/sec" << std::endl;
+        }
+    }
+    
+    double bandwidth = getMemoryBandwidth();
+    if (bandwidth > 0.0) {
+        std::cout << "Memory Bandwidth (IMC):   " << std::setw(8) << bandwidth << " MiB/sec" << std::endl;
+    }
 }
 
 void PerfMonitor::printAdvancedAnalysis() {
@@ -264,11 +985,14 @@ void PerfMonitor::printAdvancedAnalysis() {
         std::cout << " 🟡 GOOD - Cache performing well" << std::endl;
     } else if (current_.cache_hit_rate > 80.0) {
         std::cout << " 🟠 WARNING - Cache misses increasing, memory pressure" << std::endl;
+    } else if (!isCacheThrashing()) {
+        std::cout << " 🟡 LOW HIT RATE - Miss volume per instruction is low, not thrashing" << std::endl;
     } else {
         std::cout << " 🔴 CRITICAL - Cache thrashing detected!" << std::endl;
         std::cout << "   → Impact: Severe memory bandwidth bottleneck" << std::endl;
         std::cout << "   → Solution: Increase memory, optimize data access patterns" << std::endl;
     }
+    printCacheHierarchy();
     
     // Branch Prediction Analysis
     std::cout << "Branch Miss Rate: " << std::fixed << std::setprecision(1) << current_.branch_miss_rate << "%";
@@ -308,7 +1032,7 @@ void PerfMonitor::printAdvancedAnalysis() {
         has_issues = true;
     }
     
-    if (current_.cache_hit_rate < 85.0) {
+    if (isCacheThrashing()) {
         std::cout << "🔴 MEMORY BOTTLENECK: Cache thrashing indicates memory bandwidth issues" << std::endl;
         has_issues = true;
     }
@@ -0,0 +1,182 @@
+#include "PerfRing.h"
+#include <cstring>
+#include <cerrno>
+#include <ctime>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#endif
+
+PerfRingSet::PerfRingSet(size_t data_pages, bool watermark)
+    : page_size_(sysconf(_SC_PAGESIZE)), data_size_(data_pages * page_size_), watermark_(watermark),
+      lost_events_(0) {
+}
+
+PerfRingSet::~PerfRingSet() {
+    close();
+}
+
+int PerfRingSet::openTracepoint(uint64_t id, int cpu) {
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+
+    attr.type = PERF_TYPE_TRACEPOINT;
+    attr.size = sizeof(attr);
+    attr.config = id;
+    attr.sample_period = 1;
+    attr.sample_type = PERF_SAMPLE_TID | PERF_SAMPLE_TIME | PERF_SAMPLE_RAW;
+    attr.disabled = 1;
+    // CLOCK_MONOTONIC keeps timestamps comparable across CPUs
+    attr.use_clockid = 1;
+    attr.clockid = CLOCK_MONOTONIC;
+    if (watermark_) {
+        attr.watermark = 1;
+        attr.wakeup_watermark = data_size_ / 4;
+    }
+
+    return syscall(__NR_perf_event_open, &attr, -1, cpu, -1, 0);
+#else
+    (void)id;
+    (void)cpu;
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+bool PerfRingSet::open(const std::vector<int>& cpus, const std::vector<uint64_t>& tracepoint_ids) {
+    close();
+    if (tracepoint_ids.empty()) {
+        return false;
+    }
+
+#ifdef __linux__
+    auto fail = [this]() {
+        int saved_errno = errno;
+        close();
+        errno = saved_errno;
+        return false;
+    };
+
+    for (int cpu : cpus) {
+        // The first tracepoint owns the ring; the rest redirect into it
+        int leader = openTracepoint(tracepoint_ids[0], cpu);
+        if (leader < 0) {
+            return fail();
+        }
+        fds_.push_back(leader);
+
+        void* base = mmap(nullptr, page_size_ + data_size_, PROT_READ | PROT_WRITE, MAP_SHARED, leader, 0);
+        if (base == MAP_FAILED) {
+            return fail();
+        }
+        rings_.push_back(Ring{leader, base});
+
+        for (size_t i = 1; i < tracepoint_ids.size(); i++) {
+            int fd = openTracepoint(tracepoint_ids[i], cpu);
+            if (fd < 0) {
+                return fail();
+            }
+            fds_.push_back(fd);
+            if (ioctl(fd, PERF_EVENT_IOC_SET_OUTPUT, leader) < 0) {
+                return fail();
+            }
+        }
+    }
+
+    cpus_ = cpus;
+    return !rings_.empty();
+#else
+    (void)cpus;
+    errno = ENOSYS;
+    return false;
+#endif
+}
+
+bool PerfRingSet::enable() {
+#ifdef __linux__
+    for (int fd : fds_) {
+        if (ioctl(fd, PERF_EVENT_IOC_ENABLE, 0) < 0) {
+            return false;
+        }
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+void PerfRingSet::close() {
+#ifdef __linux__
+    for (const auto& ring : rings_) {
+        munmap(ring.base, page_size_ + data_size_);
+    }
+#endif
+    for (int fd : fds_) {
+        ::close(fd);
+    }
+    rings_.clear();
+    fds_.clear();
+    cpus_.clear();
+}
+
+void PerfRingSet::drain(size_t ring, const std::function<void(const uint8_t*, size_t)>& on_sample) {
+#ifdef __linux__
+    auto* meta = static_cast<perf_event_mmap_page*>(rings_[ring].base);
+    const uint8_t* data = static_cast<const uint8_t*>(rings_[ring].base) + page_size_;
+
+    uint64_t head = __atomic_load_n(&meta->data_head, __ATOMIC_ACQUIRE);
+    uint64_t tail = meta->data_tail;
+
+    while (tail < head) {
+        size_t offset = tail % data_size_;
+        perf_event_header header;
+        if (offset + sizeof(header) <= data_size_) {
+            memcpy(&header, data + offset, sizeof(header));
+        } else {
+            size_t first = data_size_ - offset;
+            memcpy(&header, data + offset, first);
+            memcpy(reinterpret_cast<uint8_t*>(&header) + first, data, sizeof(header) - first);
+        }
+        if (header.size == 0) {
+            break;
+        }
+
+        // Records may wrap around the end of the ring
+        const uint8_t* record = data + offset;
+        if (offset + header.size > data_size_) {
+            scratch_.resize(header.size);
+            size_t first = data_size_ - offset;
+            memcpy(scratch_.data(), data + offset, first);
+            memcpy(scratch_.data() + first, data, header.size - first);
+            record = scratch_.data();
+        }
+
+        if (header.type == PERF_RECORD_SAMPLE) {
+            on_sample(record, header.size);
+        } else if (header.type == PERF_RECORD_LOST && header.size >= sizeof(header) + 2 * sizeof(uint64_t)) {
+            // header, u64 id, u64 lost
+            uint64_t lost;
+            memcpy(&lost, record + sizeof(header) + sizeof(uint64_t), sizeof(lost));
+            lost_events_ += lost;
+        }
+
+        tail += header.size;
+    }
+
+    __atomic_store_n(&meta->data_tail, tail, __ATOMIC_RELEASE);
+#else
+    (void)ring;
+    (void)on_sample;
+#endif
+}
+
+void PerfRingSet::drainAll(const std::function<void(const uint8_t*, size_t)>& on_sample) {
+    for (size_t ring = 0; ring < rings_.size(); ring++) {
+        drain(ring, on_sample);
+    }
+}
@@ -0,0 +1,409 @@
+#include "PmuCatalog.h"
+#include "SysfsUtil.h"
+#include "Topology.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+namespace {
+
+const char* kEventSourceRoot = "/sys/bus/event_source/devices";
+
+// perf_event_attr.type values fixed by the ABI
+const uint32_t kTypeSoftware = 1;
+const uint32_t kTypeTracepoint = 2;
+const uint32_t kTypeRaw = 4;
+
+std::string trim(const std::string& s) {
+    size_t start = s.find_first_not_of(" \t\n");
+    if (start == std::string::npos) return "";
+    size_t end = s.find_last_not_of(" \t\n");
+    return s.substr(start, end - start + 1);
+}
+
+bool parseNumber(const std::string& text, uint64_t& value) {
+    if (text.empty()) return false;
+    try {
+        size_t consumed = 0;
+        value = std::stoull(text, &consumed, 0);  // Accepts 0x.., 0.. and decimal
+        return consumed == text.size();
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+const char* kindName(PmuKind kind) {
+    switch (kind) {
+        case PmuKind::Core: return "core";
+        case PmuKind::Software: return "software";
+        case PmuKind::Tracepoint: return "tracepoint";
+        case PmuKind::Uncore: return "uncore";
+        case PmuKind::Other: return "other";
+    }
+    return "other";
+}
+
+} // namespace
+
+PmuCatalog::PmuCatalog() {
+    // tracefs moved out of debugfs in 4.1; accept either mount point
+    if (std::filesystem::exists("/sys/kernel/tracing/events")) {
+        tracing_root_ = "/sys/kernel/tracing";
+    } else {
+        tracing_root_ = "/sys/kernel/debug/tracing";
+    }
+}
+
+bool PmuCatalog::discover() {
+    pmus_.clear();
+
+#ifdef __linux__
+    try {
+        if (!std::filesystem::exists(kEventSourceRoot)) {
+            std::cerr << "No PMUs found under " << kEventSourceRoot << std::endl;
+            return false;
+        }
+
+        for (const auto& entry : std::filesystem::directory_iterator(kEventSourceRoot)) {
+            parsePmu(entry.path().filename().string(), entry.path().string());
+        }
+    } catch (const std::filesystem::filesystem_error& e) {
+        std::cerr << "Error scanning " << kEventSourceRoot << ": " << e.what() << std::endl;
+        return false;
+    }
+
+    return !pmus_.empty();
+#else
+    return false;
+#endif
+}
+
+bool PmuCatalog::parsePmu(const std::string& name, const std::string& path) {
+    uint64_t type = 0;
+    if (!parseNumber(trim(readFirstLine(path + "/type")), type)) {
+        return false;
+    }
+
+    PmuInfo pmu;
+    pmu.name = name;
+    pmu.type = static_cast<uint32_t>(type);
+
+    // Uncore PMUs publish the CPUs they must be opened on in "cpumask";
+    // hybrid core PMUs (cpu_core/cpu_atom, armv8_*) use "cpus"
+    std::string cpumask = trim(readFirstLine(path + "/cpumask"));
+    std::string cpus = trim(readFirstLine(path + "/cpus"));
+    if (!cpumask.empty()) {
+        pmu.cpus = Topology::parseCpuList(cpumask);
+    } else if (!cpus.empty()) {
+        pmu.cpus = Topology::parseCpuList(cpus);
+    }
+
+    // Classify
+    if (pmu.type == kTypeSoftware) {
+        pmu.kind = PmuKind::Software;
+    } else if (pmu.type == kTypeTracepoint) {
+        pmu.kind = PmuKind::Tracepoint;
+    } else if (pmu.type == kTypeRaw || name == "cpu" || name.rfind("cpu_", 0) == 0 ||
+               name.rfind("armv", 0) == 0 || !cpus.empty()) {
+        pmu.kind = PmuKind::Core;
+    } else if (name.rfind("uncore", 0) == 0 || !cpumask.empty()) {
+        pmu.kind = PmuKind::Uncore;
+    } else {
+        pmu.kind = PmuKind::Other;
+    }
+
+    std::error_code ec;
+
+    // Format terms: how "event=", "umask=", ... map onto config bits
+    for (const auto& entry : std::filesystem::directory_iterator(path + "/format", ec)) {
+        PmuFormatField field;
+        if (parseFormatField(trim(readFirstLine(entry.path().string())), field)) {
+            pmu.format[entry.path().filename().string()] = field;
+        }
+    }
+
+    // Named events; .scale and .unit are sidecar files of the same alias
+    for (const auto& entry : std::filesystem::directory_iterator(path + "/events", ec)) {
+        std::string alias = entry.path().filename().string();
+        if (alias.find('.') != std::string::npos) continue;
+
+        PmuEventAlias event;
+        event.name = alias;
+        event.terms = trim(readFirstLine(entry.path().string()));
+        event.scale = 1.0;
+        std::string scale = trim(readFirstLine(entry.path().string() + ".scale"));
+        if (!scale.empty()) {
+            try {
+                event.scale = std::stod(scale);
+            } catch (const std::exception&) {
+                event.scale = 1.0;
+            }
+        }
+        event.unit = trim(readFirstLine(entry.path().string() + ".unit"));
+        pmu.events[alias] = event;
+    }
+
+    pmus_[name] = pmu;
+    return true;
+}
+
+bool PmuCatalog::parseFormatField(const std::string& text, PmuFormatField& field) const {
+    // "config:0-7", "config1:0-15,32-47", "config:21"
+    size_t colon = text.find(':');
+    if (colon == std::string::npos) return false;
+
+    std::string word = text.substr(0, colon);
+    if (word == "config") field.config_word = 0;
+    else if (word == "config1") field.config_word = 1;
+    else if (word == "config2") field.config_word = 2;
+    else return false;
+
+    field.ranges.clear();
+    std::istringstream iss(text.substr(colon + 1));
+    std::string range;
+    while (std::getline(iss, range, ',')) {
+        size_t dash = range.find('-');
+        try {
+            if (dash == std::string::npos) {
+                int bit = std::stoi(range);
+                field.ranges.push_back({bit, bit});
+            } else {
+                field.ranges.push_back({std::stoi(range.substr(0, dash)),
+                                        std::stoi(range.substr(dash + 1))});
+            }
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+
+    return !field.ranges.empty();
+}
+
+const PmuInfo* PmuCatalog::findPmu(const std::string& name) const {
+    auto it = pmus_.find(name);
+    return it != pmus_.end() ? &it->second : nullptr;
+}
+
+std::vector<const PmuInfo*> PmuCatalog::findPmuInstances(const std::string& name) const {
+    std::vector<const PmuInfo*> result;
+
+    if (const PmuInfo* exact = findPmu(name)) {
+        result.push_back(exact);
+        return result;
+    }
+
+    // "uncore_imc" expands to uncore_imc_0, uncore_imc_1, ... (one per box)
+    for (const auto& [pmu_name, pmu] : pmus_) {
+        if (pmu_name.size() <= name.size() + 1 || pmu_name.compare(0, name.size(), name) != 0 ||
+            pmu_name[name.size()] != '_') {
+            continue;
+        }
+        std::string suffix = pmu_name.substr(name.size() + 1);
+        if (std::all_of(suffix.begin(), suffix.end(), ::isdigit)) {
+            result.push_back(&pmu);
+        }
+    }
+
+    return result;
+}
+
+bool PmuCatalog::applyTerms(const PmuInfo& pmu, const std::string& terms,
+                            PerfEventTarget& target, std::string& error) const {
+    uint64_t* words[3] = {&target.config, &target.config1, &target.config2};
+
+    std::istringstream iss(terms);
+    std::string term;
+    while (std::getline(iss, term, ',')) {
+        term = trim(term);
+        if (term.empty()) continue;
+
+        std::string key = term;
+        uint64_t value = 1;  // A bare term such as "edge" means term=1
+        size_t eq = term.find('=');
+        if (eq != std::string::npos) {
+            key = term.substr(0, eq);
+            if (!parseNumber(term.substr(eq + 1), value)) {
+                error = "bad value in term '" + term + "'";
+                return false;
+            }
+        }
+
+        // Raw config words are always accepted
+        if (key == "config" || key == "config1" || key == "config2") {
+            *words[key == "config" ? 0 : (key == "config1" ? 1 : 2)] = value;
+            continue;
+        }
+
+        auto field_it = pmu.format.find(key);
+        if (field_it == pmu.format.end()) {
+            error = "PMU '" + pmu.name + "' has no format term '" + key + "'";
+            return false;
+        }
+
+        // Spread the value across the field's bit ranges, low bits first
+        const PmuFormatField& field = field_it->second;
+        uint64_t remaining = value;
+        for (const auto& [lo, hi] : field.ranges) {
+            int width = hi - lo + 1;
+            uint64_t mask = width >= 64 ? ~0ULL : ((1ULL << width) - 1);
+            *words[field.config_word] |= (remaining & mask) << lo;
+            remaining = width >= 64 ? 0 : (remaining >> width);
+        }
+        if (remaining != 0) {
+            error = "value of '" + key + "' does not fit its format field";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool PmuCatalog::parseEventSpec(const std::string& spec, PerfEventDesc& desc, std::string& error) const {
+    desc = PerfEventDesc{spec, 1.0, "", {}};
+
+    // Tracepoint: "sched:sched_switch"
+    size_t first_slash = spec.find('/');
+    if (first_slash == std::string::npos) {
+        size_t colon = spec.find(':');
+        if (colon == std::string::npos) {
+            error = "expected 'pmu/terms/' or 'subsystem:event'";
+            return false;
+        }
+        uint64_t id = 0;
+        if (!resolveTracepoint(spec.substr(0, colon), spec.substr(colon + 1), id)) {
+            error = "unknown tracepoint '" + spec + "'";
+            return false;
+        }
+        desc.targets.push_back(PerfEventTarget{"tracepoint", kTypeTracepoint, id, 0, 0, {}});
+        return true;
+    }
+
+    // PMU event: "cpu/event=0xd1,umask=0x20/" or "uncore_imc/cas_count_read/"
+    size_t last_slash = spec.rfind('/');
+    if (last_slash == first_slash || last_slash != spec.size() - 1) {
+        error = "PMU event spec must look like 'pmu/terms/'";
+        return false;
+    }
+
+    std::string pmu_name = spec.substr(0, first_slash);
+    std::string body = spec.substr(first_slash + 1, last_slash - first_slash - 1);
+
+    std::vector<const PmuInfo*> instances = findPmuInstances(pmu_name);
+    if (instances.empty()) {
+        error = "unknown PMU '" + pmu_name + "'";
+        return false;
+    }
+
+    // Pull out "name=" before resolving, it is not a hardware term
+    std::string terms;
+    std::istringstream iss(body);
+    std::string term;
+    while (std::getline(iss, term, ',')) {
+        if (term.rfind("name=", 0) == 0) {
+            desc.name = term.substr(5);
+        } else {
+            terms += (terms.empty() ? "" : ",") + term;
+        }
+    }
+
+    for (const PmuInfo* pmu : instances) {
+        PerfEventTarget target{pmu->name, pmu->type, 0, 0, 0, pmu->cpus};
+
+        // A single term with no '=' that matches an alias is a named event
+        std::string resolved = terms;
+        auto alias_it = pmu->events.find(terms);
+        if (alias_it != pmu->events.end()) {
+            resolved = alias_it->second.terms;
+            desc.scale = alias_it->second.scale;
+            desc.unit = alias_it->second.unit;
+        }
+
+        if (!applyTerms(*pmu, resolved, target, error)) {
+            return false;
+        }
+
+        desc.targets.push_back(target);
+    }
+
+    return true;
+}
+
+bool PmuCatalog::resolveTracepoint(const std::string& subsystem, const std::string& event, uint64_t& id) const {
+    std::string text = trim(readFirstLine(tracing_root_ + "/events/" + subsystem + "/" + event + "/id"));
+    return parseNumber(text, id);
+}
+
+bool PmuCatalog::resolveTracepointField(const std::string& subsystem, const std::string& event,
+                                        const std::string& field, TracepointField& result) const {
+    std::ifstream format_file(tracing_root_ + "/events/" + subsystem + "/" + event + "/format");
+    if (!format_file.is_open()) {
+        return false;
+    }
+
+    // "\tfield:pid_t prev_pid;\toffset:24;\tsize:4;\tsigned:1;"
+    std::string line;
+    while (std::getline(format_file, line)) {
+        size_t decl = line.find("field:");
+        size_t semi = line.find(';');
+        if (decl == std::string::npos || semi == std::string::npos) continue;
+
+        std::string declaration = line.substr(decl + 6, semi - decl - 6);
+        size_t bracket = declaration.find('[');
+        if (bracket != std::string::npos) {
+            declaration = declaration.substr(0, bracket);
+        }
+        size_t name_start = declaration.find_last_of(" *");
+        std::string name = name_start == std::string::npos ? declaration : declaration.substr(name_start + 1);
+        if (name != field) continue;
+
+        auto attribute = [&line](const std::string& key) -> int {
+            size_t pos = line.find(key + ":");
+            return pos == std::string::npos ? -1 : std::atoi(line.c_str() + pos + key.size() + 1);
+        };
+        result.offset = attribute("offset");
+        result.size = attribute("size");
+        result.is_signed = attribute("signed") == 1;
+        return result.offset >= 0 && result.size > 0;
+    }
+
+    return false;
+}
+
+void PmuCatalog::printCatalog() const {
+    std::cout << "\n🔍 PMU EVENT CATALOG" << std::endl;
+    std::cout << "─────────────────────────────────────────────────────────────────────" << std::endl;
+
+    if (pmus_.empty()) {
+        std::cout << "No PMUs discovered" << std::endl;
+        return;
+    }
+
+    for (const auto& [name, pmu] : pmus_) {
+        std::cout << std::left << std::setw(28) << name
+                  << " type=" << std::setw(4) << pmu.type
+                  << " " << std::setw(11) << kindName(pmu.kind)
+                  << " terms=" << std::setw(3) << pmu.format.size()
+                  << " events=" << pmu.events.size();
+        if (!pmu.cpus.empty() && pmu.kind == PmuKind::Uncore) {
+            std::cout << " cpumask=" << pmu.cpus.size() << " CPU(s)";
+        }
+        std::cout << std::endl;
+
+        for (const auto& [alias, event] : pmu.events) {
+            std::cout << "    " << name << "/" << alias << "/";
+            if (!event.unit.empty()) {
+                std::cout << " [" << event.unit << "]";
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    std::cout << std::endl;
+    std::cout << "Usage: --event <pmu>/<alias>/ or --event <pmu>/event=0x..,umask=0x../ "
+              << "or --event <subsystem>:<tracepoint>" << std::endl;
+}
@@ -0,0 +1,361 @@
+#include "PressureMonitor.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <fstream>
+#include <ctime>
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+
+namespace {
+
+const char* kResourceNames[PSI_RESOURCE_COUNT] = {"cpu", "memory", "io", "irq"};
+
+// Stall events kept for printStallEvents()/getRecentEvents()
+const size_t kMaxRecordedEvents = 256;
+
+// Default thresholds: 150ms of stall within any 1s window
+const unsigned long kDefaultStallUs = 150000;
+const unsigned long kDefaultWindowUs = 1000000;
+
+// Window granularity the kernel enforces for unprivileged triggers
+const unsigned long kUnprivilegedWindowUs = 2000000;
+
+std::string pressurePath(PressureResource resource) {
+    return std::string("/proc/pressure/") + kResourceNames[resource];
+}
+
+} // namespace
+
+PressureMonitor::PressureMonitor()
+    : stats_{}, epoll_fd_(-1), stop_fd_(-1), pending_events_{}, running_(false),
+      first_reading_(true), initialized_(false) {
+    for (int i = 0; i < PSI_RESOURCE_COUNT; i++) {
+        stats_[i].name = kResourceNames[i];
+    }
+}
+
+PressureMonitor::~PressureMonitor() {
+    running_ = false;
+#ifdef __linux__
+    if (stop_fd_ >= 0) {
+        uint64_t one = 1;
+        if (write(stop_fd_, &one, sizeof(one)) < 0) {
+            // Nothing else can wake the thread; join below would block
+        }
+    }
+#endif
+    if (trigger_thread_.joinable()) {
+        trigger_thread_.join();
+    }
+    for (const auto& handle : triggers_) {
+        close(handle.fd);
+    }
+    if (epoll_fd_ >= 0) close(epoll_fd_);
+    if (stop_fd_ >= 0) close(stop_fd_);
+}
+
+const char* PressureMonitor::resourceName(PressureResource resource) {
+    return kResourceNames[resource];
+}
+
+bool PressureMonitor::readPressureFile(const std::string& path, PressureLine& some, PressureLine& full, bool& has_full) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // Format: "some avg10=0.00 avg60=0.00 avg300=0.00 total=0"
+    bool has_some = false;
+    has_full = false;
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream iss(line);
+        std::string kind, field;
+        iss >> kind;
+
+        PressureLine parsed{};
+        while (iss >> field) {
+            size_t eq = field.find('=');
+            if (eq == std::string::npos) continue;
+            std::string key = field.substr(0, eq);
+            const char* value = field.c_str() + eq + 1;
+            if (key == "avg10") parsed.avg10 = std::strtod(value, nullptr);
+            else if (key == "avg60") parsed.avg60 = std::strtod(value, nullptr);
+            else if (key == "avg300") parsed.avg300 = std::strtod(value, nullptr);
+            else if (key == "total") parsed.total_us = std::strtoull(value, nullptr, 10);
+        }
+
+        if (kind == "some") {
+            some = parsed;
+            has_some = true;
+        } else if (kind == "full") {
+            full = parsed;
+            has_full = true;
+        }
+    }
+
+    return has_some;
+}
+
+void PressureMonitor::addTrigger(PressureResource resource, bool full, unsigned long stall_us, unsigned long window_us) {
+    requested_.push_back(PressureTrigger{resource, full, stall_us, window_us});
+}
+
+bool PressureMonitor::registerTrigger(const PressureTrigger& trigger) {
+#ifdef __linux__
+    int fd = open(pressurePath(trigger.resource).c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    // The kernel parses "<some|full> <stall us> <window us>" including the NUL
+    std::string spec = std::string(trigger.full ? "full " : "some ") +
+                       std::to_string(trigger.stall_us) + " " + std::to_string(trigger.window_us);
+    ssize_t written = write(fd, spec.c_str(), spec.size() + 1);
+    if (written < 0 && errno == EINVAL && trigger.window_us > 0 && trigger.window_us % kUnprivilegedWindowUs != 0) {
+        // Without CAP_SYS_RESOURCE the window must be a multiple of 2s; keep the stall ratio
+        unsigned long window_us = (trigger.window_us / kUnprivilegedWindowUs + 1) * kUnprivilegedWindowUs;
+        unsigned long stall_us = (unsigned long)((double)trigger.stall_us * window_us / trigger.window_us);
+        spec = std::string(trigger.full ? "full " : "some ") +
+               std::to_string(stall_us) + " " + std::to_string(window_us);
+        written = write(fd, spec.c_str(), spec.size() + 1);
+    }
+    if (written < 0) {
+        std::cerr << "Failed to register PSI trigger '" << spec << "' on "
+                  << kResourceNames[trigger.resource] << ": " << strerror(errno) << std::endl;
+        close(fd);
+        return false;
+    }
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLPRI;
+    ev.data.u32 = triggers_.size();
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        close(fd);
+        return false;
+    }
+
+    triggers_.push_back(TriggerHandle{fd, trigger});
+    return true;
+#else
+    (void)trigger;
+    return false;
+#endif
+}
+
+bool PressureMonitor::initialize() {
+    if (initialized_) {
+        return true;
+    }
+
+    bool any_available = false;
+    for (int i = 0; i < PSI_RESOURCE_COUNT; i++) {
+        auto& stats = stats_[i];
+        stats.available = readPressureFile(pressurePath((PressureResource)i), stats.some, stats.full, stats.has_full);
+        any_available = any_available || stats.available;
+    }
+    if (!any_available) {
+        std::cout << "⚠️  PSI not available (kernel needs CONFIG_PSI, or boot with psi=1)" << std::endl;
+        return false;
+    }
+
+#ifdef __linux__
+    if (requested_.empty()) {
+        for (PressureResource resource : {PSI_CPU, PSI_MEMORY, PSI_IO}) {
+            requested_.push_back(PressureTrigger{resource, false, kDefaultStallUs, kDefaultWindowUs});
+        }
+        requested_.push_back(PressureTrigger{PSI_MEMORY, true, kDefaultStallUs / 2, kDefaultWindowUs});
+    }
+
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    stop_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd_ >= 0 && stop_fd_ >= 0) {
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.u32 = UINT32_MAX;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, stop_fd_, &ev);
+
+        for (const auto& trigger : requested_) {
+            if (stats_[trigger.resource].available) {
+                registerTrigger(trigger);
+            }
+        }
+    }
+
+    if (!triggers_.empty()) {
+        running_ = true;
+        trigger_thread_ = std::thread(&PressureMonitor::triggerLoop, this);
+    }
+#endif
+
+    initialized_ = true;
+    last_update_ = std::chrono::steady_clock::now();
+    std::cout << "✅ PressureMonitor initialized with " << triggers_.size() << " PSI triggers" << std::endl;
+    return true;
+}
+
+void PressureMonitor::triggerLoop() {
+#ifdef __linux__
+    // Blocks in the kernel until a threshold is crossed; no periodic wakeups
+    struct epoll_event events[8];
+    while (running_) {
+        int n = epoll_wait(epoll_fd_, events, 8, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        for (int i = 0; i < n; i++) {
+            uint32_t index = events[i].data.u32;
+            if (index == UINT32_MAX) {
+                return;
+            }
+            if (index >= triggers_.size()) continue;
+
+            if (events[i].events & EPOLLERR) {
+                // Pressure file went away (e.g. cgroup removed); stop watching it
+                epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, triggers_[index].fd, nullptr);
+                continue;
+            }
+            if (events[i].events & EPOLLPRI) {
+                recordEvent(triggers_[index].trigger);
+            }
+        }
+    }
+#endif
+}
+
+void PressureMonitor::recordEvent(const PressureTrigger& trigger) {
+    PressureEvent event{std::chrono::system_clock::now(), trigger.resource, trigger.full, 0.0};
+
+    PressureLine some{}, full{};
+    bool has_full = false;
+    if (readPressureFile(pressurePath(trigger.resource), some, full, has_full)) {
+        event.avg10 = trigger.full ? full.avg10 : some.avg10;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_.push_back(event);
+    if (events_.size() > kMaxRecordedEvents) {
+        events_.pop_front();
+    }
+    pending_events_[trigger.resource]++;
+}
+
+bool PressureMonitor::update() {
+    if (!initialized_) {
+        return false;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    double interval_us = std::chrono::duration<double, std::micro>(now - last_update_).count();
+    last_update_ = now;
+
+    for (int i = 0; i < PSI_RESOURCE_COUNT; i++) {
+        auto& stats = stats_[i];
+        if (!stats.available) continue;
+
+        PressureLine some{}, full{};
+        bool has_full = false;
+        if (!readPressureFile(pressurePath((PressureResource)i), some, full, has_full)) {
+            continue;
+        }
+
+        if (!first_reading_ && interval_us > 0.0) {
+            stats.some_percent = 100.0 * (some.total_us - stats.some.total_us) / interval_us;
+            stats.full_percent = has_full ? 100.0 * (full.total_us - stats.full.total_us) / interval_us : 0.0;
+        }
+        stats.some = some;
+        stats.full = full;
+        stats.has_full = has_full;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (int i = 0; i < PSI_RESOURCE_COUNT; i++) {
+            stats_[i].trigger_events = pending_events_[i];
+            pending_events_[i] = 0;
+        }
+    }
+
+    first_reading_ = false;
+    return true;
+}
+
+std::vector<PressureEvent> PressureMonitor::getRecentEvents() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::vector<PressureEvent>(events_.begin(), events_.end());
+}
+
+void PressureMonitor::printStats() {
+    if (!initialized_) {
+        return;
+    }
+
+    std::cout << "\n=== Pressure Stall Information ===" << std::endl;
+    std::cout << std::left << std::setw(10) << "RESOURCE"
+              << std::right << std::setw(10) << "SOME%"
+              << std::setw(10) << "FULL%"
+              << std::setw(10) << "AVG10"
+              << std::setw(10) << "AVG60"
+              << std::setw(10) << "EVENTS" << std::endl;
+    std::cout << std::string(60, '-') << std::endl;
+
+    for (const auto& stats : stats_) {
+        if (!stats.available) continue;
+        std::cout << std::left << std::setw(10) << stats.name
+                  << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(10) << stats.some_percent;
+        if (stats.has_full) {
+            std::cout << std::setw(10) << stats.full_percent;
+        } else {
+            std::cout << std::setw(10) << "-";
+        }
+        std::cout << std::setw(10) << std::setprecision(2) << stats.some.avg10
+                  << std::setw(10) << stats.some.avg60
+                  << std::setw(10) << stats.trigger_events << std::endl;
+    }
+}
+
+void PressureMonitor::printStallEvents(int count) {
+    std::vector<PressureEvent> events = getRecentEvents();
+    if (events.empty()) {
+        std::cout << "✅ NO STALL EVENTS - No PSI trigger has fired" << std::endl;
+        return;
+    }
+
+    std::cout << "\n⏱️  RECENT STALL EVENTS (" << events.size() << " recorded)" << std::endl;
+    int start = std::max(0, (int)events.size() - count);
+    for (size_t i = start; i < events.size(); i++) {
+        const auto& event = events[i];
+        std::time_t t = std::chrono::system_clock::to_time_t(event.time);
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(event.time.time_since_epoch()).count() % 1000;
+        std::tm tm_buf;
+        localtime_r(&t, &tm_buf);
+
+        std::cout << "  " << std::put_time(&tm_buf, "%H:%M:%S") << "." << std::setw(3) << std::setfill('0') << ms
+                  << std::setfill(' ') << "  " << std::left << std::setw(7) << kResourceNames[event.resource]
+                  << std::setw(5) << (event.full ? "full" : "some") << std::right
+                  << " avg10=" << std::fixed << std::setprecision(2) << event.avg10 << std::endl;
+    }
+
+    for (const auto& stats : stats_) {
+        if (stats.trigger_events > 0) {
+            std::cout << "🔴 " << stats.name << " STALL: threshold crossed " << stats.trigger_events
+                      << " times this interval (" << std::fixed << std::setprecision(1)
+                      << stats.some_percent << "% of time stalled)" << std::endl;
+        }
+    }
+}
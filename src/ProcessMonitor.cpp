@@ -1,4 +1,5 @@
 #include "ProcessMonitor.h"
+#include "PerfMonitor.h"
 #include <iostream>
 #include <iomanip>
 #include <sstream>
@@ -6,7 +7,18 @@
 #include <algorithm>
 #include <unistd.h>
 
-ProcessMonitor::ProcessMonitor() : first_reading_(true) {
+namespace {
+
+// Processes below this CPU usage are not worth a counter group
+const double kMinCpuForCounters = 1.0;
+
+// CPU% distribution: 2% relative error, idle intervals below 0.01% counted as zero
+const double kCpuAccuracy = 0.02;
+const double kMinCpuPercent = 0.01;
+
+} // namespace
+
+ProcessMonitor::ProcessMonitor() : first_reading_(true), perf_monitor_(nullptr), perf_top_n_(0) {
     last_update_ = std::chrono::steady_clock::now();
 }
 
@@ -30,18 +42,53 @@ bool ProcessMonitor::update() {
     // Remove dead processes
     for (auto it = process_stats_.begin(); it != process_stats_.end();) {
         if (!isProcessAlive(it->first)) {
+            cpu_distribution_.erase(it->first);
             it = process_stats_.erase(it);
         } else {
             ++it;
         }
     }
     
+    if (perf_monitor_ && !first_reading_) {
+        updateHardwareCounters();
+    }
+    
     first_reading_ = false;
     last_update_ = std::chrono::steady_clock::now();
     
     return true;
 }
 
+void ProcessMonitor::attachPerfCounters(PerfMonitor* perf_monitor, int top_n) {
+    perf_monitor_ = perf_monitor;
+    perf_top_n_ = top_n;
+}
+
+void ProcessMonitor::updateHardwareCounters() {
+    std::vector<pid_t> targets;
+    for (pid_t pid : getTopCPUProcesses(perf_top_n_)) {
+        if (process_stats_[pid].cpu_usage_percent >= kMinCpuForCounters) {
+            targets.push_back(pid);
+        }
+    }
+    
+    perf_monitor_->updateProcessCounters(targets);
+    
+    for (auto& [pid, stats] : process_stats_) {
+        stats.has_hw_counters = false;
+    }
+    for (const auto& [pid, counters] : perf_monitor_->getProcessCounters()) {
+        auto it = process_stats_.find(pid);
+        if (it == process_stats_.end() || !counters.valid) {
+            continue;
+        }
+        it->second.ipc = counters.ipc;
+        it->second.llc_mpki = counters.llc_mpki;
+        it->second.branch_mpki = counters.branch_mpki;
+        it->second.has_hw_counters = true;
+    }
+}
+
 std::vector<pid_t> ProcessMonitor::discoverProcesses() {
     std::vector<pid_t> processes;
     
@@ -227,6 +274,7 @@ void ProcessMonitor::calculateProcessMetrics(pid_t pid) {
     // Calculate CPU usage percentage
     unsigned long total_time = (current.utime - previous.utime) + (current.stime - previous.stime);
     current.cpu_usage_percent = total_time / 100.0; // Rough percentage
+    cpu_distribution_.try_emplace(pid, kCpuAccuracy, kMinCpuPercent).first->second.add(current.cpu_usage_percent);
     
     // Calculate memory usage
     current.memory_usage_mb = current.rss * 4.0 / 1024.0; // RSS in pages, convert to MB
@@ -308,9 +356,14 @@ void ProcessMonitor::printTopProcesses(int count) {
     std::cout << std::left << std::setw(8) << "PID" 
               << std::setw(20) << "COMMAND" 
               << std::setw(10) << "CPU%" 
-              << std::setw(12) << "MEMORY(MB)" 
-              << std::setw(15) << "STATUS" << std::endl;
-    std::cout << std::string(70, '-') << std::endl;
+              << std::setw(9) << "P50%"
+              << std::setw(9) << "P99%"
+              << std::setw(12) << "MEMORY(MB)";
+    if (perf_monitor_) {
+        std::cout << std::setw(8) << "IPC" << std::setw(10) << "LLC_MPKI" << std::setw(10) << "BR_MPKI";
+    }
+    std::cout << std::setw(15) << "STATUS" << std::endl;
+    std::cout << std::string(perf_monitor_ ? 116 : 88, '-') << std::endl;
     
     for (pid_t pid : top_cpu) {
         const auto& stats = process_stats_[pid];
@@ -321,9 +374,22 @@ void ProcessMonitor::printTopProcesses(int count) {
         
         std::cout << std::left << std::setw(8) << stats.pid
                   << std::setw(20) << stats.comm.substr(0, 19)
-                  << std::setw(10) << std::fixed << std::setprecision(1) << stats.cpu_usage_percent
-                  << std::setw(12) << std::fixed << std::setprecision(1) << stats.memory_usage_mb
-                  << std::setw(15) << status << std::endl;
+                  << std::setw(10) << std::fixed << std::setprecision(1) << stats.cpu_usage_percent;
+        const CpuSketch* distribution = getCpuDistribution(pid);
+        if (distribution) {
+            std::cout << std::setw(9) << distribution->p50() << std::setw(9) << distribution->p99();
+        } else {
+            std::cout << std::setw(9) << "-" << std::setw(9) << "-";
+        }
+        std::cout << std::setw(12) << std::fixed << std::setprecision(1) << stats.memory_usage_mb;
+        if (perf_monitor_ && stats.has_hw_counters) {
+            std::cout << std::setw(8) << std::setprecision(2) << stats.ipc
+                      << std::setw(10) << std::setprecision(1) << stats.llc_mpki
+                      << std::setw(10) << std::setprecision(1) << stats.branch_mpki;
+        } else if (perf_monitor_) {
+            std::cout << std::setw(8) << "-" << std::setw(10) << "-" << std::setw(10) << "-";
+        }
+        std::cout << std::setw(15) << status << std::endl;
     }
     
     // Top Memory processes
@@ -421,10 +487,20 @@ void ProcessMonitor::printProcessDetails(pid_t pid) {
     std::cout << "Virtual Memory: " << (stats.vsize / 1024 / 1024) << " MB" << std::endl;
     std::cout << "Resident Memory: " << std::fixed << std::setprecision(1) << stats.memory_usage_mb << " MB" << std::endl;
     std::cout << "CPU Usage: " << std::fixed << std::setprecision(1) << stats.cpu_usage_percent << "%" << std::endl;
+    if (const CpuSketch* distribution = getCpuDistribution(pid)) {
+        std::cout << "CPU p50/p90/p99/p99.9: " << distribution->p50() << " / " << distribution->p90() << " / "
+                  << distribution->p99() << " / " << distribution->p999() << "% over " << distribution->count()
+                  << " intervals" << std::endl;
+    }
     std::cout << "Cache Hit Rate: " << std::fixed << std::setprecision(1) << stats.cache_hit_rate << "%" << std::endl;
     std::cout << "I/O Efficiency: " << std::fixed << std::setprecision(1) << stats.io_efficiency << " bytes/syscall" << std::endl;
     std::cout << "Context Switches/sec: " << stats.context_switch_rate << std::endl;
     std::cout << "Page Faults/sec: " << stats.page_fault_rate << std::endl;
+    if (stats.has_hw_counters) {
+        std::cout << "IPC: " << std::fixed << std::setprecision(2) << stats.ipc << std::endl;
+        std::cout << "LLC MPKI: " << std::fixed << std::setprecision(1) << stats.llc_mpki << std::endl;
+        std::cout << "Branch MPKI: " << std::fixed << std::setprecision(1) << stats.branch_mpki << std::endl;
+    }
 }
 
 ProcessStats ProcessMonitor::getProcessStats(pid_t pid) const {
@@ -471,6 +547,11 @@ std::vector<pid_t> ProcessMonitor::getTopMemoryProcesses(int count) const {
     return result;
 }
 
+const CpuSketch* ProcessMonitor::getCpuDistribution(pid_t pid) const {
+    auto it = cpu_distribution_.find(pid);
+    return it != cpu_distribution_.end() ? &it->second : nullptr;
+}
+
 std::vector<pid_t> ProcessMonitor::getTopIOProcesses(int count) const {
     std::vector<std::pair<pid_t, double>> io_usage;
     
@@ -0,0 +1,549 @@
+#include "SchedMonitor.h"
+#include "Topology.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <ctime>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <poll.h>
+#endif
+
+namespace {
+
+// Ring buffer data pages per CPU (must be a power of two)
+const size_t kRingPages = 64;
+
+// Forget per-thread state rather than grow without bound on fork-heavy hosts
+const size_t kMaxTrackedTasks = 1 << 18;
+
+// Records can still be in flight when a ring is drained; events this close to
+// the drain time wait for the next batch unless their ring has passed them
+const uint64_t kInFlightNs = 1000000;
+// Held-back events beyond this are replayed anyway rather than grow unbounded
+const size_t kMaxPendingEvents = 1 << 20;
+
+// sched_switch prev_state bits (TASK_REPORT encoding)
+const long kStateInterruptible = 0x1;
+const long kStateUninterruptible = 0x2;
+const long kStateMask = 0xff;
+
+const double kHighTailLatencyUs = 1000.0;
+
+const char* kReasonNames[OFFCPU_REASON_COUNT] = {"I/O", "LOCK", "SLEEP", "RUNQ"};
+
+long readField(const uint8_t* raw, uint32_t raw_size, const TracepointField& field) {
+    if (field.offset < 0 || (uint32_t)(field.offset + field.size) > raw_size) {
+        return 0;
+    }
+    switch (field.size) {
+        case 4: {
+            int32_t value;
+            memcpy(&value, raw + field.offset, sizeof(value));
+            return value;
+        }
+        case 8: {
+            int64_t value;
+            memcpy(&value, raw + field.offset, sizeof(value));
+            return (long)value;
+        }
+        default:
+            return 0;
+    }
+}
+
+} // namespace
+
+// LatencyHistogram implementation
+void LatencyHistogram::add(unsigned long long ns) {
+    unsigned long long us = ns / 1000;
+    size_t bucket = 0;
+    while (us > 1 && bucket < buckets.size() - 1) {
+        us >>= 1;
+        bucket++;
+    }
+    buckets[bucket]++;
+    count++;
+    total_ns += ns;
+    max_ns = std::max(max_ns, ns);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < buckets.size(); i++) {
+        buckets[i] += other.buckets[i];
+    }
+    count += other.count;
+    total_ns += other.total_ns;
+    max_ns = std::max(max_ns, other.max_ns);
+}
+
+double LatencyHistogram::meanUs() const {
+    return count > 0 ? total_ns / 1000.0 / count : 0.0;
+}
+
+double LatencyHistogram::percentileUs(double percentile) const {
+    if (count == 0) {
+        return 0.0;
+    }
+    unsigned long long target = (unsigned long long)(count * percentile / 100.0);
+    unsigned long long seen = 0;
+    for (size_t i = 0; i < buckets.size(); i++) {
+        seen += buckets[i];
+        if (seen > target) {
+            return std::min((double)(1ULL << (i + 1)), max_ns / 1000.0);
+        }
+    }
+    return max_ns / 1000.0;
+}
+
+SchedMonitor::SchedMonitor()
+    : switch_id_(0), wakeup_id_(0), wakeup_new_id_(0), futex_enter_id_(0), futex_exit_id_(0),
+      prev_pid_field_{-1, 0, false}, prev_state_field_{-1, 0, false}, prev_comm_field_{-1, 0, false},
+      next_pid_field_{-1, 0, false}, wakee_pid_field_{-1, 0, false},
+      rings_(kRingPages, true), stop_fd_(-1), topology_generation_(0),
+      running_(false), initialized_(false) {
+}
+
+void SchedMonitor::stopCollector() {
+    running_ = false;
+#ifdef __linux__
+    if (stop_fd_ >= 0) {
+        uint64_t one = 1;
+        if (write(stop_fd_, &one, sizeof(one)) < 0) {
+            // Collector still exits on its poll timeout
+        }
+    }
+#endif
+    if (collector_.joinable()) {
+        collector_.join();
+    }
+#ifdef __linux__
+    // Reset the eventfd so a restarted collector does not wake immediately
+    uint64_t count;
+    if (stop_fd_ >= 0 && read(stop_fd_, &count, sizeof(count)) < 0) {
+        // Nothing was written
+    }
+#endif
+}
+
+bool SchedMonitor::openRings() {
+    // sched_switch owns the ring; the other tracepoints redirect into it
+    std::vector<uint64_t> ids{switch_id_, wakeup_id_};
+    for (uint64_t id : {wakeup_new_id_, futex_enter_id_, futex_exit_id_}) {
+        if (id != 0) ids.push_back(id);
+    }
+    topology_generation_ = Topology::instance().getGeneration();
+    return rings_.open(Topology::instance().getOnlineCpus(), ids) && rings_.enable();
+}
+
+SchedMonitor::~SchedMonitor() {
+    stopCollector();
+    rings_.close();
+    if (stop_fd_ >= 0) {
+        close(stop_fd_);
+    }
+}
+
+bool SchedMonitor::resolveLayout() {
+    if (!catalog_.resolveTracepoint("sched", "sched_switch", switch_id_) ||
+        !catalog_.resolveTracepoint("sched", "sched_wakeup", wakeup_id_)) {
+        std::cerr << "sched tracepoints not found (is tracefs mounted?)" << std::endl;
+        return false;
+    }
+    catalog_.resolveTracepoint("sched", "sched_wakeup_new", wakeup_new_id_);
+
+    if (!catalog_.resolveTracepointField("sched", "sched_switch", "prev_pid", prev_pid_field_) ||
+        !catalog_.resolveTracepointField("sched", "sched_switch", "prev_state", prev_state_field_) ||
+        !catalog_.resolveTracepointField("sched", "sched_switch", "prev_comm", prev_comm_field_) ||
+        !catalog_.resolveTracepointField("sched", "sched_switch", "next_pid", next_pid_field_) ||
+        !catalog_.resolveTracepointField("sched", "sched_wakeup", "pid", wakee_pid_field_)) {
+        std::cerr << "Unexpected sched tracepoint format" << std::endl;
+        return false;
+    }
+
+    // Optional: lets S-state sleeps inside futex() be reported as lock waits
+    if (!catalog_.resolveTracepoint("syscalls", "sys_enter_futex", futex_enter_id_) ||
+        !catalog_.resolveTracepoint("syscalls", "sys_exit_futex", futex_exit_id_)) {
+        futex_enter_id_ = 0;
+        futex_exit_id_ = 0;
+    }
+
+    return true;
+}
+
+bool SchedMonitor::initialize() {
+    if (initialized_) {
+        return true;
+    }
+
+#ifdef __linux__
+    if (!resolveLayout()) {
+        return false;
+    }
+
+    if (!openRings()) {
+        std::cerr << "Failed to open sched tracepoints: " << strerror(errno) << std::endl;
+        rings_.close();
+        return false;
+    }
+
+    if (stop_fd_ < 0) {
+        stop_fd_ = eventfd(0, EFD_NONBLOCK);
+    }
+    running_ = true;
+    collector_ = std::thread(&SchedMonitor::collectorLoop, this);
+
+    initialized_ = true;
+    std::cout << "✅ SchedMonitor tracing sched_switch/sched_wakeup on " << rings_.size() << " CPUs"
+              << (futex_enter_id_ ? " (futex waits classified as locks)" : "") << std::endl;
+    return true;
+#else
+    std::cout << "⚠️  Scheduler tracepoints not available on this platform" << std::endl;
+    return false;
+#endif
+}
+
+void SchedMonitor::collectorLoop() {
+#ifdef __linux__
+    std::vector<pollfd> pfds;
+    for (size_t ring = 0; ring < rings_.size(); ring++) {
+        pfds.push_back(pollfd{rings_.fd(ring), POLLIN, 0});
+    }
+    if (stop_fd_ >= 0) {
+        pfds.push_back(pollfd{stop_fd_, POLLIN, 0});
+    }
+
+    // Rings are per CPU, so a wakeup on one CPU can be drained a batch after
+    // the switch-in it precedes on another. Watermark merge: an event is
+    // replayed only once every ring has moved past its timestamp; newer ones
+    // wait in pending for the next batch.
+    std::vector<SchedEvent> pending;
+    std::vector<uint64_t> ring_last(rings_.size(), 0);
+    auto by_time = [](const SchedEvent& a, const SchedEvent& b) { return a.time < b.time; };
+    while (running_) {
+        poll(pfds.data(), pfds.size(), 200);
+
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        uint64_t drained_at = now.tv_sec * 1000000000ULL + now.tv_nsec;
+        // A ring empty at drain time can only produce events after it, bar records in flight
+        uint64_t idle_bound = drained_at > kInFlightNs ? drained_at - kInFlightNs : 0;
+
+        uint64_t watermark = ~0ULL;
+        for (size_t ring = 0; ring < rings_.size(); ring++) {
+            bool drained = false;
+            rings_.drain(ring, [&](const uint8_t* record, size_t size) {
+                SchedEvent event;
+                if (decodeSample(record, size, event)) {
+                    pending.push_back(event);
+                    ring_last[ring] = std::max(ring_last[ring], event.time);
+                    drained = true;
+                }
+            });
+            watermark = std::min(watermark, drained ? ring_last[ring] : std::max(ring_last[ring], idle_bound));
+        }
+
+        std::sort(pending.begin(), pending.end(), by_time);
+        auto ready = pending.size() > kMaxPendingEvents
+                     ? pending.end()
+                     : std::partition_point(pending.begin(), pending.end(),
+                                            [watermark](const SchedEvent& event) { return event.time <= watermark; });
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto it = pending.begin(); it != ready; ++it) {
+                handleEvent(*it);
+            }
+        }
+        pending.erase(pending.begin(), ready);
+    }
+#endif
+}
+
+bool SchedMonitor::decodeSample(const uint8_t* record, size_t size, SchedEvent& event) const {
+    // PERF_SAMPLE_TID | PERF_SAMPLE_TIME | PERF_SAMPLE_RAW layout:
+    // header, u32 pid, u32 tid, u64 time, u32 raw_size, raw[raw_size]
+    const size_t fixed = 8 + 4 + 4 + 8 + 4;
+    if (size < fixed + 2) {
+        return false;
+    }
+
+    uint32_t pid, tid, raw_size;
+    memcpy(&pid, record + 8, sizeof(pid));
+    memcpy(&tid, record + 12, sizeof(tid));
+    memcpy(&event.time, record + 16, sizeof(event.time));
+    memcpy(&raw_size, record + 24, sizeof(raw_size));
+    if (fixed + raw_size > size) {
+        return false;
+    }
+
+    const uint8_t* raw = record + fixed;
+    memcpy(&event.type, raw, sizeof(event.type));  // common_type is the tracepoint id
+    event.tgid = pid;
+    event.tid = tid;
+    event.prev_pid = 0;
+    event.prev_state = 0;
+    event.next_pid = 0;
+    event.wakee = 0;
+    event.comm[0] = '\0';
+
+    if (event.type == switch_id_) {
+        event.prev_pid = readField(raw, raw_size, prev_pid_field_);
+        event.prev_state = readField(raw, raw_size, prev_state_field_);
+        event.next_pid = readField(raw, raw_size, next_pid_field_);
+        if (prev_comm_field_.offset >= 0 && (uint32_t)(prev_comm_field_.offset + 16) <= raw_size) {
+            memcpy(event.comm, raw + prev_comm_field_.offset, sizeof(event.comm));
+            event.comm[sizeof(event.comm) - 1] = '\0';
+        }
+    } else if (event.type == wakeup_id_ || event.type == wakeup_new_id_) {
+        event.wakee = readField(raw, raw_size, wakee_pid_field_);
+    }
+
+    return true;
+}
+
+pid_t SchedMonitor::resolveTgid(pid_t tid) {
+    auto it = tgid_cache_.find(tid);
+    if (it != tgid_cache_.end()) {
+        return it->second;
+    }
+
+    pid_t tgid = tid;
+    std::ifstream status_file("/proc/" + std::to_string(tid) + "/status");
+    std::string line;
+    while (std::getline(status_file, line)) {
+        if (line.rfind("Tgid:", 0) == 0) {
+            tgid = std::atoi(line.c_str() + 5);
+            break;
+        }
+    }
+
+    tgid_cache_[tid] = tgid;
+    return tgid;
+}
+
+ProcessSchedStats& SchedMonitor::windowStats(pid_t tid) {
+    pid_t tgid = resolveTgid(tid);
+    auto& stats = window_[tgid];
+    if (stats.comm.empty()) {
+        stats.tgid = tgid;
+        auto comm_it = comm_cache_.find(tgid);
+        if (comm_it != comm_cache_.end()) {
+            stats.comm = comm_it->second;
+        } else {
+            std::ifstream comm_file("/proc/" + std::to_string(tgid) + "/comm");
+            std::getline(comm_file, stats.comm);
+            if (stats.comm.empty()) stats.comm = "?";
+            comm_cache_[tgid] = stats.comm;
+        }
+    }
+    return stats;
+}
+
+void SchedMonitor::handleEvent(const SchedEvent& event) {
+    if (tasks_.size() > kMaxTrackedTasks) {
+        tasks_.clear();
+        tgid_cache_.clear();
+        comm_cache_.clear();
+    }
+
+    if (event.type == switch_id_) {
+        // The sampled task is prev, so the sample carries prev's tgid for free
+        if (event.prev_pid != 0) {
+            tgid_cache_[event.prev_pid] = event.tgid;
+            if (event.prev_pid == event.tgid && event.comm[0] != '\0') {
+                comm_cache_[event.tgid] = event.comm;
+            }
+
+            TaskState& prev = tasks_[event.prev_pid];
+            prev.off_since = event.time;
+            long state = event.prev_state & kStateMask;
+            if (state == 0) {
+                // Preempted while runnable: the whole gap is run-queue wait
+                prev.reason = OFFCPU_RUN_QUEUE;
+                prev.ready_since = event.time;
+            } else if (state & kStateUninterruptible) {
+                prev.reason = OFFCPU_IO;
+                prev.ready_since = 0;
+            } else {
+                prev.reason = (prev.in_futex && (state & kStateInterruptible)) ? OFFCPU_LOCK : OFFCPU_SLEEP;
+                prev.ready_since = 0;
+            }
+            windowStats(event.prev_pid).switches++;
+        }
+
+        if (event.next_pid != 0) {
+            auto it = tasks_.find(event.next_pid);
+            if (it != tasks_.end() && it->second.off_since > 0 && event.time >= it->second.off_since) {
+                TaskState& next = it->second;
+                ProcessSchedStats& stats = windowStats(event.next_pid);
+
+                if (next.ready_since >= next.off_since && next.ready_since > 0) {
+                    if (next.reason != OFFCPU_RUN_QUEUE) {
+                        stats.offcpu_ns[next.reason] += next.ready_since - next.off_since;
+                    }
+                    unsigned long long wait = event.time - next.ready_since;
+                    stats.offcpu_ns[OFFCPU_RUN_QUEUE] += wait;
+                    stats.runq_latency.add(wait / 1000.0);
+                    window_latency_.add(wait);
+                    window_runq_.add(wait / 1000.0);
+                } else {
+                    // Wakeup not seen (lost or before tracing started)
+                    stats.offcpu_ns[next.reason] += event.time - next.off_since;
+                }
+
+                next.off_since = 0;
+                next.ready_since = 0;
+            }
+        }
+    } else if (event.type == wakeup_id_ || event.type == wakeup_new_id_) {
+        if (event.wakee == 0) return;
+        TaskState& task = tasks_[event.wakee];
+        if (task.off_since == 0) {
+            // New task, or one that never switched out while traced
+            task.off_since = event.time;
+            task.reason = OFFCPU_RUN_QUEUE;
+        }
+        if (task.ready_since == 0) {
+            task.ready_since = event.time;
+        }
+    } else if (futex_enter_id_ != 0 && event.type == futex_enter_id_) {
+        tasks_[event.tid].in_futex = true;
+    } else if (futex_exit_id_ != 0 && event.type == futex_exit_id_) {
+        tasks_[event.tid].in_futex = false;
+    }
+}
+
+bool SchedMonitor::update() {
+    if (!initialized_) {
+        return false;
+    }
+
+    // CPU hotplug: reopen the per-CPU rings; the collector polls their fds
+    if (Topology::instance().getGeneration() != topology_generation_) {
+        stopCollector();
+        if (!openRings()) {
+            // No rings to poll: stay stopped rather than spin on an empty set
+            std::cerr << "Failed to reopen sched tracepoints after CPU hotplug: " << strerror(errno) << std::endl;
+            rings_.close();
+            initialized_ = false;
+            return false;
+        }
+        running_ = true;
+        collector_ = std::thread(&SchedMonitor::collectorLoop, this);
+    }
+
+    // Publish the interval collected since the last update
+    std::lock_guard<std::mutex> lock(mutex_);
+    process_stats_ = std::move(window_);
+    window_.clear();
+    system_latency_ = window_latency_;
+    window_latency_ = LatencyHistogram();
+    system_runq_ = window_runq_;
+    window_runq_.reset();
+
+    return true;
+}
+
+void SchedMonitor::printStats() {
+    if (!initialized_) {
+        return;
+    }
+
+    std::array<unsigned long long, OFFCPU_REASON_COUNT> totals{};
+    for (const auto& [tgid, stats] : process_stats_) {
+        for (size_t i = 0; i < totals.size(); i++) {
+            totals[i] += stats.offcpu_ns[i];
+        }
+    }
+
+    std::cout << "\n=== Scheduler Latency ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Run-Queue Wakeups:    " << std::setw(10) << system_latency_.count << std::endl;
+    std::cout << "Run-Queue p50/p90:    " << std::setw(10) << system_runq_.p50() << " / "
+              << system_runq_.p90() << " us" << std::endl;
+    std::cout << "Run-Queue p99/p99.9:  " << std::setw(10) << system_runq_.p99() << " / "
+              << system_runq_.p999() << " us" << std::endl;
+    std::cout << "Run-Queue Max:        " << std::setw(10) << system_latency_.max_ns / 1000.0 << " us" << std::endl;
+    std::cout << "Off-CPU Time (ms):   ";
+    for (size_t i = 0; i < totals.size(); i++) {
+        std::cout << " " << kReasonNames[i] << "=" << totals[i] / 1e6;
+    }
+    std::cout << std::endl;
+    if (rings_.getLostEvents() > 0) {
+        std::cout << "Lost Events:          " << std::setw(10) << rings_.getLostEvents() << std::endl;
+    }
+}
+
+void SchedMonitor::printLatencyAnalysis(int count) {
+    if (!initialized_) {
+        return;
+    }
+
+    std::cout << "\n🔍 SCHEDULER LATENCY ANALYSIS" << std::endl;
+    std::cout << "─────────────────────────────────────────────────────────────────────" << std::endl;
+
+    // Run-queue latency distribution, runqlat style
+    std::cout << "📊 RUN-QUEUE LATENCY HISTOGRAM" << std::endl;
+    unsigned long long peak = *std::max_element(system_latency_.buckets.begin(), system_latency_.buckets.end());
+    for (size_t i = 0; i < system_latency_.buckets.size(); i++) {
+        unsigned long long n = system_latency_.buckets[i];
+        if (n == 0) continue;
+        unsigned long long low = i == 0 ? 0 : (1ULL << i);
+        int bar = peak > 0 ? (int)(40 * n / peak) : 0;
+        std::cout << std::right << std::setw(9) << low << " -> " << std::setw(9) << ((1ULL << (i + 1)) - 1)
+                  << " us : " << std::setw(9) << n << " |" << std::string(bar, '*') << std::endl;
+    }
+
+    // Worst processes by tail latency
+    std::vector<const ProcessSchedStats*> ranked;
+    for (const auto& [tgid, stats] : process_stats_) {
+        if (stats.runq_latency.count() >= 10) {
+            ranked.push_back(&stats);
+        }
+    }
+    std::sort(ranked.begin(), ranked.end(), [](const auto* a, const auto* b) {
+        return a->runq_latency.p99() > b->runq_latency.p99();
+    });
+
+    std::cout << "\n⏱️  TOP PROCESSES BY P99 RUN-QUEUE LATENCY" << std::endl;
+    std::cout << std::left << std::setw(8) << "PID"
+              << std::setw(16) << "COMMAND"
+              << std::right << std::setw(9) << "P50(us)"
+              << std::setw(10) << "P99(us)"
+              << std::setw(10) << "MAX(us)"
+              << std::setw(9) << "IO(ms)"
+              << std::setw(9) << "LOCK(ms)"
+              << std::setw(10) << "SLEEP(ms)"
+              << std::setw(9) << "RUNQ(ms)" << std::endl;
+    std::cout << std::string(90, '-') << std::endl;
+
+    for (size_t i = 0; i < ranked.size() && (int)i < count; i++) {
+        const auto& stats = *ranked[i];
+        std::cout << std::left << std::setw(8) << stats.tgid
+                  << std::setw(16) << stats.comm.substr(0, 15)
+                  << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(9) << stats.runq_latency.p50()
+                  << std::setw(10) << stats.runq_latency.p99()
+                  << std::setw(10) << stats.runq_latency.max()
+                  << std::setprecision(1)
+                  << std::setw(9) << stats.offcpu_ns[OFFCPU_IO] / 1e6
+                  << std::setw(9) << stats.offcpu_ns[OFFCPU_LOCK] / 1e6
+                  << std::setw(10) << stats.offcpu_ns[OFFCPU_SLEEP] / 1e6
+                  << std::setw(9) << stats.offcpu_ns[OFFCPU_RUN_QUEUE] / 1e6 << std::endl;
+    }
+
+    double p99 = system_runq_.p99();
+    if (p99 > kHighTailLatencyUs) {
+        std::cout << "🔴 HIGH TAIL SCHEDULING LATENCY: p99 " << std::fixed << std::setprecision(0)
+                  << p99 << " us to get on a CPU after wakeup" << std::endl;
+        std::cout << "   → Impact: Latency-sensitive threads wait behind other runnable work" << std::endl;
+        std::cout << "   → Solution: Reduce CPU oversubscription, isolate or pin critical threads" << std::endl;
+    }
+}
@@ -0,0 +1,443 @@
+#include "SlabMonitor.h"
+#include "SysfsUtil.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+const std::string kSysfsSlabRoot = "/sys/kernel/slab/";
+const int kSysfsRescanEvery = 30;              // Updates between /sys/kernel/slab walks
+
+// Leak detector: steady, near-linear growth sustained over minutes
+const size_t kHistorySamples = 120;
+const double kSampleSpacingSec = 5.0;          // At most one history point per 5s
+const double kLeakMinSpanSec = 120.0;
+const size_t kLeakMinSamples = 8;
+const double kLeakMinBytesPerMin = 256.0 * 1024;
+const double kLeakMinR2 = 0.8;
+const double kLeakQuietSec = 60.0;             // No change for a minute clears the suspicion
+
+unsigned long parseNumber(const char*& p, const char* end) {
+    while (p < end && *p == ' ') p++;
+    unsigned long value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10 + (*p++ - '0');
+    }
+    return value;
+}
+
+double toMb(double bytes) {
+    return bytes / (1024.0 * 1024.0);
+}
+
+} // namespace
+
+SlabMonitor::SlabMonitor()
+    : slabinfo_fd_(-1), buffer_(64 * 1024), length_(0), use_sysfs_(false), updates_since_discovery_(0),
+      page_size_(sysconf(_SC_PAGESIZE)), total_bytes_(0), changed_count_(0), first_reading_(true) {
+    start_ = std::chrono::steady_clock::now();
+    last_update_ = start_;
+
+    // /proc/slabinfo is 0400; SLUB exposes the same counters world-readable in sysfs
+    slabinfo_fd_ = open("/proc/slabinfo", O_RDONLY | O_CLOEXEC);
+    if (slabinfo_fd_ < 0 && std::filesystem::exists(kSysfsSlabRoot)) {
+        use_sysfs_ = true;
+        discoverSysfs();
+    }
+}
+
+SlabMonitor::~SlabMonitor() {
+    if (slabinfo_fd_ >= 0) {
+        close(slabinfo_fd_);
+    }
+    for (int fd : sysfs_fds_) {
+        if (fd >= 0) close(fd);
+    }
+}
+
+size_t SlabMonitor::cacheIndex(const std::string& name) {
+    auto it = index_.find(name);
+    if (it != index_.end()) {
+        return it->second;
+    }
+    SlabCache cache{};
+    cache.name = name;
+    caches_.push_back(cache);
+    index_[name] = caches_.size() - 1;
+    return caches_.size() - 1;
+}
+
+const SlabCache* SlabMonitor::findCache(const std::string& name) const {
+    auto it = index_.find(name);
+    return it != index_.end() ? &caches_[it->second] : nullptr;
+}
+
+bool SlabMonitor::update() {
+    auto now_time = std::chrono::steady_clock::now();
+    double interval = std::chrono::duration<double>(now_time - last_update_).count();
+    double now = std::chrono::duration<double>(now_time - start_).count();
+    last_update_ = now_time;
+
+    // Caches created after startup (module loads, new mounts) only appear in a walk
+    if (use_sysfs_ && ++updates_since_discovery_ >= kSysfsRescanEvery) {
+        discoverSysfs();
+    }
+
+    bool ok = use_sysfs_ ? readSysfs(now, first_reading_ ? 0.0 : interval)
+                         : readSlabinfo(now, first_reading_ ? 0.0 : interval);
+    if (!ok) {
+        return false;
+    }
+
+    total_bytes_ = 0;
+    for (auto& cache : caches_) {
+        total_bytes_ += cache.size_bytes;
+        if (cache.leak_suspect && now - cache.last_change > kLeakQuietSec) {
+            cache.leak_suspect = false;
+        }
+    }
+    first_reading_ = false;
+    return true;
+}
+
+bool SlabMonitor::readSlabinfo(double now, double interval_seconds) {
+    if (slabinfo_fd_ < 0) {
+        return false;
+    }
+
+    // Keep the fd open and re-read from offset 0; grow until the whole file fits
+    while (true) {
+        length_ = 0;
+        bool complete = false;
+        while (length_ < buffer_.size()) {
+            ssize_t n = pread(slabinfo_fd_, buffer_.data() + length_, buffer_.size() - length_, length_);
+            if (n < 0) {
+                return false;
+            }
+            if (n == 0) {
+                complete = true;
+                break;
+            }
+            length_ += n;
+        }
+        if (complete) break;
+        buffer_.resize(buffer_.size() * 2);
+    }
+
+    for (auto& cache : caches_) {
+        cache.seen = false;
+    }
+    changed_count_ = 0;
+
+    // name active_objs num_objs objsize objperslab pagesperslab : tunables ... : slabdata active num shared
+    const char* p = buffer_.data();
+    const char* end = p + length_;
+    size_t line_number = 0;
+    while (p < end) {
+        const char* line_end = static_cast<const char*>(memchr(p, '\n', end - p));
+        if (!line_end) line_end = end;
+        const char* line = p;
+        p = line_end + 1;
+        if (line_number++ < 2) {
+            continue;   // Version and column header
+        }
+
+        const char* name_end = line;
+        while (name_end < line_end && *name_end != ' ') name_end++;
+        size_t name_length = name_end - line;
+
+        // Lines come back in the same order, so the cache at this slot usually matches
+        size_t slot = line_number - 3;
+        size_t index;
+        if (slot < caches_.size() && caches_[slot].name.size() == name_length &&
+            memcmp(caches_[slot].name.data(), line, name_length) == 0) {
+            index = slot;
+        } else {
+            index = cacheIndex(std::string(line, name_length));
+        }
+        SlabCache& cache = caches_[index];
+        cache.seen = true;
+
+        const char* q = name_end;
+        unsigned long active_objs = parseNumber(q, line_end);
+        unsigned long num_objs = parseNumber(q, line_end);
+        if (active_objs == cache.active_objs && num_objs == cache.num_objs && !first_reading_) {
+            cache.growth_bytes_per_sec = 0.0;
+            continue;   // Unchanged: skip the rest of the line and the fit
+        }
+
+        cache.active_objs = active_objs;
+        cache.num_objs = num_objs;
+        cache.object_size = parseNumber(q, line_end);
+        cache.objs_per_slab = parseNumber(q, line_end);
+        cache.pages_per_slab = parseNumber(q, line_end);
+        const char* slabdata = static_cast<const char*>(memmem(q, line_end - q, "slabdata", 8));
+        if (slabdata) {
+            q = slabdata + 8;
+            parseNumber(q, line_end);   // active_slabs
+            cache.num_slabs = parseNumber(q, line_end);
+        }
+
+        unsigned long long previous_bytes = cache.size_bytes;
+        cache.size_bytes = static_cast<unsigned long long>(cache.num_slabs) * cache.pages_per_slab * page_size_;
+        recordChange(cache, previous_bytes, now, interval_seconds);
+    }
+
+    dropUnseen();
+    return !caches_.empty();
+}
+
+void SlabMonitor::discoverSysfs() {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    updates_since_discovery_ = 0;
+
+    // Merged caches are ":<flags><size>" directories with named symlinks pointing
+    // at them; report each directory once, under its alphabetically first name
+    // (or the name it was already tracked under, so a rescan keeps its history)
+    std::unordered_map<std::string, std::string> names;   // canonical dir -> name
+    for (const auto& entry : fs::directory_iterator(kSysfsSlabRoot, ec)) {
+        std::string name = entry.path().filename().string();
+        std::string target = fs::canonical(entry.path(), ec).string();
+        if (ec) continue;
+        auto it = names.find(target);
+        if (it == names.end() ||
+            (!index_.count(it->second) &&
+             (index_.count(name) || (it->second[0] == ':' && name[0] != ':') ||
+              (name[0] != ':' && name < it->second)))) {
+            names[target] = name;
+        }
+    }
+
+    for (auto& cache : caches_) {
+        cache.seen = false;
+    }
+    for (const auto& [target, name] : names) {
+        size_t index = cacheIndex(name);
+        SlabCache& cache = caches_[index];
+        cache.seen = true;
+        sysfs_order_.resize(caches_.size());
+        sysfs_fds_.resize(caches_.size(), -1);
+        if (sysfs_fds_[index] >= 0) {
+            continue;   // Known cache, fd still open
+        }
+
+        // object_size is what callers allocate; slab_size adds the free pointer,
+        // redzones and alignment padding of each slot
+        cache.object_size = readUllOr(target + "/object_size");
+        cache.objs_per_slab = readUllOr(target + "/objs_per_slab");
+        unsigned long order = readUllOr(target + "/order");
+        cache.pages_per_slab = 1UL << order;
+        sysfs_order_[index] = order;
+        sysfs_fds_[index] = open((target + "/total_objects").c_str(), O_RDONLY | O_CLOEXEC);
+    }
+    dropUnseen();
+}
+
+bool SlabMonitor::readSysfs(double now, double interval_seconds) {
+    changed_count_ = 0;
+    char text[64];
+    for (size_t i = 0; i < caches_.size(); i++) {
+        SlabCache& cache = caches_[i];
+        if (sysfs_fds_[i] < 0) continue;
+
+        // total_objects is a per-node atomic sum; "objects" and "slabs" walk partial
+        // lists, so they are only read for caches whose total changed
+        ssize_t n = pread(sysfs_fds_[i], text, sizeof(text) - 1, 0);
+        if (n <= 0) continue;
+        text[n] = '\0';
+        unsigned long num_objs = std::strtoul(text, nullptr, 10);
+        cache.seen = true;
+        if (num_objs == cache.num_objs && !first_reading_) {
+            cache.growth_bytes_per_sec = 0.0;
+            continue;
+        }
+
+        std::string dir = kSysfsSlabRoot + cache.name;
+        cache.num_objs = num_objs;
+        cache.active_objs = readUllOr(dir + "/objects");
+        cache.num_slabs = readUllOr(dir + "/slabs");
+
+        unsigned long long previous_bytes = cache.size_bytes;
+        cache.size_bytes = static_cast<unsigned long long>(cache.num_slabs) * cache.pages_per_slab * page_size_;
+        recordChange(cache, previous_bytes, now, interval_seconds);
+    }
+    return !caches_.empty();
+}
+
+void SlabMonitor::recordChange(SlabCache& cache, unsigned long long previous_bytes, double now, double interval_seconds) {
+    changed_count_++;
+    cache.last_change = now;
+    cache.growth_bytes_per_sec = interval_seconds > 0.0
+        ? (static_cast<double>(cache.size_bytes) - static_cast<double>(previous_bytes)) / interval_seconds
+        : 0.0;
+
+    if (!cache.history.empty() && now - cache.history.back().first < kSampleSpacingSec) {
+        cache.history.back().second = cache.size_bytes;
+    } else {
+        cache.history.emplace_back(now, cache.size_bytes);
+        if (cache.history.size() > kHistorySamples) {
+            cache.history.pop_front();
+        }
+    }
+
+    // Least-squares fit of size over time; a leak is steady growth, not a burst
+    cache.slope_bytes_per_min = 0.0;
+    cache.fit_r2 = 0.0;
+    size_t n = cache.history.size();
+    if (n < 3) {
+        cache.leak_suspect = false;
+        return;
+    }
+    double sum_t = 0.0, sum_v = 0.0;
+    for (const auto& [t, v] : cache.history) {
+        sum_t += t;
+        sum_v += v;
+    }
+    double mean_t = sum_t / n, mean_v = sum_v / n;
+    double s_tt = 0.0, s_tv = 0.0, s_vv = 0.0;
+    for (const auto& [t, v] : cache.history) {
+        s_tt += (t - mean_t) * (t - mean_t);
+        s_tv += (t - mean_t) * (v - mean_v);
+        s_vv += (v - mean_v) * (v - mean_v);
+    }
+    if (s_tt > 0.0) {
+        cache.slope_bytes_per_min = 60.0 * s_tv / s_tt;
+        cache.fit_r2 = s_vv > 0.0 ? (s_tv * s_tv) / (s_tt * s_vv) : 0.0;
+    }
+
+    double span = cache.history.back().first - cache.history.front().first;
+    cache.leak_suspect = n >= kLeakMinSamples && span >= kLeakMinSpanSec &&
+                         cache.slope_bytes_per_min >= kLeakMinBytesPerMin && cache.fit_r2 >= kLeakMinR2;
+}
+
+void SlabMonitor::dropUnseen() {
+    // Caches vanish when their module unloads; rebuild the index only then.
+    // The sysfs fds are index-aligned with caches_ and compacted alongside
+    if (std::all_of(caches_.begin(), caches_.end(), [](const SlabCache& cache) { return cache.seen; })) {
+        return;
+    }
+    size_t kept = 0;
+    for (size_t i = 0; i < caches_.size(); i++) {
+        if (!caches_[i].seen) {
+            if (i < sysfs_fds_.size() && sysfs_fds_[i] >= 0) close(sysfs_fds_[i]);
+            continue;
+        }
+        if (kept != i) {
+            caches_[kept] = std::move(caches_[i]);
+            if (i < sysfs_fds_.size()) {
+                sysfs_fds_[kept] = sysfs_fds_[i];
+                sysfs_order_[kept] = sysfs_order_[i];
+            }
+        }
+        kept++;
+    }
+    caches_.erase(caches_.begin() + kept, caches_.end());
+    if (sysfs_fds_.size() > kept) {
+        sysfs_fds_.resize(kept);
+        sysfs_order_.resize(kept);
+    }
+    index_.clear();
+    for (size_t i = 0; i < caches_.size(); i++) {
+        index_[caches_[i].name] = i;
+    }
+}
+
+std::vector<const SlabCache*> SlabMonitor::getLeakSuspects() const {
+    std::vector<const SlabCache*> suspects;
+    for (const auto& cache : caches_) {
+        if (cache.leak_suspect) suspects.push_back(&cache);
+    }
+    std::sort(suspects.begin(), suspects.end(), [](const SlabCache* a, const SlabCache* b) {
+        return a->slope_bytes_per_min > b->slope_bytes_per_min;
+    });
+    return suspects;
+}
+
+void SlabMonitor::printStats(int count) {
+    std::cout << "\n🧮 SLAB CACHES (" << (use_sysfs_ ? "/sys/kernel/slab" : "/proc/slabinfo") << ")" << std::endl;
+    std::cout << "─────────────────────────────────────────────────────────────────────" << std::endl;
+
+    if (caches_.empty()) {
+        std::cout << "Slab statistics not available (/proc/slabinfo needs root, /sys/kernel/slab needs SLUB)" << std::endl;
+        return;
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Total: " << toMb(total_bytes_) << " MB in " << caches_.size() << " caches | "
+              << changed_count_ << " changed this interval" << std::endl;
+
+    auto print_table = [](const std::vector<const SlabCache*>& rows) {
+        std::cout << std::left << std::setw(24) << "CACHE"
+                  << std::right << std::setw(11) << "OBJS"
+                  << std::setw(8) << "ACTIVE"
+                  << std::setw(8) << "OBJSIZE"
+                  << std::setw(10) << "SIZE(MB)"
+                  << std::setw(12) << "GROW(KB/s)"
+                  << std::setw(12) << "SLOPE(MB/h)" << "  STATUS" << std::endl;
+        for (const SlabCache* cache : rows) {
+            double active = cache->num_objs > 0 ? 100.0 * cache->active_objs / cache->num_objs : 0.0;
+            std::cout << std::left << std::setw(24) << cache->name.substr(0, 23)
+                      << std::right << std::setw(11) << cache->num_objs
+                      << std::setw(7) << std::setprecision(0) << active << "%"
+                      << std::setw(8) << cache->object_size
+                      << std::setw(10) << std::setprecision(1) << toMb(cache->size_bytes)
+                      << std::setw(12) << cache->growth_bytes_per_sec / 1024.0
+                      << std::setw(12) << toMb(cache->slope_bytes_per_min * 60.0)
+                      << "  " << (cache->leak_suspect ? "🔴 LEAK?" : "") << std::endl;
+        }
+    };
+
+    std::vector<const SlabCache*> by_size;
+    for (const auto& cache : caches_) {
+        by_size.push_back(&cache);
+    }
+    std::sort(by_size.begin(), by_size.end(), [](const SlabCache* a, const SlabCache* b) {
+        return a->size_bytes > b->size_bytes;
+    });
+    if (by_size.size() > static_cast<size_t>(count)) {
+        by_size.resize(count);
+    }
+    print_table(by_size);
+
+    std::vector<const SlabCache*> growing;
+    for (const auto& cache : caches_) {
+        if (cache.growth_bytes_per_sec > 0.0) growing.push_back(&cache);
+    }
+    if (!growing.empty()) {
+        std::sort(growing.begin(), growing.end(), [](const SlabCache* a, const SlabCache* b) {
+            return a->growth_bytes_per_sec > b->growth_bytes_per_sec;
+        });
+        if (growing.size() > 5) {
+            growing.resize(5);
+        }
+        std::cout << "\nFastest growing:" << std::endl;
+        print_table(growing);
+    }
+
+    for (const SlabCache* cache : getLeakSuspects()) {
+        std::cout << "🔴 " << cache->name << " has grown steadily for "
+                  << std::setprecision(0) << (cache->history.back().first - cache->history.front().first) / 60.0
+                  << " min at " << std::setprecision(1) << toMb(cache->slope_bytes_per_min * 60.0)
+                  << " MB/h (fit r² " << std::setprecision(2) << cache->fit_r2 << ")" << std::endl;
+        if (cache->name == "dentry") {
+            // nr_dentry nr_unused age_limit want_pages nr_negative dummy
+            std::ifstream state("/proc/sys/fs/dentry-state");
+            unsigned long nr_dentry = 0, nr_unused = 0, age_limit = 0, want_pages = 0, nr_negative = 0;
+            state >> nr_dentry >> nr_unused >> age_limit >> want_pages >> nr_negative;
+            std::cout << "   dentry-state: " << nr_dentry << " dentries, " << nr_unused << " unused, "
+                      << nr_negative << " negative" << std::endl;
+            std::cout << "   → Solution: Mostly negative/unused dentries are reclaimable cache (lookups of missing files);"
+                      << " otherwise find the process holding them open" << std::endl;
+        } else {
+            std::cout << "   → Solution: Trace allocations with the kmem:kmalloc tracepoint or slub_debug=U,"
+                      << cache->name << " and check alloc_calls" << std::endl;
+        }
+    }
+}
@@ -0,0 +1,324 @@
+#include "SoftirqMonitor.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const char* kTypeNames[SOFTIRQ_TYPE_COUNT] = {
+    "HI", "TIMER", "NET_TX", "NET_RX", "BLOCK", "IRQ_POLL", "TASKLET", "SCHED", "HRTIMER", "RCU"
+};
+
+// NET_RX is concentrated when one CPU handles most of a busy receive load
+const double kConcentratedShare = 0.8;
+const double kConcentratedMinRate = 1000.0;
+
+// Heatmap cells, coldest to hottest
+const char kHeatLevels[] = " .:-=+*#%@";
+const size_t kHeatmapCpusPerLine = 64;
+
+int typeIndex(const std::string& name) {
+    for (int t = 0; t < SOFTIRQ_TYPE_COUNT; t++) {
+        if (name == kTypeNames[t]) return t;
+    }
+    return -1;
+}
+
+char heatCell(double value, double max) {
+    if (value <= 0.0 || max <= 0.0) return kHeatLevels[0];
+    size_t levels = sizeof(kHeatLevels) - 2;
+    size_t level = 1 + (size_t)((value / max) * (levels - 1) + 0.5);
+    return kHeatLevels[std::min(level, levels)];
+}
+
+} // namespace
+
+SoftirqMonitor::SoftirqMonitor() : first_reading_(true) {
+}
+
+bool SoftirqMonitor::update() {
+    previous_counts_ = counts_;
+    previous_softnet_ = softnet_;
+    size_t previous_columns = columns_.size();
+
+    if (!parseSoftirqs()) {
+        return false;
+    }
+    parseSoftnet();
+
+    auto now = std::chrono::steady_clock::now();
+    double interval = std::chrono::duration<double>(now - last_update_).count();
+    last_update_ = now;
+
+    // A CPU set change invalidates the previous snapshot
+    if (first_reading_ || columns_.size() != previous_columns || interval <= 0.0) {
+        rates_.assign(counts_.size(), 0.0);
+        first_reading_ = false;
+        return true;
+    }
+
+    calculateRates(interval);
+    return true;
+}
+
+bool SoftirqMonitor::parseSoftirqs() {
+    std::ifstream file("/proc/softirqs");
+    std::string line;
+    if (!std::getline(file, line)) {
+        return false;
+    }
+
+    // Header: "CPU0 CPU1 ..." (possible CPUs)
+    std::vector<int> columns;
+    std::istringstream header(line);
+    std::string token;
+    while (header >> token) {
+        if (token.compare(0, 3, "CPU") == 0) {
+            columns.push_back(std::atoi(token.c_str() + 3));
+        }
+    }
+    if (columns.empty()) {
+        return false;
+    }
+    if (columns != columns_) {
+        columns_ = columns;
+        softnet_.assign(columns_.size(), SoftnetStats{});
+    }
+
+    counts_.assign(SOFTIRQ_TYPE_COUNT * columns_.size(), 0);
+    while (std::getline(file, line)) {
+        std::istringstream iss(line);
+        std::string name;
+        iss >> name;
+        if (name.empty() || name.back() != ':') continue;
+        name.pop_back();
+
+        int type = typeIndex(name);
+        if (type < 0) continue;
+        uint64_t* row = &counts_[type * columns_.size()];
+        for (size_t c = 0; c < columns_.size() && iss >> row[c]; c++) {
+        }
+    }
+
+    return true;
+}
+
+bool SoftirqMonitor::parseSoftnet() {
+    std::ifstream file("/proc/net/softnet_stat");
+    if (!file.is_open()) {
+        return false;
+    }
+
+    for (auto& stats : softnet_) {
+        stats.processed = stats.dropped = stats.time_squeeze = stats.received_rps = 0;
+    }
+
+    // One hex row per online CPU; kernels since 5.10 append the CPU id as field 13
+    std::string line;
+    size_t row_index = 0;
+    while (std::getline(file, line)) {
+        std::istringstream iss(line);
+        std::vector<uint64_t> fields;
+        std::string field;
+        while (iss >> field) {
+            fields.push_back(std::strtoull(field.c_str(), nullptr, 16));
+        }
+        if (fields.size() < 3) continue;
+
+        size_t column = row_index++;
+        if (fields.size() >= 13) {
+            auto it = std::find(columns_.begin(), columns_.end(), (int)fields[12]);
+            if (it == columns_.end()) continue;
+            column = it - columns_.begin();
+        }
+        if (column >= softnet_.size()) continue;
+
+        SoftnetStats& stats = softnet_[column];
+        stats.processed = fields[0];
+        stats.dropped = fields[1];
+        stats.time_squeeze = fields[2];
+        stats.received_rps = fields.size() > 9 ? fields[9] : 0;
+    }
+
+    return true;
+}
+
+void SoftirqMonitor::calculateRates(double interval_seconds) {
+    rates_.resize(counts_.size());
+    for (size_t i = 0; i < counts_.size(); i++) {
+        // Counters only reset when a CPU comes back online
+        uint64_t delta = counts_[i] >= previous_counts_[i] ? counts_[i] - previous_counts_[i] : 0;
+        rates_[i] = delta / interval_seconds;
+    }
+
+    auto rate = [interval_seconds](uint64_t now, uint64_t before) {
+        return now >= before ? (now - before) / interval_seconds : 0.0;
+    };
+    for (size_t c = 0; c < softnet_.size() && c < previous_softnet_.size(); c++) {
+        SoftnetStats& stats = softnet_[c];
+        const SoftnetStats& before = previous_softnet_[c];
+        stats.processed_rate = rate(stats.processed, before.processed);
+        stats.dropped_rate = rate(stats.dropped, before.dropped);
+        stats.time_squeeze_rate = rate(stats.time_squeeze, before.time_squeeze);
+        stats.received_rps_rate = rate(stats.received_rps, before.received_rps);
+    }
+}
+
+const char* SoftirqMonitor::typeName(SoftirqType type) {
+    return type < SOFTIRQ_TYPE_COUNT ? kTypeNames[type] : "UNKNOWN";
+}
+
+double SoftirqMonitor::getTypeRate(SoftirqType type) const {
+    double total = 0.0;
+    for (size_t c = 0; c < columns_.size(); c++) {
+        total += getRate(type, c);
+    }
+    return total;
+}
+
+std::map<int, double> SoftirqMonitor::getCpuRates(SoftirqType type) const {
+    std::map<int, double> rates;
+    for (size_t c = 0; c < columns_.size(); c++) {
+        rates[columns_[c]] = getRate(type, c);
+    }
+    return rates;
+}
+
+double SoftirqMonitor::getMaxRate(SoftirqType type) const {
+    double max = 0.0;
+    for (size_t c = 0; c < columns_.size(); c++) {
+        max = std::max(max, getRate(type, c));
+    }
+    return max;
+}
+
+double SoftirqMonitor::getDropRate() const {
+    double total = 0.0;
+    for (const auto& stats : softnet_) total += stats.dropped_rate;
+    return total;
+}
+
+double SoftirqMonitor::getTimeSqueezeRate() const {
+    double total = 0.0;
+    for (const auto& stats : softnet_) total += stats.time_squeeze_rate;
+    return total;
+}
+
+int SoftirqMonitor::getHotCpu(SoftirqType type, double* share) const {
+    if (rates_.empty()) {
+        return -1;
+    }
+    double total = getTypeRate(type);
+    if (total <= 0.0) {
+        return -1;
+    }
+
+    size_t hot = 0;
+    for (size_t c = 1; c < columns_.size(); c++) {
+        if (getRate(type, c) > getRate(type, hot)) hot = c;
+    }
+    if (share) {
+        *share = getRate(type, hot) / total;
+    }
+    return columns_[hot];
+}
+
+bool SoftirqMonitor::isNetRxConcentrated() const {
+    double share = 0.0;
+    return columns_.size() > 1 && getHotCpu(SOFTIRQ_NET_RX, &share) >= 0 &&
+           getTypeRate(SOFTIRQ_NET_RX) >= kConcentratedMinRate && share >= kConcentratedShare;
+}
+
+void SoftirqMonitor::printStats() {
+    std::cout << "\n⚡ SOFTIRQ ANALYSIS" << std::endl;
+    std::cout << "─────────────────────────────────────────────────────────────────────" << std::endl;
+
+    if (first_reading_ || rates_.empty()) {
+        std::cout << "Softirq rates (first reading - not available yet)" << std::endl;
+        return;
+    }
+
+    std::cout << std::left << std::setw(10) << "SOFTIRQ"
+              << std::right << std::setw(12) << "TOTAL/s"
+              << std::setw(12) << "MAX CPU/s"
+              << std::setw(9) << "TOP CPU"
+              << std::setw(8) << "SHARE" << std::endl;
+    std::cout << std::string(51, '-') << std::endl;
+
+    for (SoftirqType type : {SOFTIRQ_NET_RX, SOFTIRQ_NET_TX, SOFTIRQ_BLOCK, SOFTIRQ_TIMER, SOFTIRQ_SCHED, SOFTIRQ_RCU}) {
+        double share = 0.0;
+        int hot_cpu = getHotCpu(type, &share);
+        std::cout << std::left << std::setw(10) << typeName(type)
+                  << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(12) << getTypeRate(type)
+                  << std::setw(12) << getMaxRate(type);
+        if (hot_cpu >= 0) {
+            std::cout << std::setw(9) << ("cpu" + std::to_string(hot_cpu))
+                      << std::setw(7) << share * 100.0 << "%";
+        } else {
+            std::cout << std::setw(9) << "-" << std::setw(8) << "-";
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << "Backlog: " << std::setprecision(0) << getDropRate() << " drops/s, "
+              << getTimeSqueezeRate() << " time_squeeze/s" << std::endl;
+
+    if (isNetRxConcentrated()) {
+        double share = 0.0;
+        int hot_cpu = getHotCpu(SOFTIRQ_NET_RX, &share);
+        std::cout << "⚠️  WARNING: " << std::setprecision(0) << share * 100.0 << "% of NET_RX on cpu" << hot_cpu << std::endl;
+        std::cout << "   → Impact: Packet processing bound to one core, receive throughput capped" << std::endl;
+        std::cout << "   → Solution: Enable RSS (ethtool -L) or RPS (/sys/class/net/*/queues/rx-*/rps_cpus)" << std::endl;
+    }
+    if (getDropRate() > 0.0) {
+        std::cout << "🔴 CRITICAL: Backlog drops - packets discarded before the stack" << std::endl;
+        std::cout << "   → Solution: Raise net.core.netdev_max_backlog or spread NET_RX over more CPUs" << std::endl;
+    } else if (getTimeSqueezeRate() > 0.0) {
+        std::cout << "⚠️  WARNING: net_rx_action running out of budget (time_squeeze)" << std::endl;
+        std::cout << "   → Solution: Raise net.core.netdev_budget / netdev_budget_usecs" << std::endl;
+    }
+}
+
+void SoftirqMonitor::printHeatmap() const {
+    if (rates_.empty() || columns_.empty()) {
+        return;
+    }
+
+    std::cout << "Per-CPU heatmap (scaled per row, '" << kHeatLevels[1] << "' low → '"
+              << kHeatLevels[sizeof(kHeatLevels) - 2] << "' row max):" << std::endl;
+
+    const SoftirqType types[] = {SOFTIRQ_NET_RX, SOFTIRQ_NET_TX, SOFTIRQ_BLOCK, SOFTIRQ_TIMER, SOFTIRQ_SCHED, SOFTIRQ_RCU};
+    for (size_t start = 0; start < columns_.size(); start += kHeatmapCpusPerLine) {
+        size_t end = std::min(columns_.size(), start + kHeatmapCpusPerLine);
+        std::cout << std::left << std::setw(10) << ("cpu" + std::to_string(columns_[start]) + "+") << "|";
+        for (size_t c = start; c < end; c++) {
+            std::cout << (char)('0' + columns_[c] % 10);
+        }
+        std::cout << "|" << std::endl;
+
+        for (SoftirqType type : types) {
+            double max = getMaxRate(type);
+            std::cout << std::left << std::setw(10) << typeName(type) << "|";
+            for (size_t c = start; c < end; c++) {
+                std::cout << heatCell(getRate(type, c), max);
+            }
+            std::cout << "|" << std::endl;
+        }
+
+        double max_drop = 0.0, max_squeeze = 0.0;
+        for (size_t c = start; c < end; c++) {
+            max_drop = std::max(max_drop, softnet_[c].dropped_rate);
+            max_squeeze = std::max(max_squeeze, softnet_[c].time_squeeze_rate);
+        }
+        std::cout << std::left << std::setw(10) << "DROPS" << "|";
+        for (size_t c = start; c < end; c++) std::cout << heatCell(softnet_[c].dropped_rate, max_drop);
+        std::cout << "|" << std::endl;
+        std::cout << std::left << std::setw(10) << "SQUEEZE" << "|";
+        for (size_t c = start; c < end; c++) std::cout << heatCell(softnet_[c].time_squeeze_rate, max_squeeze);
+        std::cout << "|" << std::endl;
+    }
+}
@@ -0,0 +1,293 @@
+#include "StealMonitor.h"
+#include "SysfsUtil.h"
+#include "CpuMonitor.h"
+#include "PerfMonitor.h"
+#include "ProcessMonitor.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+
+namespace {
+
+// Noisy neighbor: system steal at or above this for kSustainedIntervals in a row
+const double kHighStealPercent = 5.0;
+const int kSustainedIntervals = 3;
+const size_t kMaxPeriods = 32;
+
+const size_t kCorrelationSamples = 60;
+const double kQuietIpcWeight = 0.2;
+
+const double kBucketUpperBounds[StealMonitor::kHistogramBuckets - 1] = {1.0, 2.0, 5.0, 10.0, 20.0, 50.0};
+const char* kBucketLabels[StealMonitor::kHistogramBuckets] = {
+    "<1%", "1-2%", "2-5%", "5-10%", "10-20%", "20-50%", ">=50%"
+};
+
+} // namespace
+
+StealMonitor::StealMonitor()
+    : steal_percent_(0.0), histogram_{}, run_{}, run_intervals_(0), run_ipc_count_(0), quiet_ipc_(0.0),
+      cpu_monitor_(nullptr), perf_monitor_(nullptr), process_monitor_(nullptr), first_reading_(true) {
+    detectHypervisor();
+}
+
+void StealMonitor::attachCpuMonitor(const CpuMonitor* cpu_monitor) {
+    cpu_monitor_ = cpu_monitor;
+}
+
+void StealMonitor::attachPerfCounters(const PerfMonitor* perf_monitor, const ProcessMonitor* process_monitor) {
+    perf_monitor_ = perf_monitor;
+    process_monitor_ = process_monitor;
+}
+
+void StealMonitor::detectHypervisor() {
+    // Xen and some others name themselves here; KVM/Hyper-V/VMware only via DMI
+    hypervisor_ = readFirstLine("/sys/hypervisor/type");
+    if (!hypervisor_.empty()) {
+        return;
+    }
+
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    bool flagged = false;
+    while (std::getline(cpuinfo, line)) {
+        if (line.compare(0, 5, "flags") == 0) {
+            flagged = line.find(" hypervisor") != std::string::npos;
+            break;
+        }
+    }
+    if (flagged) {
+        std::string vendor = readFirstLine("/sys/class/dmi/id/sys_vendor");
+        std::string product = readFirstLine("/sys/class/dmi/id/product_name");
+        hypervisor_ = !product.empty() ? product : !vendor.empty() ? vendor : "unknown hypervisor";
+    }
+}
+
+bool StealMonitor::update() {
+    auto now = std::chrono::steady_clock::now();
+    double interval = std::chrono::duration<double>(now - last_update_).count();
+    last_update_ = now;
+
+    bool had_baseline = !first_reading_;
+    if (!sampleCpuTimes()) {
+        return false;
+    }
+    first_reading_ = false;
+    if (!had_baseline) {
+        return true;
+    }
+
+    size_t bucket = 0;
+    while (bucket < kHistogramBuckets - 1 && steal_percent_ >= kBucketUpperBounds[bucket]) bucket++;
+    histogram_[bucket]++;
+
+    double ipc = sampleIpc();
+    if (ipc > 0.0) {
+        samples_.push_back({steal_percent_, ipc});
+        if (samples_.size() > kCorrelationSamples) samples_.pop_front();
+    }
+    trackPeriods(ipc, interval);
+    return true;
+}
+
+bool StealMonitor::sampleCpuTimes() {
+    if (!cpu_monitor_) {
+        return false;
+    }
+
+    std::vector<CpuSteal> cpus;
+    unsigned long long steal_total = 0, time_total = 0;
+    for (const auto& [id, times] : cpu_monitor_->getPerCpuTimes()) {
+        CpuSteal cpu{};
+        cpu.cpu = id;
+        cpu.steal = times.steal;
+        cpu.guest = times.guest;
+        cpu.total = CpuMonitor::totalTicks(times);
+
+        auto before = std::find_if(cpus_.begin(), cpus_.end(), [&cpu](const CpuSteal& c) { return c.cpu == cpu.cpu; });
+        if (before != cpus_.end()) {
+            cpu.peak_steal_percent = before->peak_steal_percent;
+            if (cpu.total > before->total && cpu.steal >= before->steal) {
+                unsigned long long delta_total = cpu.total - before->total;
+                cpu.steal_percent = 100.0 * (cpu.steal - before->steal) / delta_total;
+                cpu.guest_percent = cpu.guest >= before->guest ? 100.0 * (cpu.guest - before->guest) / delta_total : 0.0;
+                cpu.peak_steal_percent = std::max(cpu.peak_steal_percent, cpu.steal_percent);
+                steal_total += cpu.steal - before->steal;
+                time_total += delta_total;
+            }
+        }
+        cpus.push_back(cpu);
+    }
+
+    cpus_ = std::move(cpus);
+    steal_percent_ = time_total > 0 ? 100.0 * steal_total / time_total : 0.0;
+    return !cpus_.empty();
+}
+
+double StealMonitor::sampleIpc() const {
+    // Our busiest processes first: that is the work a neighbor slows down
+    if (process_monitor_) {
+        double weighted = 0.0, weight = 0.0;
+        for (const auto& [pid, stats] : process_monitor_->getProcessStats()) {
+            if (stats.has_hw_counters && stats.ipc > 0.0) {
+                weighted += stats.ipc * stats.cpu_usage_percent;
+                weight += stats.cpu_usage_percent;
+            }
+        }
+        if (weight > 0.0) {
+            return weighted / weight;
+        }
+    }
+    return perf_monitor_ ? perf_monitor_->getIPC() : 0.0;
+}
+
+void StealMonitor::trackPeriods(double ipc, double interval_seconds) {
+    if (steal_percent_ < kHighStealPercent) {
+        if (ipc > 0.0) {
+            quiet_ipc_ = quiet_ipc_ > 0.0 ? quiet_ipc_ * (1.0 - kQuietIpcWeight) + ipc * kQuietIpcWeight : ipc;
+        }
+        if (!periods_.empty()) periods_.back().active = false;
+        run_intervals_ = 0;
+        return;
+    }
+
+    // Extend the current run of high-steal intervals
+    if (run_intervals_ == 0) {
+        run_ = NoisyNeighborPeriod{};
+        run_.start = std::chrono::system_clock::now() -
+                     std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                         std::chrono::duration<double>(interval_seconds));
+        run_.ipc_baseline = quiet_ipc_;
+        run_ipc_count_ = 0;
+    }
+    run_intervals_++;
+    run_.duration_seconds += interval_seconds;
+    run_.peak_steal_percent = std::max(run_.peak_steal_percent, steal_percent_);
+    run_.mean_steal_percent += (steal_percent_ - run_.mean_steal_percent) / run_intervals_;
+    if (ipc > 0.0) {
+        run_ipc_count_++;
+        run_.ipc_during += (ipc - run_.ipc_during) / run_ipc_count_;
+    }
+
+    if (run_intervals_ < kSustainedIntervals) {
+        return;
+    }
+    run_.active = true;
+    if (run_intervals_ == kSustainedIntervals) {
+        periods_.push_back(run_);
+        if (periods_.size() > kMaxPeriods) periods_.erase(periods_.begin());
+    } else {
+        periods_.back() = run_;
+    }
+}
+
+double StealMonitor::getMaxCpuStealPercent() const {
+    double max = 0.0;
+    for (const auto& cpu : cpus_) max = std::max(max, cpu.steal_percent);
+    return max;
+}
+
+double StealMonitor::getStealIpcCorrelation() const {
+    if (samples_.size() < 10) {
+        return 0.0;
+    }
+    double n = samples_.size();
+    double sum_s = 0, sum_i = 0, sum_ss = 0, sum_ii = 0, sum_si = 0;
+    for (const auto& [steal, ipc] : samples_) {
+        sum_s += steal;
+        sum_i += ipc;
+        sum_ss += steal * steal;
+        sum_ii += ipc * ipc;
+        sum_si += steal * ipc;
+    }
+    double cov = sum_si - sum_s * sum_i / n;
+    double var_s = sum_ss - sum_s * sum_s / n;
+    double var_i = sum_ii - sum_i * sum_i / n;
+    return var_s > 0.0 && var_i > 0.0 ? cov / std::sqrt(var_s * var_i) : 0.0;
+}
+
+void StealMonitor::printStats() {
+    std::cout << "\n☁️  VIRTUALIZATION & STEAL TIME" << std::endl;
+    std::cout << "─────────────────────────────────────────────────────────────────────" << std::endl;
+    std::cout << "Hypervisor: " << (isVirtualized() ? hypervisor_ : "none detected (bare metal?)") << std::endl;
+
+    if (first_reading_ || cpus_.empty()) {
+        std::cout << "Steal rates (first reading - not available yet)" << std::endl;
+        return;
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "System Steal: " << steal_percent_ << "% | Worst CPU: " << getMaxCpuStealPercent() << "%" << std::endl;
+
+    // CPUs with the most steal now
+    std::vector<const CpuSteal*> order;
+    for (const auto& cpu : cpus_) order.push_back(&cpu);
+    std::sort(order.begin(), order.end(), [](const CpuSteal* a, const CpuSteal* b) {
+        return a->steal_percent > b->steal_percent;
+    });
+    std::cout << std::left << std::setw(8) << "CPU"
+              << std::right << std::setw(9) << "STEAL%"
+              << std::setw(9) << "GUEST%"
+              << std::setw(9) << "PEAK%" << std::endl;
+    for (size_t i = 0; i < order.size() && i < 8; i++) {
+        std::cout << std::left << std::setw(8) << ("cpu" + std::to_string(order[i]->cpu))
+                  << std::right << std::setw(9) << order[i]->steal_percent
+                  << std::setw(9) << order[i]->guest_percent
+                  << std::setw(9) << order[i]->peak_steal_percent << std::endl;
+    }
+
+    // Interval histogram
+    unsigned long intervals = 0;
+    for (unsigned long count : histogram_) intervals += count;
+    if (intervals > 0) {
+        std::cout << "Steal distribution over " << intervals << " intervals:" << std::endl;
+        for (size_t b = 0; b < kHistogramBuckets; b++) {
+            double share = 100.0 * histogram_[b] / intervals;
+            std::cout << "  " << std::left << std::setw(8) << kBucketLabels[b] << std::right
+                      << std::setw(6) << std::setprecision(1) << share << "%";
+            size_t bar = (size_t)(share / 2.5);
+            if (bar > 0) {
+                std::cout << " " << std::string(bar, '#');
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    if (samples_.size() >= 10) {
+        std::cout << "Steal vs IPC correlation: r=" << std::setprecision(2) << getStealIpcCorrelation()
+                  << " over " << samples_.size() << " intervals" << std::endl;
+    }
+
+    if (!periods_.empty()) {
+        std::cout << "Noisy-neighbor periods (steal >= " << kHighStealPercent << "% for "
+                  << kSustainedIntervals << "+ intervals):" << std::endl;
+        size_t first = periods_.size() > 5 ? periods_.size() - 5 : 0;
+        for (size_t i = first; i < periods_.size(); i++) {
+            const auto& period = periods_[i];
+            std::time_t start = std::chrono::system_clock::to_time_t(period.start);
+            char when[16];
+            std::strftime(when, sizeof(when), "%H:%M:%S", std::localtime(&start));
+            std::cout << "  " << when << "  " << std::setprecision(0) << period.duration_seconds << "s"
+                      << "  mean " << std::setprecision(1) << period.mean_steal_percent << "%"
+                      << "  peak " << period.peak_steal_percent << "%";
+            if (period.ipc_during > 0.0 && period.ipc_baseline > 0.0) {
+                std::cout << "  IPC " << std::setprecision(2) << period.ipc_baseline << " → " << period.ipc_during;
+            }
+            std::cout << (period.active ? "  🔴 ONGOING" : "") << std::endl;
+        }
+    }
+
+    if (isNoisyNeighborActive()) {
+        const auto& period = periods_.back();
+        std::cout << "⚠️  CRITICAL: Sustained steal for " << std::setprecision(0) << period.duration_seconds
+                  << "s - Hypervisor giving our vCPUs' time to other guests" << std::endl;
+        if (period.ipc_during > 0.0 && period.ipc_baseline > 0.0 && period.ipc_during < period.ipc_baseline) {
+            std::cout << "   → Impact: IPC down " << std::setprecision(0)
+                      << 100.0 * (1.0 - period.ipc_during / period.ipc_baseline)
+                      << "% (shared caches/memory bandwidth contended)" << std::endl;
+        }
+        std::cout << "   → Solution: Move to dedicated/pinned vCPUs or a less loaded host" << std::endl;
+    }
+}
@@ -5,6 +5,14 @@
 #include <filesystem>
 #include <algorithm>
 
+namespace {
+
+// 512 bins at 2% cover 1 us to ~10 min
+const double kLatencyAccuracy = 0.02;
+const double kMinLatencyMs = 0.001;
+
+} // namespace
+
 StorageMonitor::StorageMonitor() : first_reading_(true) {
     // Open /proc/diskstats for reading
     diskstats_file_.open("/proc/diskstats");
@@ -150,6 +158,14 @@ void StorageMonitor::calculatePerformance() {
             current_stats.avg_latency = 0.0;
         }
         
+        // Mean await of this interval, weighted by its completed I/Os
+        if (total_ops > 0) {
+            unsigned long wait_time = (current_stats.read_time - prev_stats.read_time) +
+                                      (current_stats.write_time - prev_stats.write_time);
+            latency_distribution_.try_emplace(device_name, kLatencyAccuracy, kMinLatencyMs)
+                .first->second.add((double)wait_time / total_ops, total_ops);
+        }
+        
         // Current queue depth
         current_stats.queue_depth = current_stats.io_in_progress;
     }
@@ -244,6 +260,28 @@ void StorageMonitor::printStats() {
                   << std::setw(12) << std::to_string((int)stats.queue_depth) + "/128"
                   << std::setw(10) << status << std::endl;
     }
+    
+    // Spread of interval mean await since start, weighted by I/O count
+    if (!latency_distribution_.empty()) {
+        std::cout << "\nDistribution of per-interval mean await (ms, I/O-weighted, since start):" << std::endl;
+        std::cout << std::left << std::setw(12) << "Device"
+                  << std::right << std::setw(12) << "I/Os"
+                  << std::setw(9) << "P50"
+                  << std::setw(9) << "P90"
+                  << std::setw(9) << "P99"
+                  << std::setw(9) << "P99.9"
+                  << std::setw(9) << "Max" << std::endl;
+        for (const auto& [device_name, sketch] : latency_distribution_) {
+            std::cout << std::left << std::setw(12) << device_name
+                      << std::right << std::setw(12) << sketch.count()
+                      << std::fixed << std::setprecision(2)
+                      << std::setw(9) << sketch.p50()
+                      << std::setw(9) << sketch.p90()
+                      << std::setw(9) << sketch.p99()
+                      << std::setw(9) << sketch.p999()
+                      << std::setw(9) << sketch.max() << std::endl;
+        }
+    }
 }
 
 
@@ -345,6 +383,11 @@ double StorageMonitor::getTotalIOPS() const {
     return total;
 }
 
+const LatencySketch* StorageMonitor::getLatencyDistribution(const std::string& device) const {
+    auto it = latency_distribution_.find(device);
+    return it != latency_distribution_.end() ? &it->second : nullptr;
+}
+
 double StorageMonitor::getTotalThroughput() const {
     double total = 0.0;
     for (const auto& [device_name, stats] : disk_stats_) {
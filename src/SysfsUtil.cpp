@@ -0,0 +1,25 @@
+#include "SysfsUtil.h"
+#include <fstream>
+
+std::string readFirstLine(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+bool readUll(const std::string& path, uint64_t& value) {
+    std::ifstream file(path);
+    return static_cast<bool>(file >> value);
+}
+
+uint64_t readUllOr(const std::string& path, uint64_t fallback) {
+    uint64_t value;
+    return readUll(path, value) ? value : fallback;
+}
+
+int readIntOr(const std::string& path, int fallback) {
+    std::ifstream file(path);
+    int value;
+    return file >> value ? value : fallback;
+}
@@ -0,0 +1,286 @@
+#include "Topology.h"
+#include "SysfsUtil.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <algorithm>
+#include <set>
+#include <cctype>
+
+namespace {
+
+const std::string kCpuRoot = "/sys/devices/system/cpu/";
+const std::string kNodeRoot = "/sys/devices/system/node";
+
+unsigned long parseCacheSize(const std::string& text) {
+    // "32K", "1024K", "36M"
+    unsigned long size = std::strtoul(text.c_str(), nullptr, 10);
+    if (text.find('M') != std::string::npos) size *= 1024;
+    return size;
+}
+
+} // namespace
+
+Topology& Topology::instance() {
+    static Topology topology;
+    return topology;
+}
+
+Topology::Topology() : generation_(0) {
+    online_text_ = readFirstLine(kCpuRoot + "online");
+    build();
+}
+
+bool Topology::refreshIfChanged() {
+    std::string online = readFirstLine(kCpuRoot + "online");
+    if (online == online_text_) {
+        return false;
+    }
+    online_text_ = online;
+    build();
+    return true;
+}
+
+void Topology::build() {
+    online_cpus_ = parseCpuList(online_text_);
+    placements_.clear();
+    caches_.clear();
+    nodes_.clear();
+    placement_index_.assign(online_cpus_.empty() ? 0 : online_cpus_.back() + 1, -1);
+
+    readNodes();
+    for (int cpu : online_cpus_) {
+        readCpu(cpu);
+    }
+    generation_++;
+}
+
+void Topology::readNodes() {
+    std::error_code ec;
+    std::vector<int> node_ids;
+    for (const auto& entry : std::filesystem::directory_iterator(kNodeRoot, ec)) {
+        std::string name = entry.path().filename().string();
+        if (name.rfind("node", 0) != 0 || name.size() == 4 || !isdigit((unsigned char)name[4])) continue;
+        node_ids.push_back(std::stoi(name.substr(4)));
+    }
+    std::sort(node_ids.begin(), node_ids.end());
+
+    for (int node : node_ids) {
+        std::string dir = kNodeRoot + "/node" + std::to_string(node);
+        NodeTopology topology{node, {}, {}};
+        // cpulist only lists online CPUs, so hotplug shows up here as well
+        topology.cpus = parseCpuList(readFirstLine(dir + "/cpulist"));
+        std::istringstream distances(readFirstLine(dir + "/distance"));
+        int distance;
+        while (distances >> distance) topology.distances.push_back(distance);
+        nodes_[node] = topology;
+    }
+}
+
+void Topology::readCpu(int cpu) {
+    std::string dir = kCpuRoot + "cpu" + std::to_string(cpu) + "/";
+    CpuPlacement placement{cpu, cpu, -1, readIntOr(dir + "topology/physical_package_id", 0),
+                           readIntOr(dir + "topology/die_id", 0), getNodeOfCpu(cpu), {}};
+
+    placement.siblings = parseCpuList(readFirstLine(dir + "topology/thread_siblings_list"));
+    if (!placement.siblings.empty()) {
+        placement.core = placement.siblings.front();
+    } else {
+        placement.siblings.push_back(cpu);
+    }
+
+    // Caches: record each distinct one once; the highest level is the LLC
+    int llc_level = 0;
+    for (int index = 0;; index++) {
+        std::string cache_dir = dir + "cache/index" + std::to_string(index) + "/";
+        int level = readIntOr(cache_dir + "level", -1);
+        if (level < 0) {
+            break;
+        }
+        CacheDomain cache{level, readFirstLine(cache_dir + "type"),
+                          parseCacheSize(readFirstLine(cache_dir + "size")),
+                          parseCpuList(readFirstLine(cache_dir + "shared_cpu_list"))};
+        if (cache.cpus.empty()) cache.cpus.push_back(cpu);
+
+        if (level >= llc_level && cache.type != "Instruction") {
+            llc_level = level;
+            placement.llc = cache.cpus.front();
+        }
+        bool known = std::any_of(caches_.begin(), caches_.end(), [&cache](const CacheDomain& c) {
+            return c.level == cache.level && c.type == cache.type && c.cpus == cache.cpus;
+        });
+        if (!known) {
+            caches_.push_back(cache);
+        }
+    }
+    if (placement.llc < 0) {
+        placement.llc = placement.socket;
+    }
+
+    placement_index_[cpu] = placements_.size();
+    placements_.push_back(placement);
+}
+
+const CpuPlacement* Topology::getCpu(int cpu) const {
+    if (cpu < 0 || cpu >= (int)placement_index_.size() || placement_index_[cpu] < 0) {
+        return nullptr;
+    }
+    return &placements_[placement_index_[cpu]];
+}
+
+int Topology::getNodeOfCpu(int cpu) const {
+    for (const auto& [node, topology] : nodes_) {
+        if (std::binary_search(topology.cpus.begin(), topology.cpus.end(), cpu)) {
+            return node;
+        }
+    }
+    return -1;
+}
+
+int Topology::domainOf(int cpu, TopologyLevel level) const {
+    const CpuPlacement* placement = getCpu(cpu);
+    if (!placement) {
+        return -1;
+    }
+    switch (level) {
+        case TOPO_CPU: return placement->cpu;
+        case TOPO_CORE: return placement->core;
+        case TOPO_LLC: return placement->llc;
+        case TOPO_SOCKET: return placement->socket;
+        case TOPO_NODE: return placement->node;
+    }
+    return -1;
+}
+
+std::vector<int> Topology::getNodeCpus(int node) const {
+    auto it = nodes_.find(node);
+    return it != nodes_.end() ? it->second.cpus : std::vector<int>{};
+}
+
+std::vector<int> Topology::getDomainCpus(TopologyLevel level, int domain) const {
+    std::vector<int> cpus;
+    for (const auto& placement : placements_) {
+        if (domainOf(placement.cpu, level) == domain) cpus.push_back(placement.cpu);
+    }
+    return cpus;
+}
+
+int Topology::getSocketCount() const {
+    std::set<int> sockets;
+    for (const auto& placement : placements_) sockets.insert(placement.socket);
+    return sockets.size();
+}
+
+int Topology::getCoreCount() const {
+    std::set<int> cores;
+    for (const auto& placement : placements_) cores.insert(placement.core);
+    return cores.size();
+}
+
+int Topology::getLlcCount() const {
+    std::set<int> llcs;
+    for (const auto& placement : placements_) llcs.insert(placement.llc);
+    return llcs.size();
+}
+
+int Topology::getThreadsPerCore() const {
+    size_t threads = 1;
+    for (const auto& placement : placements_) threads = std::max(threads, placement.siblings.size());
+    return threads;
+}
+
+std::map<int, double> Topology::aggregate(const std::map<int, double>& per_cpu, TopologyLevel level, bool average) const {
+    std::map<int, double> totals;
+    std::map<int, int> counts;
+    for (const auto& [cpu, value] : per_cpu) {
+        int domain = domainOf(cpu, level);
+        if (domain < 0 && level != TOPO_NODE) continue;
+        totals[domain] += value;
+        counts[domain]++;
+    }
+    if (average) {
+        for (auto& [domain, total] : totals) total /= counts[domain];
+    }
+    return totals;
+}
+
+const char* Topology::levelName(TopologyLevel level) {
+    switch (level) {
+        case TOPO_CPU: return "cpu";
+        case TOPO_CORE: return "core";
+        case TOPO_LLC: return "llc";
+        case TOPO_SOCKET: return "socket";
+        case TOPO_NODE: return "node";
+    }
+    return "?";
+}
+
+void Topology::printTopology() const {
+    std::cout << "\n🧩 CPU TOPOLOGY" << std::endl;
+    std::cout << "─────────────────────────────────────────────────────────────────────" << std::endl;
+    std::cout << "Online CPUs: " << formatCpuList(online_cpus_) << " (" << online_cpus_.size() << ")"
+              << " | Sockets: " << getSocketCount()
+              << " | Cores: " << getCoreCount()
+              << " | SMT: " << getThreadsPerCore() << "-way"
+              << " | LLC domains: " << getLlcCount()
+              << " | NUMA nodes: " << nodes_.size() << std::endl;
+
+    for (const auto& [node, topology] : nodes_) {
+        std::cout << "  node" << node << ": cpus " << (topology.cpus.empty() ? "-" : formatCpuList(topology.cpus));
+        if (!topology.distances.empty()) {
+            std::cout << " | distances";
+            for (int distance : topology.distances) std::cout << " " << distance;
+        }
+        std::cout << std::endl;
+    }
+
+    // Caches from the top level down, one line per level/type
+    std::map<std::pair<int, std::string>, std::vector<const CacheDomain*>> by_level;
+    for (const auto& cache : caches_) by_level[{cache.level, cache.type}].push_back(&cache);
+    for (auto it = by_level.rbegin(); it != by_level.rend(); ++it) {
+        const auto& domains = it->second;
+        std::cout << "  L" << it->first.first << " " << std::left << std::setw(12) << it->first.second
+                  << std::right << std::setw(7) << domains.front()->size_kb << " KB x " << domains.size();
+        if (domains.size() <= 8) {
+            std::cout << "  [";
+            for (size_t i = 0; i < domains.size(); i++) {
+                std::cout << (i ? " | " : "") << formatCpuList(domains[i]->cpus);
+            }
+            std::cout << "]";
+        }
+        std::cout << std::endl;
+    }
+}
+
+std::vector<int> Topology::parseCpuList(const std::string& text) {
+    std::vector<int> cpus;
+    std::stringstream ss(text);
+    std::string range;
+    while (std::getline(ss, range, ',')) {
+        size_t start = range.find_first_not_of(" \t\n");
+        if (start == std::string::npos || !isdigit((unsigned char)range[start])) continue;
+        range = range.substr(start);
+        size_t dash = range.find('-');
+        int first = std::stoi(range.substr(0, dash));
+        int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        for (int cpu = first; cpu <= last; cpu++) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+std::string Topology::formatCpuList(const std::vector<int>& cpus) {
+    std::string result;
+    for (size_t i = 0; i < cpus.size();) {
+        size_t j = i;
+        while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) j++;
+        if (!result.empty()) result += ",";
+        result += std::to_string(cpus[i]);
+        if (j > i) result += "-" + std::to_string(cpus[j]);
+        i = j + 1;
+    }
+    return result;
+}
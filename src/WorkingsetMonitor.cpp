@@ -0,0 +1,294 @@
+#include "WorkingsetMonitor.h"
+#include "SysfsUtil.h"
+#include "NumaMonitor.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <algorithm>
+#include <unordered_map>
+#include <unistd.h>
+
+namespace {
+
+const int kMaxCgroupDepth = 3;
+const size_t kMaxCgroups = 256;
+const int kRediscoverEvery = 10;               // Updates between cgroup tree walks
+
+// Refaults that activate were evicted while still inside the workingset: the
+// cache is too small for the hot set. Streaming reads refault without activating.
+const double kThrashActivatePagesPerSec = 1000.0;    // ~4 MB/s of hot pages re-read
+const double kThrashActivatePercent = 50.0;
+const double kCgroupThrashActivatePagesPerSec = 250.0;
+
+// Refaults whose distance exceeds the workingset are not activated, yet when
+// most evictions come back the LRU is cycling through a larger reuse set
+const double kCyclingRefaultPagesPerSec = 1000.0;
+const double kCyclingRefaultPercent = 50.0;
+
+double activatePercent(double activate, double refault) {
+    return refault > 0.0 ? std::min(100.0, 100.0 * activate / refault) : 0.0;
+}
+
+} // namespace
+
+WorkingsetMonitor::WorkingsetMonitor()
+    : numa_monitor_(nullptr), refault_file_rate_(0.0), refault_anon_rate_(0.0), activate_file_rate_(0.0),
+      restore_file_rate_(0.0), steal_file_rate_(0.0), refault_percent_(0.0), activate_percent_(0.0),
+      turnover_percent_(0.0), file_cache_kb_(0), thrashing_(false), cycling_(false), cgroup_v2_(false),
+      updates_since_discovery_(kRediscoverEvery), page_size_(sysconf(_SC_PAGESIZE)), first_reading_(true) {
+    last_update_ = std::chrono::steady_clock::now();
+
+    // Unified hierarchy with the memory controller, else the v1 memory mount
+    if (readFirstLine("/sys/fs/cgroup/cgroup.controllers").find("memory") != std::string::npos) {
+        cgroup_root_ = "/sys/fs/cgroup";
+        cgroup_v2_ = true;
+    } else if (std::filesystem::exists("/sys/fs/cgroup/memory/memory.stat")) {
+        cgroup_root_ = "/sys/fs/cgroup/memory";
+    }
+}
+
+void WorkingsetMonitor::attachNumaMonitor(const NumaMonitor* numa) {
+    numa_monitor_ = numa;
+}
+
+bool WorkingsetMonitor::update() {
+    if (!numa_monitor_) {
+        return false;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    double interval = std::chrono::duration<double>(now - last_update_).count();
+    last_update_ = now;
+
+    // Kernels before 5.9 had a single file-only workingset_refault/activate/restore
+    auto rate = [this](const std::string& key, const std::string& legacy_key) {
+        return numa_monitor_->findVmstatCounter(key) >= 0 ? numa_monitor_->getVmstatRate(key)
+                                                          : numa_monitor_->getVmstatRate(legacy_key);
+    };
+    refault_file_rate_ = rate("workingset_refault_file", "workingset_refault");
+    activate_file_rate_ = rate("workingset_activate_file", "workingset_activate");
+    restore_file_rate_ = rate("workingset_restore_file", "workingset_restore");
+    refault_anon_rate_ = numa_monitor_->getVmstatRate("workingset_refault_anon");
+    if (numa_monitor_->findVmstatCounter("pgsteal_file") >= 0) {
+        steal_file_rate_ = numa_monitor_->getVmstatRate("pgsteal_file");
+    } else {
+        steal_file_rate_ = numa_monitor_->getVmstatRate("pgsteal_kswapd") + numa_monitor_->getVmstatRate("pgsteal_direct");
+    }
+
+    readMeminfo();
+    refault_percent_ = steal_file_rate_ > 0.0 ? 100.0 * refault_file_rate_ / steal_file_rate_ : 0.0;
+    activate_percent_ = activatePercent(activate_file_rate_, refault_file_rate_);
+    double file_cache_pages = file_cache_kb_ * 1024.0 / page_size_;
+    turnover_percent_ = file_cache_pages > 0.0 ? 100.0 * refault_file_rate_ * 60.0 / file_cache_pages : 0.0;
+    thrashing_ = activate_file_rate_ >= kThrashActivatePagesPerSec && activate_percent_ >= kThrashActivatePercent;
+    cycling_ = !thrashing_ && refault_file_rate_ >= kCyclingRefaultPagesPerSec && refault_percent_ >= kCyclingRefaultPercent;
+
+    if (!cgroup_root_.empty()) {
+        if (++updates_since_discovery_ >= kRediscoverEvery) {
+            discoverCgroups();
+            updates_since_discovery_ = 0;
+        }
+        readCgroups(first_reading_ ? 0.0 : interval);
+    }
+
+    first_reading_ = false;
+    return true;
+}
+
+void WorkingsetMonitor::readMeminfo() {
+    std::ifstream meminfo("/proc/meminfo");
+    std::string key;
+    unsigned long value;
+    std::string unit;
+    unsigned long active_file = 0, inactive_file = 0;
+    while (meminfo >> key >> value) {
+        std::getline(meminfo, unit);
+        if (key == "Active(file):") active_file = value;
+        else if (key == "Inactive(file):") inactive_file = value;
+    }
+    file_cache_kb_ = active_file + inactive_file;
+}
+
+void WorkingsetMonitor::discoverCgroups() {
+    namespace fs = std::filesystem;
+    std::map<std::string, CgroupWorkingset> found;
+
+    auto add = [&](const std::string& relative) {
+        auto it = cgroups_.find(relative);
+        if (it != cgroups_.end()) {
+            found[relative] = it->second;   // Keep previous counters across rescans
+        } else {
+            CgroupWorkingset cgroup{};
+            cgroup.path = relative;
+            found[relative] = cgroup;
+        }
+    };
+
+    // The v2 root has no memory.stat; vmstat already covers the whole system
+    if (!cgroup_v2_) {
+        add("/");
+    }
+    std::error_code ec;
+    for (auto it = fs::recursive_directory_iterator(cgroup_root_, fs::directory_options::skip_permission_denied, ec);
+         it != fs::recursive_directory_iterator() && found.size() < kMaxCgroups; it.increment(ec)) {
+        if (ec) break;
+        if (!it->is_directory(ec) || it->is_symlink(ec)) continue;
+        if (it.depth() + 1 >= kMaxCgroupDepth) {
+            it.disable_recursion_pending();
+        }
+        if (fs::exists(it->path() / "memory.stat", ec)) {
+            add(it->path().string().substr(cgroup_root_.size()));
+        }
+    }
+    cgroups_.swap(found);
+}
+
+bool WorkingsetMonitor::readMemoryStat(const std::string& path, WorkingsetCounters& counters) const {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::unordered_map<std::string, uint64_t> values;
+    std::string key;
+    uint64_t value;
+    while (file >> key >> value) {
+        values[key] = value;
+    }
+
+    // v1: hierarchical total_* keys first; both: _file suffix, else the pre-5.9 name
+    auto lookup = [&](const std::string& name, const std::string& legacy) -> uint64_t {
+        for (const std::string& candidate : {"total_" + name, name, "total_" + legacy, legacy}) {
+            auto it = values.find(candidate);
+            if (it != values.end()) return it->second;
+        }
+        return 0;
+    };
+    counters.refault = lookup("workingset_refault_file", "workingset_refault");
+    counters.activate = lookup("workingset_activate_file", "workingset_activate");
+    counters.restore = lookup("workingset_restore_file", "workingset_restore");
+    counters.file_bytes = cgroup_v2_ ? lookup("file", "file") : lookup("cache", "cache");
+    counters.steal = lookup("pgsteal", "pgsteal");
+    return true;
+}
+
+void WorkingsetMonitor::readCgroups(double interval_seconds) {
+    for (auto it = cgroups_.begin(); it != cgroups_.end();) {
+        CgroupWorkingset& cgroup = it->second;
+        std::string dir = cgroup_root_ + (cgroup.path == "/" ? "" : cgroup.path);
+        WorkingsetCounters counters{};
+        if (!readMemoryStat(dir + "/memory.stat", counters)) {
+            it = cgroups_.erase(it);   // Cgroup removed since the last walk
+            continue;
+        }
+
+        cgroup.previous = cgroup.counters;
+        cgroup.counters = counters;
+        if (cgroup.has_previous && interval_seconds > 0.0) {
+            auto delta = [&](uint64_t now, uint64_t before) {
+                return now >= before ? (now - before) / interval_seconds : 0.0;
+            };
+            cgroup.refault_rate = delta(counters.refault, cgroup.previous.refault);
+            cgroup.activate_rate = delta(counters.activate, cgroup.previous.activate);
+            cgroup.restore_rate = delta(counters.restore, cgroup.previous.restore);
+            cgroup.steal_rate = delta(counters.steal, cgroup.previous.steal);
+        } else {
+            cgroup.refault_rate = cgroup.activate_rate = cgroup.restore_rate = cgroup.steal_rate = 0.0;
+        }
+        // pgsteal counts anon reclaim too, so this understates the file ratio under swap.
+        // v1 memory.stat has no pgsteal: without a ratio, cycling cannot be told from streaming
+        if (!cgroup_v2_) {
+            cgroup.refault_percent = -1.0;
+        } else {
+            cgroup.refault_percent = cgroup.steal_rate > 0.0 ? 100.0 * cgroup.refault_rate / cgroup.steal_rate : 0.0;
+        }
+        cgroup.activate_percent = activatePercent(cgroup.activate_rate, cgroup.refault_rate);
+        cgroup.thrashing = cgroup.activate_rate >= kCgroupThrashActivatePagesPerSec &&
+                           cgroup.activate_percent >= kThrashActivatePercent;
+        cgroup.cycling = !cgroup.thrashing && cgroup.refault_rate >= kCyclingRefaultPagesPerSec &&
+                         cgroup.refault_percent >= kCyclingRefaultPercent;
+        cgroup.has_previous = true;
+        ++it;
+    }
+}
+
+std::vector<const CgroupWorkingset*> WorkingsetMonitor::getThrashingCgroups() const {
+    std::vector<const CgroupWorkingset*> thrashing;
+    for (const auto& [path, cgroup] : cgroups_) {
+        if (cgroup.thrashing) thrashing.push_back(&cgroup);
+    }
+    return thrashing;
+}
+
+void WorkingsetMonitor::printStats(int count) {
+    std::cout << "\n♻️  WORKINGSET & PAGE CACHE EFFICIENCY" << std::endl;
+    std::cout << "─────────────────────────────────────────────────────────────────────" << std::endl;
+
+    double mb_per_page = page_size_ / (1024.0 * 1024.0);
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Page cache: " << file_cache_kb_ / 1024 << " MB (Active+Inactive file)"
+              << " | evicted " << steal_file_rate_ * mb_per_page << " MB/s" << std::endl;
+    std::cout << "File refaults: " << refault_file_rate_ << "/s (" << refault_file_rate_ * mb_per_page << " MB/s re-read)"
+              << " | activate " << activate_file_rate_ << "/s (" << activate_percent_ << "% of refaults)"
+              << " | restore " << restore_file_rate_ << "/s" << std::endl;
+    std::cout << "Refault ratio: " << refault_percent_ << "% of evictions come back"
+              << " | turnover " << turnover_percent_ << "% of the cache re-read per minute"
+              << " | anon refaults " << refault_anon_rate_ << "/s" << std::endl;
+
+    if (!cgroups_.empty()) {
+        std::vector<const CgroupWorkingset*> ranked;
+        for (const auto& [path, cgroup] : cgroups_) {
+            ranked.push_back(&cgroup);
+        }
+        std::sort(ranked.begin(), ranked.end(), [](const CgroupWorkingset* a, const CgroupWorkingset* b) {
+            if (a->refault_rate != b->refault_rate) return a->refault_rate > b->refault_rate;
+            return a->counters.file_bytes > b->counters.file_bytes;
+        });
+        if (ranked.size() > static_cast<size_t>(count)) {
+            ranked.resize(count);
+        }
+
+        std::cout << "\n" << std::left << std::setw(36) << ("CGROUP (" + std::string(cgroup_v2_ ? "v2" : "v1") + ")")
+                  << std::right << std::setw(10) << "FILE(MB)"
+                  << std::setw(11) << "REFAULT/s"
+                  << std::setw(12) << "ACTIVATE/s"
+                  << std::setw(11) << "RESTORE/s"
+                  << std::setw(10) << "REFAULT%"
+                  << std::setw(8) << "MB/s" << "  STATUS" << std::endl;
+        for (const CgroupWorkingset* cgroup : ranked) {
+            std::string path = cgroup->path.size() > 35 ? "..." + cgroup->path.substr(cgroup->path.size() - 32) : cgroup->path;
+            std::cout << std::left << std::setw(36) << path
+                      << std::right << std::setw(10) << cgroup->counters.file_bytes / (1024 * 1024)
+                      << std::setw(11) << cgroup->refault_rate
+                      << std::setw(12) << cgroup->activate_rate
+                      << std::setw(11) << cgroup->restore_rate;
+            if (cgroup->refault_percent >= 0.0) {
+                std::cout << std::setw(10) << cgroup->refault_percent;
+            } else {
+                std::cout << std::setw(10) << "-";
+            }
+            std::cout << std::setw(8) << cgroup->refault_rate * mb_per_page
+                      << "  " << (cgroup->thrashing ? "🔴 THRASHING" : cgroup->cycling ? "🟡 CYCLING" : "") << std::endl;
+        }
+    }
+
+    if (thrashing_) {
+        std::cout << "🔴 PAGE CACHE THRASHING: " << activate_file_rate_ * mb_per_page
+                  << " MB/s of still-hot pages evicted and re-read" << std::endl;
+        std::cout << "   → Solution: The hot file set exceeds the cache; raise the cgroup memory.max/memory.low of the"
+                  << " reader, or cut competing anon/cache users" << std::endl;
+    } else if (cycling_) {
+        std::cout << "🟡 PAGE CACHE CYCLING: " << std::setprecision(0) << refault_percent_
+                  << "% of evicted file pages are read back, from beyond the cache's reach" << std::endl;
+        std::cout << "   → Solution: The reuse set is larger than the cache; give the reader more memory, or read scans"
+                  << " with O_DIRECT / POSIX_FADV_DONTNEED so they stop evicting the rest" << std::endl;
+    } else if (refault_file_rate_ > 0.0 && activate_percent_ < kThrashActivatePercent) {
+        std::cout << "ℹ️  Refaults are mostly cold - streaming or one-pass reads" << std::endl;
+    }
+    for (const CgroupWorkingset* cgroup : getThrashingCgroups()) {
+        std::cout << "🔴 " << cgroup->path << " thrashing: " << cgroup->activate_rate
+                  << " hot refaults/s - its limit is below its working set" << std::endl;
+    }
+}
@@ -3,12 +3,30 @@
 #include "StorageMonitor.h"
 #include "PerfMonitor.h"
 #include "NumaMonitor.h"
+#include "HugePageMonitor.h"
+#include "FragmentationMonitor.h"
+#include "SlabMonitor.h"
+#include "WorkingsetMonitor.h"
+#include "MetricStore.h"
 #include "ProcessMonitor.h"
+#include "SchedMonitor.h"
+#include "PressureMonitor.h"
+#include "IrqAffinityPlanner.h"
+#include "StealMonitor.h"
+#include "Topology.h"
 #include <iostream>
+#include <iomanip>
 #include <chrono>
 #include <thread>
 #include <signal.h>
+#include <cstdlib>
 #include <memory>
+#include <vector>
+#include <string>
+#include <map>
+#include <set>
+#include <algorithm>
+#include <cmath>
 
 // Global variables for signal handling
 bool g_running = true;
@@ -28,42 +46,473 @@ void printUsage() {
     std::cout << "  --perf, -p         Enable hardware performance counters (Phase 3)" << std::endl;
     std::cout << "  --numa, -n         Enable NUMA analysis (Phase 4)" << std::endl;
     std::cout << "  --process, -r      Enable process monitoring (Phase 5)" << std::endl;
+    std::cout << "  --event <spec>     Add a PMU counter, e.g. cpu/event=0xd1,umask=0x20/ (implies --perf)" << std::endl;
+    std::cout << "  --membw            Add uncore IMC memory bandwidth counters (implies --perf)" << std::endl;
+    std::cout << "  --perf-pid <pid>   Count cache/TLB and other core events for one process (implies --perf)" << std::endl;
+    std::cout << "  --sched, -s        Trace run-queue latency and off-CPU reasons (sched tracepoints)" << std::endl;
+    std::cout << "  --irq              Show per-IRQ rates, device queue affinity, NUMA locality and softirqs" << std::endl;
+    std::cout << "  --freq             Show per-core clock, C-state residency and throttling" << std::endl;
+    std::cout << "  --virt             Per-CPU steal time, steal histogram and noisy-neighbor periods" << std::endl;
+    std::cout << "  --topology         Show CPU/cache/NUMA layout and roll CPU, IRQ and IPC up per socket/node/LLC" << std::endl;
+    std::cout << "  --thp              THP fallback, compaction stall time and huge-page coverage (implies --numa)" << std::endl;
+    std::cout << "  --frag             Buddy allocator fragmentation per node/zone and order-4+ collapse alerts" << std::endl;
+    std::cout << "  --slab             Slab caches by size and growth, with a leak-slope detector" << std::endl;
+    std::cout << "  --workingset       Page-cache refault/activate rates per system and cgroup (implies --numa)" << std::endl;
+    std::cout << "  --history          Keep compressed per-second history of every CPU/memory/storage metric" << std::endl;
+    std::cout << "                     (per CPU and device; per PID for the top CPU/memory/I/O processes with --process)" << std::endl;
+    std::cout << "  --psi              Track PSI stall time and kernel pressure trigger events" << std::endl;
+    std::cout << "  --plan-irq-affinity   Measure IRQ load and print a balanced queue IRQ layout (dry run)" << std::endl;
+    std::cout << "  --apply-irq-affinity  Write the planned layout and compare interrupt load before/after" << std::endl;
+    std::cout << "  --list-events      List PMUs and named events from sysfs" << std::endl;
     std::cout << "  --help, -h         Show this help message" << std::endl;
     std::cout << std::endl;
     std::cout << "Examples:" << std::endl;
     std::cout << "  ./sysprobe-advanced --perf --numa --process    # Full advanced monitoring" << std::endl;
     std::cout << "  ./sysprobe-advanced --perf                    # Performance counters only" << std::endl;
     std::cout << "  ./sysprobe-advanced --numa --process          # NUMA and process analysis" << std::endl;
+    std::cout << "  ./sysprobe-advanced --membw --event uncore_imc/cas_count_read/" << std::endl;
+    std::cout << "  sudo ./sysprobe-advanced --apply-irq-affinity   # Rebalance NVMe/NIC queue IRQs" << std::endl;
 }
 
-void runTextMode(bool enable_perf, bool enable_numa, bool enable_process) {
+// Interrupt load over one measurement window
+struct IrqLoadSample {
+    double max_irq_percent;
+    double mean_irq_percent;
+    double total_rate;
+    double run_queue_p99_us;      // -1 without sched tracepoints
+};
+
+IrqLoadSample measureIrqLoad(CpuMonitor& cpu_monitor, SchedMonitor* sched_monitor,
+                             std::map<int, double>& cpu_irq_percent, int seconds) {
+    cpu_monitor.update();
+    if (sched_monitor) {
+        sched_monitor->update();   // Start a fresh latency interval
+    }
+    auto before = cpu_monitor.getPerCpuTimes();
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    cpu_monitor.update();
+    cpu_irq_percent = IrqAffinityPlanner::cpuIrqPercent(before, cpu_monitor.getPerCpuTimes());
+
+    IrqLoadSample sample{0.0, 0.0, cpu_monitor.getInterruptMonitor().getTotalRate(), -1.0};
+    for (const auto& [cpu, percent] : cpu_irq_percent) {
+        sample.max_irq_percent = std::max(sample.max_irq_percent, percent);
+        sample.mean_irq_percent += percent;
+    }
+    if (!cpu_irq_percent.empty()) {
+        sample.mean_irq_percent /= cpu_irq_percent.size();
+    }
+    if (sched_monitor) {
+        sched_monitor->update();
+        sample.run_queue_p99_us = sched_monitor->getRunQueueP99Us();
+    }
+    return sample;
+}
+
+int runIrqAffinityMode(bool apply) {
+    const int window_seconds = 5;
+    CpuMonitor cpu_monitor;
+    auto sched_monitor = std::make_unique<SchedMonitor>();
+    if (!sched_monitor->initialize()) {
+        std::cout << "⚠️  Warning: Scheduler tracepoints not available - run-queue latency not compared" << std::endl;
+        sched_monitor.reset();
+    }
+
+    std::cout << "📏 Measuring interrupt load for " << window_seconds << "s..." << std::endl;
+    std::map<int, double> cpu_irq_percent;
+    IrqLoadSample before = measureIrqLoad(cpu_monitor, sched_monitor.get(), cpu_irq_percent, window_seconds);
+
+    IrqAffinityPlanner planner;
+    planner.plan(cpu_monitor.getInterruptMonitor(), cpu_monitor.getSoftirqMonitor(), cpu_irq_percent);
+    planner.printPlan();
+
+    if (!apply || planner.getChangeCount() == 0) {
+        if (!apply && planner.getChangeCount() > 0) {
+            std::cout << "Dry run - use --apply-irq-affinity (as root) to write this layout" << std::endl;
+        }
+        return 0;
+    }
+
+    int moved = planner.apply();
+    std::cout << "\n✍️  Applied " << moved << " of " << planner.getChangeCount() << " affinity changes" << std::endl;
+    for (const auto& a : planner.getAssignments()) {
+        if (!a.error.empty()) {
+            std::cout << "⚠️  IRQ " << a.irq << " (" << a.device << "): " << a.error << std::endl;
+        }
+    }
+    if (moved == 0) {
+        return 1;
+    }
+
+    std::cout << "📏 Measuring interrupt load after the change for " << window_seconds << "s..." << std::endl;
+    IrqLoadSample after = measureIrqLoad(cpu_monitor, sched_monitor.get(), cpu_irq_percent, window_seconds);
+
+    std::cout << "\n📊 BEFORE / AFTER" << std::endl;
+    std::cout << "─────────────────────────────────────────────────────────────────────" << std::endl;
+    std::cout << std::left << std::setw(28) << "METRIC"
+              << std::right << std::setw(12) << "BEFORE"
+              << std::setw(12) << "AFTER" << std::endl;
+    auto row = [](const std::string& name, double b, double a, int precision) {
+        std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(precision)
+                  << std::setw(12) << b << std::setw(12) << a << std::endl;
+    };
+    row("Max CPU irq+softirq %", before.max_irq_percent, after.max_irq_percent, 2);
+    row("Mean CPU irq+softirq %", before.mean_irq_percent, after.mean_irq_percent, 2);
+    row("Total interrupts/s", before.total_rate, after.total_rate, 0);
+    if (sched_monitor) {
+        row("Run-queue p99 (us)", before.run_queue_p99_us, after.run_queue_p99_us, 0);
+    }
+    return 0;
+}
+
+// Per-CPU metrics rolled up to each socket, NUMA node and LLC domain
+void printTopologyRollup(const CpuMonitor& cpu_monitor, const PerfMonitor* perf_monitor) {
+    const Topology& topology = Topology::instance();
+    topology.printTopology();
+
+    std::map<int, double> irq_rates = cpu_monitor.getInterruptMonitor().getCpuRates();
+    std::map<int, double> net_rx_rates = cpu_monitor.getSoftirqMonitor().getCpuRates(SOFTIRQ_NET_RX);
+    std::map<int, double> cycles, instructions;
+    if (perf_monitor) {
+        cycles = perf_monitor->getCpuCycles();
+        instructions = perf_monitor->getCpuInstructions();
+    }
+
+    std::cout << std::left << std::setw(8) << "LEVEL"
+              << std::setw(8) << "ID"
+              << std::setw(16) << "CPUS"
+              << std::right << std::setw(8) << "CPU%"
+              << std::setw(12) << "IRQ/s"
+              << std::setw(12) << "NET_RX/s"
+              << std::setw(8) << "IPC" << std::endl;
+
+    for (TopologyLevel level : {TOPO_SOCKET, TOPO_NODE, TOPO_LLC}) {
+        std::map<int, double> usage = topology.aggregate(cpu_monitor.getPerCpuUsage(), level, true);
+        std::map<int, double> irqs = topology.aggregate(irq_rates, level, false);
+        std::map<int, double> net_rx = topology.aggregate(net_rx_rates, level, false);
+        // Domain IPC is a ratio of sums, not an average of per-CPU ratios
+        std::map<int, double> domain_cycles = topology.aggregate(cycles, level, false);
+        std::map<int, double> domain_instructions = topology.aggregate(instructions, level, false);
+
+        std::set<int> domains;
+        for (int cpu : topology.getOnlineCpus()) domains.insert(topology.domainOf(cpu, level));
+        for (int domain : domains) {
+            std::string cpus = Topology::formatCpuList(topology.getDomainCpus(level, domain));
+            if (cpus.size() > 15) cpus = cpus.substr(0, 14) + "~";
+            std::cout << std::left << std::setw(8) << Topology::levelName(level)
+                      << std::setw(8) << domain
+                      << std::setw(16) << cpus
+                      << std::right << std::fixed << std::setprecision(1)
+                      << std::setw(8) << usage[domain]
+                      << std::setprecision(0) << std::setw(12) << irqs[domain]
+                      << std::setw(12) << net_rx[domain];
+            if (domain_cycles[domain] > 0.0) {
+                std::cout << std::setprecision(2) << std::setw(8) << domain_instructions[domain] / domain_cycles[domain];
+            } else {
+                std::cout << std::setw(8) << "-";
+            }
+            std::cout << std::endl;
+        }
+    }
+}
+
+// Stored series with their compression and the last minute as a sparkline
+void printMetricHistory() {
+    const MetricStore& store = MetricStore::instance();
+    const int window_ms = 60 * 1000;
+    const size_t spark_width = 24;
+    const char levels[] = "_.,o*+=#";
+
+    std::cout << "\n📈 METRIC HISTORY (" << store.getSeriesCount() << " series, "
+              << std::fixed << std::setprecision(1) << store.getArenaBytes() / 1024.0 << " KB arena)" << std::endl;
+    std::cout << "─────────────────────────────────────────────────────────────────────" << std::endl;
+    std::cout << std::left << std::setw(32) << "SERIES"
+              << std::right << std::setw(8) << "SAMPLES"
+              << std::setw(8) << "SPAN"
+              << std::setw(7) << "B/SMP"
+              << "  " << std::left << std::setw(spark_width) << "LAST 60s"
+              << std::right << std::setw(9) << "MIN"
+              << std::setw(9) << "AVG"
+              << std::setw(9) << "MAX" << std::endl;
+
+    int64_t now = MetricStore::nowMs();
+    std::vector<SeriesInfo> info = store.getSeriesInfo();
+    for (SeriesId id = 0; id < info.size(); id++) {
+        std::vector<MetricSample> samples;
+        std::vector<double> buckets;
+        store.query(id, now - window_ms, now, samples);
+        store.downsample(id, now - window_ms, now, spark_width, buckets);
+
+        double min = 0.0, max = 0.0, sum = 0.0;
+        for (size_t i = 0; i < samples.size(); i++) {
+            min = i == 0 ? samples[i].value : std::min(min, samples[i].value);
+            max = i == 0 ? samples[i].value : std::max(max, samples[i].value);
+            sum += samples[i].value;
+        }
+        std::string spark;
+        for (double value : buckets) {
+            if (std::isnan(value)) {
+                spark += ' ';
+            } else {
+                int level = max > min ? static_cast<int>((value - min) / (max - min) * 7.0 + 0.5) : 0;
+                spark += levels[std::clamp(level, 0, 7)];
+            }
+        }
+
+        std::cout << std::left << std::setw(32) << info[id].name
+                  << std::right << std::setw(8) << info[id].samples
+                  << std::setw(7) << (info[id].last_ms - info[id].first_ms) / 1000 << "s"
+                  << std::setprecision(2) << std::setw(7) << info[id].bytes_per_sample
+                  << "  " << std::left << std::setw(spark_width) << spark << std::right;
+        if (samples.empty()) {
+            std::cout << std::setw(9) << "-" << std::setw(9) << "-" << std::setw(9) << "-" << std::endl;
+        } else {
+            std::cout << std::setw(9) << min << std::setw(9) << sum / samples.size() << std::setw(9) << max << std::endl;
+        }
+    }
+
+    // Latest window of each tier; the 10-minute one is usually still filling
+    std::cout << "\nRollups (" << std::setprecision(1) << store.getRollupBytes() / 1024.0 << " KB):" << std::endl;
+    std::cout << std::left << std::setw(32) << "SERIES"
+              << std::right << std::setw(9) << "10s AVG"
+              << std::setw(9) << "1m AVG"
+              << std::setw(9) << "1m P99"
+              << std::setw(9) << "10m MIN"
+              << std::setw(9) << "10m P50"
+              << std::setw(9) << "10m P90"
+              << std::setw(9) << "10m P99"
+              << std::setw(9) << "10m MAX" << std::endl;
+    for (SeriesId id = 0; id < info.size(); id++) {
+        RollupWindow latest[ROLLUP_TIER_COUNT];
+        bool found[ROLLUP_TIER_COUNT];
+        for (int tier = 0; tier < ROLLUP_TIER_COUNT; tier++) {
+            std::vector<RollupWindow> windows;
+            int64_t width = MetricRollup::tierWidthMs(static_cast<RollupTier>(tier));
+            found[tier] = store.rollups(id, static_cast<RollupTier>(tier), now - width, now, windows) > 0;
+            if (found[tier]) {
+                latest[tier] = windows.back();
+            }
+        }
+        if (!found[ROLLUP_10M]) {
+            continue;
+        }
+        std::cout << std::left << std::setw(32) << info[id].name << std::right << std::setprecision(2)
+                  << std::setw(9) << (found[ROLLUP_10S] ? latest[ROLLUP_10S].mean() : 0.0)
+                  << std::setw(9) << (found[ROLLUP_1M] ? latest[ROLLUP_1M].mean() : 0.0)
+                  << std::setw(9) << (found[ROLLUP_1M] ? latest[ROLLUP_1M].quantile(0.99) : 0.0)
+                  << std::setw(9) << latest[ROLLUP_10M].min
+                  << std::setw(9) << latest[ROLLUP_10M].quantile(0.50)
+                  << std::setw(9) << latest[ROLLUP_10M].quantile(0.90)
+                  << std::setw(9) << latest[ROLLUP_10M].quantile(0.99)
+                  << std::setw(9) << latest[ROLLUP_10M].max << std::endl;
+    }
+}
+
+// Per-second samples for --history: every CpuMonitor, MemoryMonitor and
+// StorageMonitor metric (per CPU and per device too), PerfMonitor with --perf,
+// and ProcessMonitor with --process. Per-PID series cover the top CPU, memory
+// and I/O processes of each update, so the series count stays bounded.
+void recordMetrics(const CpuMonitor& cpu_monitor, const MemoryMonitor& memory_monitor, const StorageMonitor& storage_monitor,
+                   const PerfMonitor* perf_monitor, const ProcessMonitor* process_monitor) {
+    MetricStore& store = MetricStore::instance();
+    store.append(store.series("cpu.usage"), cpu_monitor.getCpuUsage());
+    store.append(store.series("cpu.user"), cpu_monitor.getUserUsage());
+    store.append(store.series("cpu.system"), cpu_monitor.getSystemUsage());
+    store.append(store.series("cpu.iowait"), cpu_monitor.getIOWait());
+    store.append(store.series("cpu.irq"), cpu_monitor.getHardIRQ());
+    store.append(store.series("cpu.softirq"), cpu_monitor.getSoftIRQ());
+    store.append(store.series("cpu.steal"), cpu_monitor.getSteal());
+    for (const auto& [cpu, usage] : cpu_monitor.getPerCpuUsage()) {
+        store.append(store.series("cpu." + std::to_string(cpu) + ".usage"), usage);
+    }
+    const LoadAverage& load = cpu_monitor.getLoadAverage();
+    store.append(store.series("cpu.load1", 8), load.load1);
+    store.append(store.series("cpu.load5", 8), load.load5);
+    store.append(store.series("cpu.load15", 8), load.load15);
+    store.append(store.series("cpu.runnable"), load.running);
+    if (cpu_monitor.hasSchedStat()) {
+        store.append(store.series("cpu.runq_wait_us"), cpu_monitor.getAvgRunQueueWaitUs());
+        store.append(store.series("cpu.runq_wait_max_us"), cpu_monitor.getMaxRunQueueWaitUs());
+    }
+    store.append(store.series("cpu.irq_rate"), cpu_monitor.getInterruptMonitor().getTotalRate());
+    const SoftirqMonitor& softirqs = cpu_monitor.getSoftirqMonitor();
+    store.append(store.series("cpu.net_rx_rate"), softirqs.getTypeRate(SOFTIRQ_NET_RX));
+    store.append(store.series("cpu.softnet_drop_rate"), softirqs.getDropRate());
+    if (cpu_monitor.isFrequencyEnabled()) {
+        store.append(store.series("cpu.mhz"), cpu_monitor.getFrequencyMonitor().getAverageMhz());
+    }
+
+    store.append(store.series("memory.usage"), memory_monitor.getMemoryUsage());
+    store.append(store.series("memory.available_mb"), memory_monitor.getAvailableMemory() / 1024.0);
+    store.append(store.series("memory.cached_mb"), memory_monitor.getCachedKb() / 1024.0);
+    store.append(store.series("memory.swap_used_mb"), memory_monitor.getSwapUsedKb() / 1024.0);
+    store.append(store.series("memory.dirty_mb"), memory_monitor.getDirtyKb() / 1024.0);
+    store.append(store.series("memory.writeback_mb"), memory_monitor.getWritebackKb() / 1024.0);
+
+    store.append(store.series("storage.iops"), storage_monitor.getTotalIOPS());
+    store.append(store.series("storage.mbps", 8), storage_monitor.getTotalThroughput());
+    for (const auto& [device, stats] : storage_monitor.getDiskStats()) {
+        std::string prefix = "storage." + device + ".";
+        store.append(store.series(prefix + "read_iops"), stats.read_iops);
+        store.append(store.series(prefix + "write_iops"), stats.write_iops);
+        store.append(store.series(prefix + "read_mbps", 8), stats.read_mbps);
+        store.append(store.series(prefix + "write_mbps", 8), stats.write_mbps);
+        store.append(store.series(prefix + "await_ms", 8), stats.avg_latency);
+        store.append(store.series(prefix + "queue_depth"), stats.queue_depth);
+    }
+
+    if (perf_monitor) {
+        store.append(store.series("perf.ipc", 8), perf_monitor->getIPC());
+        store.append(store.series("perf.cache_hit"), perf_monitor->getCacheHitRate());
+    }
+
+    if (process_monitor) {
+        const auto& processes = process_monitor->getProcessStats();
+        double threads = 0.0, max_cpu = 0.0, context_switches = 0.0;
+        for (const auto& [pid, stats] : processes) {
+            threads += stats.num_threads;
+            max_cpu = std::max(max_cpu, stats.cpu_usage_percent);
+            context_switches += stats.context_switch_rate;
+        }
+        store.append(store.series("process.count"), processes.size());
+        store.append(store.series("process.threads"), threads);
+        store.append(store.series("process.max_cpu"), max_cpu);
+        store.append(store.series("process.ctx_switch_rate"), context_switches);
+
+        std::set<pid_t> tracked;
+        for (pid_t pid : process_monitor->getTopCPUProcesses()) tracked.insert(pid);
+        for (pid_t pid : process_monitor->getTopMemoryProcesses()) tracked.insert(pid);
+        for (pid_t pid : process_monitor->getTopIOProcesses()) tracked.insert(pid);
+        for (pid_t pid : tracked) {
+            auto it = processes.find(pid);
+            if (it == processes.end()) continue;
+            const ProcessStats& stats = it->second;
+            std::string prefix = "process." + std::to_string(pid) + ".";
+            store.append(store.series(prefix + "cpu"), stats.cpu_usage_percent);
+            store.append(store.series(prefix + "rss_mb"), stats.memory_usage_mb);
+            store.append(store.series(prefix + "threads"), stats.num_threads);
+            store.append(store.series(prefix + "ctx_switch_rate"), stats.context_switch_rate);
+            store.append(store.series(prefix + "fault_rate"), stats.page_fault_rate);
+            if (stats.has_hw_counters) {
+                store.append(store.series(prefix + "ipc", 8), stats.ipc);
+                store.append(store.series(prefix + "llc_mpki", 8), stats.llc_mpki);
+            }
+        }
+    }
+}
+
+// What runTextMode shows; filled from the command line by main()
+struct TextModeOptions {
+    bool enable_perf = false;
+    bool enable_numa = false;
+    bool enable_process = false;
+    bool enable_membw = false;
+    bool enable_sched = false;
+    bool enable_psi = false;
+    bool enable_irq = false;
+    bool enable_freq = false;
+    bool enable_virt = false;
+    bool enable_topology = false;
+    bool enable_thp = false;
+    bool enable_frag = false;
+    bool enable_slab = false;
+    bool enable_workingset = false;
+    bool enable_history = false;
+    pid_t perf_pid = -1;
+    std::vector<std::string> perf_events;
+};
+
+void runTextMode(const TextModeOptions& options) {
     std::cout << "🚀 Advanced System Monitor - Text Mode" << std::endl;
     std::cout << "Press Ctrl+C to exit" << std::endl;
     std::cout << std::endl;
     
     // Initialize monitors
     CpuMonitor cpu_monitor;
+    cpu_monitor.setFrequencyEnabled(options.enable_freq);
     MemoryMonitor memory_monitor;
     StorageMonitor storage_monitor;
     
     std::unique_ptr<PerfMonitor> perf_monitor;
     std::unique_ptr<NumaMonitor> numa_monitor;
     std::unique_ptr<ProcessMonitor> process_monitor;
+    std::unique_ptr<SchedMonitor> sched_monitor;
+    std::unique_ptr<PressureMonitor> pressure_monitor;
+    std::unique_ptr<StealMonitor> steal_monitor;
+    std::unique_ptr<HugePageMonitor> hugepage_monitor;
+    std::unique_ptr<FragmentationMonitor> fragmentation_monitor;
+    std::unique_ptr<SlabMonitor> slab_monitor;
+    std::unique_ptr<WorkingsetMonitor> workingset_monitor;
     
-    if (enable_perf) {
+    if (options.enable_perf) {
         perf_monitor = std::make_unique<PerfMonitor>();
+        if (options.perf_pid > 0) {
+            perf_monitor->setTargetPid(options.perf_pid);
+        }
+        for (const auto& spec : options.perf_events) {
+            perf_monitor->addEvent(spec);
+        }
+        if (options.enable_membw) {
+            perf_monitor->addMemoryBandwidthEvents();
+        }
         if (!perf_monitor->initialize()) {
             std::cout << "⚠️  Warning: Hardware performance counters not available" << std::endl;
             perf_monitor.reset();
         }
     }
     
-    if (enable_numa) {
+    if (options.enable_numa) {
         numa_monitor = std::make_unique<NumaMonitor>();
     }
     
-    if (enable_process) {
+    if (options.enable_process) {
         process_monitor = std::make_unique<ProcessMonitor>();
+        if (perf_monitor) {
+            // Per-process IPC/MPKI for the heaviest CPU consumers
+            process_monitor->attachPerfCounters(perf_monitor.get(), 5);
+        }
+        if (numa_monitor) {
+            // Page placement vs thread placement for the heaviest memory users
+            numa_monitor->attachProcessMonitor(process_monitor.get());
+        }
+    }
+    
+    if (options.enable_sched) {
+        sched_monitor = std::make_unique<SchedMonitor>();
+        if (!sched_monitor->initialize()) {
+            std::cout << "⚠️  Warning: Scheduler tracepoints not available" << std::endl;
+            sched_monitor.reset();
+        }
+    }
+    
+    if (options.enable_psi) {
+        pressure_monitor = std::make_unique<PressureMonitor>();
+        if (!pressure_monitor->initialize()) {
+            pressure_monitor.reset();
+        }
+    }
+    
+    if (options.enable_virt) {
+        steal_monitor = std::make_unique<StealMonitor>();
+        steal_monitor->attachCpuMonitor(&cpu_monitor);
+        steal_monitor->attachPerfCounters(perf_monitor.get(), process_monitor.get());
+    }
+    
+    if (options.enable_thp && numa_monitor) {
+        hugepage_monitor = std::make_unique<HugePageMonitor>();
+        hugepage_monitor->attach(numa_monitor.get(), perf_monitor.get(), process_monitor.get(), 5);
+    }
+    
+    if (options.enable_frag) {
+        fragmentation_monitor = std::make_unique<FragmentationMonitor>();
+    }
+    
+    if (options.enable_slab) {
+        slab_monitor = std::make_unique<SlabMonitor>();
+    }
+    
+    if (options.enable_workingset && numa_monitor) {
+        workingset_monitor = std::make_unique<WorkingsetMonitor>();
+        workingset_monitor->attachNumaMonitor(numa_monitor.get());
     }
     
     // Main monitoring loop
@@ -82,6 +531,31 @@ void runTextMode(bool enable_perf, bool enable_numa, bool enable_process) {
         if (process_monitor) {
             process_monitor->update();
         }
+        if (hugepage_monitor) {
+            hugepage_monitor->update();
+        }
+        if (fragmentation_monitor) {
+            fragmentation_monitor->update();
+        }
+        if (slab_monitor) {
+            slab_monitor->update();
+        }
+        if (workingset_monitor) {
+            workingset_monitor->update();
+        }
+        if (sched_monitor) {
+            sched_monitor->update();
+        }
+        if (pressure_monitor) {
+            pressure_monitor->update();
+        }
+        if (steal_monitor) {
+            steal_monitor->update();
+        }
+        
+        if (options.enable_history) {
+            recordMetrics(cpu_monitor, memory_monitor, storage_monitor, perf_monitor.get(), process_monitor.get());
+        }
         
         // Clear screen
         std::cout << "\033[2J\033[1;1H";
@@ -96,9 +570,28 @@ void runTextMode(bool enable_perf, bool enable_numa, bool enable_process) {
         std::cout << "📊 BASIC SYSTEM MONITORING (Phases 1-2)" << std::endl;
         std::cout << "─────────────────────────────────────────────────────────────────────" << std::endl;
         cpu_monitor.printStats();
+        cpu_monitor.printSchedStats();
         memory_monitor.printStats();
         storage_monitor.printStats();
         
+        // Interrupt rates and device IRQ placement
+        if (options.enable_irq) {
+            std::cout << std::endl;
+            cpu_monitor.printInterruptStats();
+            cpu_monitor.getInterruptMonitor().printIrqAffinity(15);
+            cpu_monitor.printSoftirqStats();
+        }
+        
+        // Per-socket/node/LLC rollups
+        if (options.enable_topology) {
+            printTopologyRollup(cpu_monitor, perf_monitor.get());
+        }
+        
+        // Clock speed, idle states and throttling
+        if (options.enable_freq) {
+            cpu_monitor.printFrequencyStats();
+        }
+        
         // Phase 3: Hardware performance counters
         if (perf_monitor) {
             std::cout << "\n⚡ HARDWARE PERFORMANCE COUNTERS (Phase 3)" << std::endl;
@@ -113,9 +606,32 @@ void runTextMode(bool enable_perf, bool enable_numa, bool enable_process) {
             std::cout << "─────────────────────────────────────────────────────────────────────" << std::endl;
             numa_monitor->printStats();
             numa_monitor->printNumaTopology();
+            numa_monitor->printNumaLocality();
+            numa_monitor->printProcessPlacement();
+            numa_monitor->printVmstatActivity(10);
             numa_monitor->printMemoryPressureAnalysis();
         }
         
+        if (hugepage_monitor) {
+            hugepage_monitor->printStats();
+        }
+        
+        if (fragmentation_monitor) {
+            fragmentation_monitor->printStats();
+        }
+        
+        if (slab_monitor) {
+            slab_monitor->printStats(10);
+        }
+        
+        if (workingset_monitor) {
+            workingset_monitor->printStats(8);
+        }
+        
+        if (options.enable_history) {
+            printMetricHistory();
+        }
+        
         // Phase 5: Process-level analysis
         if (process_monitor) {
             std::cout << "\n🔍 PROCESS-LEVEL ANALYSIS (Phase 5)" << std::endl;
@@ -125,6 +641,23 @@ void runTextMode(bool enable_perf, bool enable_numa, bool enable_process) {
             process_monitor->printTopProcesses(10);
         }
         
+        // Scheduler latency and off-CPU analysis
+        if (sched_monitor) {
+            sched_monitor->printStats();
+            sched_monitor->printLatencyAnalysis(10);
+        }
+        
+        // Pressure stall information
+        if (pressure_monitor) {
+            pressure_monitor->printStats();
+            pressure_monitor->printStallEvents(5);
+        }
+        
+        // Steal time on virtualized hosts
+        if (steal_monitor) {
+            steal_monitor->printStats();
+        }
+        
         // Advanced correlation analysis
         std::cout << "\n🎯 ADVANCED CORRELATION ANALYSIS" << std::endl;
         std::cout << "─────────────────────────────────────────────────────────────────────" << std::endl;
@@ -140,6 +673,51 @@ void runTextMode(bool enable_perf, bool enable_numa, bool enable_process) {
                       << cpu_monitor.getIOWait() << "%) - Storage bottleneck" << std::endl;
         }
         
+        // Interrupt analysis (rates over the last interval)
+        const auto& interrupts = cpu_monitor.getInterruptMonitor();
+        if (!options.enable_irq && (interrupts.getStormCount() > 0 || interrupts.getUnbalancedCount() > 0)) {
+            cpu_monitor.printInterruptStats();
+        }
+        if (interrupts.getStormCount() > 0) {
+            std::cout << "🔴 CRITICAL: " << interrupts.getStormCount() << " interrupt storms ("
+                      << std::fixed << std::setprecision(0) << interrupts.getTotalRate()
+                      << " interrupts/sec) - CPU time lost to IRQ handling" << std::endl;
+        }
+        
+        if (interrupts.getCrossNumaCount() > 0) {
+            std::cout << "🟡 WARNING: " << interrupts.getCrossNumaCount()
+                      << " device IRQs serviced on a remote NUMA node - Extra completion latency" << std::endl;
+        }
+        
+        if (steal_monitor && steal_monitor->isNoisyNeighborActive()) {
+            std::cout << "🔴 CRITICAL: Sustained " << std::fixed << std::setprecision(1) << steal_monitor->getStealPercent()
+                      << "% steal - Noisy neighbor on the hypervisor" << std::endl;
+        } else if (cpu_monitor.getSteal() > 10) {
+            std::cout << "🟡 WARNING: CPU steal " << std::fixed << std::setprecision(1) << cpu_monitor.getSteal()
+                      << "% - vCPUs waiting for physical CPUs" << std::endl;
+        }
+        
+        const auto& frequency = cpu_monitor.getFrequencyMonitor();
+        if (frequency.getThrottleEvents() > 0) {
+            std::cout << "🔴 CRITICAL: " << frequency.getThrottleEvents()
+                      << " thermal/power throttle events - Cores clocked down by the platform" << std::endl;
+        }
+        if (frequency.hasPowersaveGovernor() || frequency.getLowClockCount() > 0) {
+            std::cout << "🟡 WARNING: Average clock " << std::fixed << std::setprecision(0) << frequency.getAverageMhz()
+                      << " MHz - " << (frequency.hasPowersaveGovernor() ? "powersave governor" : "busy cores running slow")
+                      << ", IPC and CPU% understate the slowdown" << std::endl;
+        }
+        
+        const auto& softirqs = cpu_monitor.getSoftirqMonitor();
+        if (softirqs.getDropRate() > 0.0) {
+            std::cout << "🔴 CRITICAL: " << std::fixed << std::setprecision(0) << softirqs.getDropRate()
+                      << " backlog drops/sec - Packets lost before reaching the stack" << std::endl;
+        }
+        if (softirqs.isNetRxConcentrated()) {
+            std::cout << "🟡 WARNING: NET_RX concentrated on cpu" << softirqs.getHotCpu(SOFTIRQ_NET_RX)
+                      << " - Receive processing not spread (check RSS/RPS)" << std::endl;
+        }
+        
         // Memory pressure analysis
         if (memory_monitor.getMemoryUsage() > 95) {
             std::cout << "🔴 CRITICAL: Memory exhaustion (" << std::fixed << std::setprecision(1) 
@@ -170,6 +748,46 @@ void runTextMode(bool enable_perf, bool enable_numa, bool enable_process) {
             if (numa_monitor->isSwapping()) {
                 std::cout << "🔴 CRITICAL: Swapping detected - Severe performance impact" << std::endl;
             }
+            if (numa_monitor->isRemoteAccessHigh()) {
+                std::cout << "🟡 WARNING: " << std::fixed << std::setprecision(1) << numa_monitor->getRemoteAccessRatio()
+                          << "% remote NUMA allocations, " << std::setprecision(0) << numa_monitor->getPagesMigratedRate()
+                          << " pages migrated/s - Cross-socket memory traffic" << std::endl;
+            }
+        }
+        
+        // THP analysis
+        if (hugepage_monitor) {
+            if (hugepage_monitor->isCompactionCostly()) {
+                std::cout << "🔴 CRITICAL: Direct compaction stalls - THP allocation is adding latency" << std::endl;
+            }
+            if (hugepage_monitor->isFallingBack()) {
+                std::cout << "🟡 WARNING: " << std::fixed << std::setprecision(1) << hugepage_monitor->getFallbackPercent()
+                          << "% of THP faults falling back to 4 KB pages - Memory fragmented" << std::endl;
+            }
+        }
+        
+        // Fragmentation analysis
+        if (fragmentation_monitor && fragmentation_monitor->isHighOrderCollapsed()) {
+            std::cout << "🔴 CRITICAL: Order-" << fragmentation_monitor->getHighOrder()
+                      << "+ free memory collapsed - NIC and hugepage allocations will fail" << std::endl;
+        }
+        
+        // Slab analysis
+        if (slab_monitor) {
+            for (const SlabCache* cache : slab_monitor->getLeakSuspects()) {
+                std::cout << "🟡 WARNING: Slab cache " << cache->name << " growing steadily ("
+                          << std::fixed << std::setprecision(1) << cache->slope_bytes_per_min * 60.0 / (1024.0 * 1024.0)
+                          << " MB/h) - Possible kernel memory leak" << std::endl;
+            }
+        }
+        
+        // Page cache analysis
+        if (workingset_monitor && workingset_monitor->isThrashing()) {
+            std::cout << "🔴 CRITICAL: Page cache thrashing - " << std::fixed << std::setprecision(0)
+                      << workingset_monitor->getFileActivateRate() << " hot pages/s evicted and re-read from storage" << std::endl;
+        } else if (workingset_monitor && workingset_monitor->isCycling()) {
+            std::cout << "🟡 WARNING: " << std::fixed << std::setprecision(0) << workingset_monitor->getRefaultPercent()
+                      << "% of evicted file pages read back - Page cache smaller than the reuse set" << std::endl;
         }
         
         // Process analysis
@@ -191,11 +809,33 @@ void runTextMode(bool enable_perf, bool enable_numa, bool enable_process) {
             }
         }
         
+        // Scheduler analysis
+        if (sched_monitor && sched_monitor->getRunQueueP99Us() > 1000.0) {
+            std::cout << "🔴 CRITICAL: Run-queue p99 " << std::fixed << std::setprecision(0)
+                      << sched_monitor->getRunQueueP99Us() << " us - Threads waiting for CPU" << std::endl;
+        }
+        if (cpu_monitor.isRunQueueOverloaded()) {
+            std::cout << "🔴 CRITICAL: Run-queue wait " << std::fixed << std::setprecision(0)
+                      << cpu_monitor.getAvgRunQueueWaitUs() << " us per timeslice at " << std::setprecision(1)
+                      << cpu_monitor.getCpuUsage() << "% CPU - Overloaded despite idle time" << std::endl;
+        }
+        
+        // Pressure analysis
+        if (pressure_monitor) {
+            for (PressureResource resource : {PSI_CPU, PSI_MEMORY, PSI_IO, PSI_IRQ}) {
+                if (pressure_monitor->isStalled(resource)) {
+                    std::cout << "🔴 CRITICAL: " << PressureMonitor::resourceName(resource)
+                              << " stall threshold crossed - Tasks blocked on " << PressureMonitor::resourceName(resource)
+                              << std::endl;
+                }
+            }
+        }
+        
         std::cout << std::endl;
         std::cout << "🎯 SYSTEM STATUS: ";
         
         bool has_critical_issues = false;
-        if (cpu_monitor.getCpuUsage() > 90 || cpu_monitor.getIOWait() > 20 ||
+        if (cpu_monitor.getCpuUsage() > 90 || cpu_monitor.getIOWait() > 20 || cpu_monitor.isRunQueueOverloaded() ||
             memory_monitor.getMemoryUsage() > 95 || storage_monitor.getBottleneckCount() > 0) {
             has_critical_issues = true;
         }
@@ -221,19 +861,60 @@ int main(int argc, char* argv[]) {
     signal(SIGTERM, signalHandler);
     
     // Parse command line arguments
-    bool enable_perf = false;
-    bool enable_numa = false;
-    bool enable_process = false;
+    TextModeOptions options;
+    bool plan_irq_affinity = false;
+    bool apply_irq_affinity = false;
     
     for (int i = 1; i < argc; i++) {
         std::string arg = argv[i];
         
         if (arg == "--perf" || arg == "-p") {
-            enable_perf = true;
+            options.enable_perf = true;
         } else if (arg == "--numa" || arg == "-n") {
-            enable_numa = true;
+            options.enable_numa = true;
         } else if (arg == "--process" || arg == "-r") {
-            enable_process = true;
+            options.enable_process = true;
+        } else if (arg == "--sched" || arg == "-s") {
+            options.enable_sched = true;
+        } else if (arg == "--irq") {
+            options.enable_irq = true;
+        } else if (arg == "--freq") {
+            options.enable_freq = true;
+        } else if (arg == "--virt") {
+            options.enable_virt = true;
+        } else if (arg == "--topology") {
+            options.enable_topology = true;
+        } else if (arg == "--thp") {
+            options.enable_thp = true;
+            options.enable_numa = true;
+        } else if (arg == "--frag") {
+            options.enable_frag = true;
+        } else if (arg == "--slab") {
+            options.enable_slab = true;
+        } else if (arg == "--workingset") {
+            options.enable_workingset = true;
+            options.enable_numa = true;
+        } else if (arg == "--history") {
+            options.enable_history = true;
+        } else if (arg == "--psi") {
+            options.enable_psi = true;
+        } else if (arg == "--plan-irq-affinity") {
+            plan_irq_affinity = true;
+        } else if (arg == "--apply-irq-affinity") {
+            apply_irq_affinity = true;
+        } else if (arg == "--event" && i + 1 < argc) {
+            options.perf_events.push_back(argv[++i]);
+            options.enable_perf = true;
+        } else if (arg == "--membw") {
+            options.enable_membw = true;
+            options.enable_perf = true;
+        } else if (arg == "--perf-pid" && i + 1 < argc) {
+            options.perf_pid = std::atoi(argv[++i]);
+            options.enable_perf = true;
+        } else if (arg == "--list-events") {
+            PerfMonitor catalog_monitor;
+            catalog_monitor.printEventCatalog();
+            return 0;
         } else if (arg == "--help" || arg == "-h") {
             printUsage();
             return 0;
@@ -244,15 +925,21 @@ int main(int argc, char* argv[]) {
         }
     }
     
+    if (plan_irq_affinity || apply_irq_affinity) {
+        return runIrqAffinityMode(apply_irq_affinity);
+    }
+    
     // Show configuration
     std::cout << "Configuration:" << std::endl;
-    std::cout << "  Performance Counters: " << (enable_perf ? "Enabled (Phase 3)" : "Disabled") << std::endl;
-    std::cout << "  NUMA Analysis: " << (enable_numa ? "Enabled (Phase 4)" : "Disabled") << std::endl;
-    std::cout << "  Process Monitoring: " << (enable_process ? "Enabled (Phase 5)" : "Disabled") << std::endl;
+    std::cout << "  Performance Counters: " << (options.enable_perf ? "Enabled (Phase 3)" : "Disabled") << std::endl;
+    std::cout << "  NUMA Analysis: " << (options.enable_numa ? "Enabled (Phase 4)" : "Disabled") << std::endl;
+    std::cout << "  Process Monitoring: " << (options.enable_process ? "Enabled (Phase 5)" : "Disabled") << std::endl;
+    std::cout << "  Scheduler Tracing: " << (options.enable_sched ? "Enabled" : "Disabled") << std::endl;
+    std::cout << "  Pressure Stall Info: " << (options.enable_psi ? "Enabled" : "Disabled") << std::endl;
     std::cout << std::endl;
     
     try {
-        runTextMode(enable_perf, enable_numa, enable_process);
+        runTextMode(options);
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
         return 1;
@@ -1,15 +1,20 @@
 #include "CpuMonitor.h"
 #include "MemoryMonitor.h"
 #include "StorageMonitor.h"
+#include "PageCacheInspector.h"
 #include <iostream>
 #include <chrono>
 #include <thread>
 #include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdlib>
 
 // Function declarations
 void printProgressBar(double current, double max, int width = 30);
 void printSystemDashboard(CpuMonitor& cpu, MemoryMonitor& mem, StorageMonitor& storage);
 void clearScreen();
+int runFincoreMode(int argc, char* argv[]);
 
 void printProgressBar(double current, double max, int width) {
     int filled = (int)((current / max) * width);
@@ -71,6 +76,15 @@ void printSystemDashboard(CpuMonitor& cpu, MemoryMonitor& mem, StorageMonitor& s
     if (cpu.getIOWait() > 10) std::cout << " ⚠️  High IOWait";
     if (cpu.getHardIRQ() > 5) std::cout << " ⚠️  High HardIRQ";
     if (cpu.getSoftIRQ() > 5) std::cout << " ⚠️  High SoftIRQ";
+    
+    // A "slow" box at moderate CPU% is often just clocked down (--freq)
+    const auto& freq = cpu.getFrequencyMonitor();
+    if (cpu.isFrequencyEnabled()) {
+        if (freq.getThrottleEvents() > 0) std::cout << " ⚠️  Throttling";
+        else if (freq.hasPowersaveGovernor() || freq.getLowClockCount() > 0) {
+            std::cout << " ⚠️  Low clock (" << std::setprecision(0) << freq.getAverageMhz() << " MHz)";
+        }
+    }
     std::cout << std::endl;
     
     // Memory - Enhanced with detailed breakdown
@@ -119,6 +133,14 @@ void printSystemDashboard(CpuMonitor& cpu, MemoryMonitor& mem, StorageMonitor& s
         has_issues = true;
     }
     
+    // Busy% alone hides queuing: tasks can wait milliseconds at 60% CPU
+    if (cpu.hasSchedStat() && cpu.isRunQueueOverloaded()) {
+        std::cout << "🔴 CRITICAL: Run-queue wait " << std::fixed << std::setprecision(1)
+                  << cpu.getAvgRunQueueWaitUs() / 1000.0 << " ms per timeslice ("
+                  << cpu.getLoadAverage().running << " runnable tasks) - CPU overloaded" << std::endl;
+        has_issues = true;
+    }
+    
     if (cpu.getIOWait() > 20) {
         std::cout << "🔴 CRITICAL: High IOWait (" << std::fixed << std::setprecision(1) << cpu.getIOWait() << "%) - Storage bottleneck" << std::endl;
         has_issues = true;
@@ -207,7 +229,43 @@ void printSystemDashboard(CpuMonitor& cpu, MemoryMonitor& mem, StorageMonitor& s
     }
 }
 
-int main() {
+int runFincoreMode(int argc, char* argv[]) {
+    // sysprobe fincore [--threads N] [--top N] <paths...>
+    int threads = 0;
+    int top = 20;
+    std::vector<std::string> paths;
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            threads = std::atoi(argv[++i]);
+        } else if (arg == "--top" && i + 1 < argc) {
+            top = std::atoi(argv[++i]);
+        } else {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.empty()) {
+        std::cout << "Usage: ./sysprobe fincore [--threads N] [--top N] <files or directories...>" << std::endl;
+        return 1;
+    }
+
+    MemoryMonitor memory_monitor;
+    memory_monitor.update();
+
+    PageCacheInspector inspector(threads);
+    if (!inspector.scan(paths)) {
+        std::cout << "No regular files found" << std::endl;
+        return 1;
+    }
+    inspector.printReport(memory_monitor.getCachedKb(), top);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "fincore") {
+        return runFincoreMode(argc, argv);
+    }
+    
     std::cout << "Tiny Monitor - Quick Issue Detection" << std::endl;
     std::cout << "Press Ctrl+C to exit" << std::endl;
     std::cout << std::endl;
@@ -216,6 +274,9 @@ int main() {
     MemoryMonitor memory_monitor;
     StorageMonitor storage_monitor;
     
+    // Clock/throttle checks walk cpufreq and cpuidle for every CPU; opt in
+    cpu_monitor.setFrequencyEnabled(argc > 1 && std::string(argv[1]) == "--freq");
+    
     // Main monitoring loop
     while (true) {
         // Update all statistics
@@ -0,0 +1,64 @@
+#include "MemoryBenchmark.h"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <algorithm>
+
+void printUsage() {
+    std::cout << "NUMA Memory Benchmark - node-to-node latency and bandwidth" << std::endl;
+    std::cout << "Usage: ./sysprobe-membench [options]" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "  --latency-mb <n>   Pointer-chase buffer size (default 256)" << std::endl;
+    std::cout << "  --bandwidth-mb <n> Size of each STREAM array (default 256)" << std::endl;
+    std::cout << "  --threads <n>      Bandwidth threads per CPU node (default: every CPU of the node)" << std::endl;
+    std::cout << "  --reps <n>         STREAM repetitions, best is reported (default 3)" << std::endl;
+    std::cout << "  --latency-only     Skip the bandwidth kernels" << std::endl;
+    std::cout << "  --bandwidth-only   Skip the latency chase" << std::endl;
+    std::cout << "  --help, -h         Show this help message" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Run on an otherwise idle machine; other load skews both matrices." << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    MembenchConfig config{256, 256, 0, 3, true, true};
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if (arg == "--latency-mb" && i + 1 < argc) {
+            config.latency_mb = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--bandwidth-mb" && i + 1 < argc) {
+            config.bandwidth_mb = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            config.threads = std::atoi(argv[++i]);
+        } else if (arg == "--reps" && i + 1 < argc) {
+            config.repetitions = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--latency-only") {
+            config.run_bandwidth = false;
+        } else if (arg == "--bandwidth-only") {
+            config.run_latency = false;
+        } else if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        } else {
+            std::cout << "Unknown option: " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (config.latency_mb == 0 || config.bandwidth_mb == 0 || (!config.run_latency && !config.run_bandwidth)) {
+        std::cout << "Nothing to measure" << std::endl;
+        printUsage();
+        return 1;
+    }
+
+    MemoryBenchmark benchmark(config);
+    if (!benchmark.run()) {
+        std::cerr << "No NUMA nodes could be measured" << std::endl;
+        return 1;
+    }
+    benchmark.printMatrix();
+    benchmark.printAssessment();
+    return 0;
+}